@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <cstring>
+#include "../../include/fastio.h"
 using namespace std;
 
 // 排序函数声明
@@ -22,7 +24,46 @@ double measureSort(Func sortFunc, vector<int> arr) {
     return diff.count();
 }
 
-int main() {
+// 非交互模式：文件里是若干组 n a_1 ... a_n（n 为 0 或文件结束时停止），
+// 对每组数据计时排序，每组输出一行五个耗时（毫秒，顺序同上）
+static int runFile(const char* path) {
+    FioReader in;
+    if (fio_open(&in, path) != 0) { perror(path); return 1; }
+    FioWriter out;
+    if (fio_writer_init(&out, stdout, 0) != 0) {
+        perror("malloc");
+        fio_close(&in);
+        return 1;
+    }
+    int n;
+    while (fio_read_int(&in, &n) == 1 && n > 0) {
+        vector<int> arr(n);
+        for (int i = 0; i < n; ++i) {
+            if (fio_read_int(&in, &arr[i]) != 1) {
+                fprintf(stderr, "%s: 第 %d 个数读取失败\n", path, i + 1);
+                fio_writer_close(&out);
+                fio_close(&in);
+                return 1;
+            }
+        }
+        double t[5] = {measureSort(bubbleSort, arr), measureSort(selectionSort, arr),
+                       measureSort(insertionSort, arr), measureSort(quickSort, arr),
+                       measureSort(mergeSort, arr)};
+        for (int j = 0; j < 5; ++j) {
+            if (j) fio_put_char(&out, ' ');
+            fio_put_f64(&out, t[j], 3);
+        }
+        fio_put_char(&out, '\n');
+    }
+    fio_close(&in);
+    return fio_writer_close(&out) != 0;
+}
+
+// 用法: sorting            交互输入 n，排序随机排列
+//       sorting -f FILE    从文件读数据（FILE 为 - 时读 stdin）
+int main(int argc, char** argv) {
+    if (argc == 3 && strcmp(argv[1], "-f") == 0) return runFile(argv[2]);
+
     random_device rd;
     mt19937 gen(rd());
 
@@ -0,0 +1,57 @@
+/*
+ * 堆分配计数，C++17，给测速程序统计“一段代码做了多少次 new、分配了多少字节”
+ *
+ * 替换全局 operator new/delete（含数组与对齐版本），分配转到 malloc / aligned_alloc，
+ * 释放转到 free；每次 new 把 alloc_count::allocs +1、alloc_count::bytes 加上请求的字节数。
+ * 计数一直开着，统计一段代码时取前后差值。
+ *
+ * 替换的全局运算符不能是 inline，所以本头文件只能被一个翻译单元包含（放在测速程序的主文件里）。
+ *
+ * 用法：
+ *     #include "../../include/alloc_count.hpp"
+ *     std::size_t a0 = alloc_count::allocs;
+ *     work();
+ *     std::printf("%zu allocs\n", alloc_count::allocs - a0);
+ */
+#ifndef ALLOC_COUNT_HPP
+#define ALLOC_COUNT_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/* 计数用的 operator new/delete 直接转到 malloc/free，GCC 会把内联后的配对误报为不匹配 */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace alloc_count {
+
+inline std::size_t allocs = 0, bytes = 0;
+
+inline void *counted(std::size_t n, std::size_t align) {
+    ++allocs;
+    bytes += n;
+    if (n == 0) n = 1;
+    void *p = align > alignof(std::max_align_t) ? std::aligned_alloc(align, (n + align - 1) / align * align)
+                                                : std::malloc(n);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+}  // namespace alloc_count
+
+void *operator new(std::size_t n) { return alloc_count::counted(n, 0); }
+void *operator new[](std::size_t n) { return alloc_count::counted(n, 0); }
+void *operator new(std::size_t n, std::align_val_t a) { return alloc_count::counted(n, static_cast<std::size_t>(a)); }
+void *operator new[](std::size_t n, std::align_val_t a) { return alloc_count::counted(n, static_cast<std::size_t>(a)); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif /* ALLOC_COUNT_HPP */
@@ -0,0 +1,133 @@
+/*
+ * 测速程序共用的计时与硬件计数器，header-only，C（C99 起）与 C++ 通用
+ *
+ * - now_sec / now_ms：单调时钟（POSIX 的 CLOCK_MONOTONIC），没有时退回 timespec_get / clock
+ * - HwCounters：Linux 下用 perf_event_open 读取所选的硬件事件（只计用户态）。没有权限
+ *   （perf_event_paranoid）、事件不支持或非 Linux 时对应的 fd 为 -1，hw_stop 读出 -1，
+ *   调用方据此只报时间
+ *
+ * 用法：
+ *     static const HwEvent ev[] = {HW_L1D_MISS, HW_LLC_MISS};
+ *     HwCounters hw;
+ *     hw_open(&hw, ev, 2);
+ *     hw_start(&hw); double t = now_sec();
+ *     work();
+ *     t = now_sec() - t; hw_stop(&hw);
+ *     for (int i = 0; i < hw.n; ++i) if (hw.val[i] >= 0) printf("%s %lld\n", hw_name(hw.ev[i]), hw.val[i]);
+ *     hw_close(&hw);
+ */
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*==================== 计时 ====================*/
+static inline double now_sec(void) {
+    struct timespec ts;
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#elif defined(TIME_UTC)
+    timespec_get(&ts, TIME_UTC);
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline double now_ms(void) { return now_sec() * 1e3; }
+
+/*==================== 硬件计数器 ====================*/
+typedef enum { HW_CYCLES, HW_INSTR, HW_L1D_MISS, HW_LLC_MISS } HwEvent;
+
+#define HW_MAX_EVENTS 4
+
+typedef struct {
+    int n;
+    HwEvent ev[HW_MAX_EVENTS];
+    int fd[HW_MAX_EVENTS];
+    long long val[HW_MAX_EVENTS];
+} HwCounters;
+
+static inline const char *hw_name(HwEvent e) {
+    switch (e) {
+    case HW_CYCLES: return "cycles";
+    case HW_INSTR: return "instr";
+    case HW_L1D_MISS: return "L1D-miss";
+    case HW_LLC_MISS: return "LLC-miss";
+    default: return "?";
+    }
+}
+
+/* 打开 ev[0..n) 这些事件（n 超过 HW_MAX_EVENTS 时截断），初始为停止状态 */
+static inline void hw_open(HwCounters *h, const HwEvent *ev, int n) {
+    h->n = n < HW_MAX_EVENTS ? n : HW_MAX_EVENTS;
+    for (int i = 0; i < h->n; ++i) {
+        h->ev[i] = ev[i];
+        h->fd[i] = -1;
+        h->val[i] = -1;
+#ifdef __linux__
+        struct perf_event_attr pe;
+        memset(&pe, 0, sizeof(pe));
+        pe.size = sizeof(pe);
+        switch (ev[i]) {
+        case HW_CYCLES: pe.type = PERF_TYPE_HARDWARE; pe.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case HW_INSTR: pe.type = PERF_TYPE_HARDWARE; pe.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case HW_L1D_MISS:
+            pe.type = PERF_TYPE_HW_CACHE;
+            pe.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case HW_LLC_MISS: pe.type = PERF_TYPE_HARDWARE; pe.config = PERF_COUNT_HW_CACHE_MISSES; break;
+        default: continue;
+        }
+        pe.disabled = 1;
+        pe.exclude_kernel = 1;
+        pe.exclude_hv = 1;
+        h->fd[i] = (int)syscall(SYS_perf_event_open, &pe, 0, -1, -1, 0);
+#endif
+    }
+}
+
+static inline void hw_start(HwCounters *h) {
+#ifdef __linux__
+    for (int i = 0; i < h->n; ++i)
+        if (h->fd[i] >= 0) {
+            ioctl(h->fd[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(h->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#else
+    (void)h;
+#endif
+}
+
+/* 停止计数并读出到 val[]，打不开或读失败的事件为 -1 */
+static inline void hw_stop(HwCounters *h) {
+    for (int i = 0; i < h->n; ++i) {
+        h->val[i] = -1;
+#ifdef __linux__
+        if (h->fd[i] >= 0) {
+            ioctl(h->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(h->fd[i], &h->val[i], sizeof(long long)) != sizeof(long long)) h->val[i] = -1;
+        }
+#endif
+    }
+}
+
+static inline void hw_close(HwCounters *h) {
+    for (int i = 0; i < h->n; ++i) {
+#ifdef __linux__
+        if (h->fd[i] >= 0) close(h->fd[i]);
+#endif
+        h->fd[i] = -1;
+    }
+}
+
+#endif /* BENCH_UTIL_H */
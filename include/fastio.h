@@ -0,0 +1,360 @@
+/*
+ * 快速输入输出，header-only，C（C99 起）与 C++ 通用
+ *
+ * - FioReader：读整数/浮点数。普通文件在 POSIX 下直接 mmap 整个文件；stdin、管道、
+ *   Windows 下用 1MB 缓冲 fread，缓冲区末尾不足一个记号时把剩余部分挪到开头再读，
+ *   保证每个记号完整地落在缓冲区内（单个记号最长 FIO_TOKEN_MAX 字节）
+ * - FioWriter：输出先写进缓冲区（默认 1MB），满了或 fio_flush 时整块 fwrite
+ * - 数字转换：C++17 下整数用 std::from_chars / std::to_chars，标准库支持浮点 charconv 时
+ *   （libstdc++ 11+，MSVC 19.24+）浮点也用；C 下整数手写转换，浮点退回 strtod / snprintf
+ *
+ * 读函数的返回值：1 读到一个数，0 已到输入末尾，-1 记号不是合法的数（该记号被跳过）。
+ * 空白包括空格、制表符、换行、回车；除此之外的字符都算记号的一部分。
+ *
+ * 用法：
+ *     FioReader in; FioWriter out;
+ *     if (fio_open(&in, path) != 0) { perror(path); return 1; }   // path 为 NULL 或 "-" 时读 stdin
+ *     fio_writer_init(&out, stdout, 0);
+ *     long long x;
+ *     while (fio_read_i64(&in, &x) == 1) { fio_put_i64(&out, x); fio_put_char(&out, '\n'); }
+ *     fio_writer_close(&out);
+ *     fio_close(&in);
+ */
+#ifndef FASTIO_H
+#define FASTIO_H
+
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FIO_HAVE_MMAP 1
+#endif
+
+#if defined(__cplusplus) && __cplusplus >= 201703L
+#include <charconv>
+#define FIO_HAVE_CHARCONV 1
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define FIO_HAVE_CHARCONV_FP 1
+#endif
+#endif
+
+#ifndef FIO_BUF_SIZE
+#define FIO_BUF_SIZE (1u << 20)
+#endif
+#define FIO_TOKEN_MAX 128
+
+typedef struct FioReader {
+    const char *p, *end;  // 当前位置与有效数据末尾
+    char *buf;            // 缓冲模式的缓冲区（mmap 模式为 NULL）
+    FILE *fp;
+    int own_fp;           // fp 是否由 fio_open 打开
+    int eof;              // 底层数据已全部进入 [p, end)
+    void *map;            // mmap 模式的映射
+    size_t map_len;
+} FioReader;
+
+typedef struct FioWriter {
+    FILE *fp;
+    char *buf;
+    size_t len, cap;
+    int err;              // fwrite 出过错
+} FioWriter;
+
+/* ---------------- 读 ---------------- */
+
+/* 以缓冲模式读一个已打开的 FILE*（不会关闭它） */
+static inline int fio_open_file(FioReader *r, FILE *fp) {
+    memset(r, 0, sizeof *r);
+    r->fp = fp;
+    r->buf = (char *)malloc(FIO_BUF_SIZE + 1);
+    if (!r->buf) return -1;
+    r->p = r->end = r->buf;
+    return 0;
+}
+
+/* 打开文件；普通文件尽量 mmap，失败时退回缓冲模式。返回 0 成功，-1 失败（errno 有效） */
+static inline int fio_open(FioReader *r, const char *path) {
+    if (!path || strcmp(path, "-") == 0) return fio_open_file(r, stdin);
+#ifdef FIO_HAVE_MMAP
+    {
+        int fd = open(path, O_RDONLY);
+        struct stat st;
+        if (fd < 0) return -1;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void *m = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                close(fd);
+#ifdef MADV_SEQUENTIAL
+                madvise(m, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+                memset(r, 0, sizeof *r);
+                r->map = m;
+                r->map_len = (size_t)st.st_size;
+                r->p = (const char *)m;
+                r->end = r->p + r->map_len;
+                r->eof = 1;
+                return 0;
+            }
+        }
+        close(fd);
+    }
+#endif
+    {
+        FILE *fp = fopen(path, "rb");
+        if (!fp) return -1;
+        if (fio_open_file(r, fp) != 0) {
+            fclose(fp);
+            return -1;
+        }
+        r->own_fp = 1;
+        return 0;
+    }
+}
+
+static inline void fio_close(FioReader *r) {
+#ifdef FIO_HAVE_MMAP
+    if (r->map) munmap(r->map, r->map_len);
+#endif
+    if (r->own_fp) fclose(r->fp);
+    free(r->buf);
+    memset(r, 0, sizeof *r);
+}
+
+/* 缓冲模式：把 [p, end) 挪到开头，尽量读满。末尾放 '\0' 方便 strtod */
+static inline void fio__refill(FioReader *r) {
+    size_t rest = (size_t)(r->end - r->p), got;
+    if (r->eof || !r->buf) return;
+    memmove(r->buf, r->p, rest);
+    r->p = r->buf;
+    r->end = r->buf + rest;
+    while (!r->eof && (size_t)(r->end - r->buf) < FIO_BUF_SIZE) {
+        got = fread(r->buf + (r->end - r->buf), 1, FIO_BUF_SIZE - (size_t)(r->end - r->buf), r->fp);
+        if (got == 0) r->eof = 1;
+        r->end += got;
+    }
+    r->buf[r->end - r->buf] = '\0';
+}
+
+static inline int fio__is_space(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f'; }
+
+/* 跳过空白，定位到下一个记号开头并保证整个记号在缓冲区内；没有记号时返回 0 */
+static inline int fio__token(FioReader *r) {
+    for (;;) {
+        while (r->p < r->end && fio__is_space(*r->p)) ++r->p;
+        if (r->p < r->end) break;
+        if (r->eof) return 0;
+        fio__refill(r);
+    }
+    if (!r->eof && r->end - r->p < FIO_TOKEN_MAX) fio__refill(r);
+    return 1;
+}
+
+/* 记号末尾（下一个空白或数据末尾） */
+static inline const char *fio__token_end(const FioReader *r) {
+    const char *q = r->p;
+    while (q < r->end && !fio__is_space(*q)) ++q;
+    return q;
+}
+
+/* 返回值见文件头；溢出也算 -1 */
+static inline int fio_read_i64(FioReader *r, long long *out) {
+    const char *q, *e;
+    if (!fio__token(r)) return 0;
+    q = r->p;
+    if (*q == '+' && ++q < r->end && *q == '-') q = r->end;  // from_chars 不接受前导 '+'，"+-" 判为非法
+#ifdef FIO_HAVE_CHARCONV
+    {
+        std::from_chars_result res = std::from_chars(q, r->end, *out);
+        e = res.ptr;
+        if (res.ec != std::errc() || (e < r->end && !fio__is_space(*e))) {
+            r->p = fio__token_end(r);
+            return -1;
+        }
+    }
+#else
+    {
+        int neg = 0;
+        unsigned long long v = 0, lim;
+        if (q < r->end && *q == '-' && r->p == q) {
+            neg = 1;
+            ++q;
+        }
+        lim = neg ? (unsigned long long)LLONG_MAX + 1 : (unsigned long long)LLONG_MAX;
+        e = q;
+        while (e < r->end && (unsigned)(*e - '0') < 10u) {
+            unsigned d = (unsigned)(*e - '0');
+            if (v > (lim - d) / 10) {
+                r->p = fio__token_end(r);
+                return -1;
+            }
+            v = v * 10 + d;
+            ++e;
+        }
+        if (e == q || (e < r->end && !fio__is_space(*e))) {
+            r->p = fio__token_end(r);
+            return -1;
+        }
+        *out = neg ? (long long)(0 - v) : (long long)v;
+    }
+#endif
+    r->p = e;
+    return 1;
+}
+
+static inline int fio_read_int(FioReader *r, int *out) {
+    long long v;
+    int rc = fio_read_i64(r, &v);
+    if (rc != 1) return rc;
+    if (v < INT_MIN || v > INT_MAX) return -1;
+    *out = (int)v;
+    return 1;
+}
+
+static inline int fio_read_double(FioReader *r, double *out) {
+    const char *q, *e;
+    if (!fio__token(r)) return 0;
+    q = r->p;
+    if (*q == '+' && ++q < r->end && *q == '-') q = r->end;
+#ifdef FIO_HAVE_CHARCONV_FP
+    {
+        std::from_chars_result res = std::from_chars(q, r->end, *out);
+        e = res.ptr;
+        if (res.ec != std::errc() || (e < r->end && !fio__is_space(*e))) {
+            r->p = fio__token_end(r);
+            return -1;
+        }
+    }
+#else
+    {
+        /* mmap 的数据不以 '\0' 结尾，strtod 之前拷一份记号 */
+        char tmp[FIO_TOKEN_MAX + 1], *te;
+        const char *tend = fio__token_end(r);
+        size_t len = (size_t)(tend - q);
+        if (len == 0 || len > FIO_TOKEN_MAX) {
+            r->p = tend;
+            return -1;
+        }
+        memcpy(tmp, q, len);
+        tmp[len] = '\0';
+        errno = 0;
+        *out = strtod(tmp, &te);
+        if (te != tmp + len || errno == ERANGE) {
+            r->p = tend;
+            return -1;
+        }
+        e = tend;
+    }
+#endif
+    r->p = e;
+    return 1;
+}
+
+/* ---------------- 写 ---------------- */
+
+/* cap 为 0 时用 FIO_BUF_SIZE；返回 0 成功 */
+static inline int fio_writer_init(FioWriter *w, FILE *fp, size_t cap) {
+    w->fp = fp;
+    w->cap = cap ? cap : FIO_BUF_SIZE;
+    if (w->cap < 2 * FIO_TOKEN_MAX) w->cap = 2 * FIO_TOKEN_MAX;
+    w->len = 0;
+    w->err = 0;
+    w->buf = (char *)malloc(w->cap);
+    return w->buf ? 0 : -1;
+}
+
+static inline void fio_flush(FioWriter *w) {
+    if (w->len && fwrite(w->buf, 1, w->len, w->fp) != w->len) w->err = 1;
+    w->len = 0;
+    if (fflush(w->fp) != 0) w->err = 1;
+}
+
+/* 刷出并释放缓冲区（不关闭 fp）；返回 0 表示全部写成功 */
+static inline int fio_writer_close(FioWriter *w) {
+    int err;
+    fio_flush(w);
+    free(w->buf);
+    w->buf = NULL;
+    err = w->err;
+    return err ? -1 : 0;
+}
+
+/* 保证还有 n 字节空间（n 不超过 cap） */
+static inline char *fio__reserve(FioWriter *w, size_t n) {
+    if (w->cap - w->len < n) {
+        if (fwrite(w->buf, 1, w->len, w->fp) != w->len) w->err = 1;
+        w->len = 0;
+    }
+    return w->buf + w->len;
+}
+
+static inline void fio_put_char(FioWriter *w, char c) {
+    *fio__reserve(w, 1) = c;
+    ++w->len;
+}
+
+static inline void fio_put_mem(FioWriter *w, const char *s, size_t n) {
+    while (n) {
+        size_t k = w->cap - w->len;
+        if (k == 0) {
+            fio__reserve(w, w->cap);
+            k = w->cap;
+        }
+        if (k > n) k = n;
+        memcpy(w->buf + w->len, s, k);
+        w->len += k;
+        s += k;
+        n -= k;
+    }
+}
+
+static inline void fio_put_str(FioWriter *w, const char *s) { fio_put_mem(w, s, strlen(s)); }
+
+static inline void fio_put_u64(FioWriter *w, unsigned long long v) {
+    char *d = fio__reserve(w, 24);
+#ifdef FIO_HAVE_CHARCONV
+    w->len = (size_t)(std::to_chars(d, d + 24, v).ptr - w->buf);
+#else
+    char tmp[24];
+    int n = 0;
+    do tmp[n++] = (char)('0' + v % 10); while ((v /= 10) != 0);
+    while (n) *d++ = tmp[--n];
+    w->len = (size_t)(d - w->buf);
+#endif
+}
+
+static inline void fio_put_i64(FioWriter *w, long long v) {
+    if (v < 0) {
+        fio_put_char(w, '-');
+        fio_put_u64(w, 0ULL - (unsigned long long)v);
+    } else {
+        fio_put_u64(w, (unsigned long long)v);
+    }
+}
+
+/* 定点格式，prec 位小数（同 printf("%.*f")） */
+static inline void fio_put_f64(FioWriter *w, double x, int prec) {
+#ifdef FIO_HAVE_CHARCONV_FP
+    char *d = fio__reserve(w, FIO_TOKEN_MAX);
+    std::to_chars_result res = std::to_chars(d, d + FIO_TOKEN_MAX, x, std::chars_format::fixed, prec);
+    if (res.ec == std::errc()) {
+        w->len = (size_t)(res.ptr - w->buf);
+        return;
+    }
+#endif
+    /* 很大的数定点格式可达 300 多位 */
+    {
+        char tmp[400];
+        int n = snprintf(tmp, sizeof tmp, "%.*f", prec, x);
+        if (n > 0) fio_put_mem(w, tmp, (size_t)n < sizeof tmp ? (size_t)n : sizeof tmp - 1);
+    }
+}
+
+#endif  // FASTIO_H
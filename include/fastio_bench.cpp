@@ -0,0 +1,233 @@
+/*
+ * fastio.h 的吞吐量测试：与 iostream、stdio 比较读写 n 个数的速度
+ * - 读整数：ifstream >>、fscanf("%lld")、FioReader（mmap）、FioReader（缓冲 fread）
+ * - 读浮点：ifstream >>、fscanf("%lf")、FioReader（mmap）
+ * - 写整数/浮点（%.6f）：ofstream <<、fprintf、FioWriter
+ * 读的每种方式都核对校验和，写的核对输出文件字节数。数据在临时文件里（页缓存内），每项取 3 次最好成绩。
+ *
+ * 编译: g++ -std=c++17 -O2 fastio_bench.cpp -o fastio_bench
+ * 用法: fastio_bench [整数个数，默认 10000000] [临时文件目录，默认 /tmp]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench_util.h"
+#include "fastio.h"
+
+static long long file_size(const std::string &path) {
+    FILE *fp = std::fopen(path.c_str(), "rb");
+    if (!fp) return 0;
+    std::fseek(fp, 0, SEEK_END);
+    long long n = std::ftell(fp);
+    std::fclose(fp);
+    return n;
+}
+
+struct Result {
+    double ms;
+    unsigned long long sum;
+};
+
+static Result timed(const std::function<unsigned long long()> &fn) {
+    double best = 1e300;
+    unsigned long long sum = 0;
+    for (int rep = 0; rep < 3; ++rep) {
+        double t = now_ms();
+        sum = fn();
+        best = std::min(best, now_ms() - t);
+    }
+    return {best, sum};
+}
+
+static void report(const char *name, Result r, long long bytes, unsigned long long expect) {
+    std::printf("  %-26s %9.1f ms %9.1f MB/s%s\n", name, r.ms, bytes / r.ms / 1e3,
+                r.sum == expect ? "" : "  CHECKSUM MISMATCH");
+}
+
+/* 浮点校验和：按位相加，读回的值必须与写出时逐位相同（%.17g 可往返） */
+static unsigned long long bits(double x) {
+    unsigned long long u;
+    std::memcpy(&u, &x, sizeof u);
+    return u;
+}
+
+int main(int argc, char **argv) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+    std::string ipath = dir + "/fastio_bench_i.txt", dpath = dir + "/fastio_bench_d.txt",
+                opath = dir + "/fastio_bench_out.txt";
+
+    /* 生成数据：整数是 ±10^18 内的随机数，每行 10 个；浮点取 n/4 个，%.17g */
+    std::mt19937_64 rng(2024);
+    std::vector<long long> iv(n);
+    std::vector<double> dv(n / 4);
+    unsigned long long isum = 0, dsum = 0;
+    for (auto &x : iv) {
+        x = static_cast<long long>(rng() % 2000000000000000001ULL) - 1000000000000000000LL;
+        isum += static_cast<unsigned long long>(x);
+    }
+    std::uniform_real_distribution<double> ud(-1e6, 1e6);
+    for (auto &x : dv) {
+        x = ud(rng);
+        dsum += bits(x);
+    }
+    {
+        FILE *fi = std::fopen(ipath.c_str(), "wb"), *fd = std::fopen(dpath.c_str(), "wb");
+        if (!fi || !fd) {
+            std::perror("fopen");
+            return 1;
+        }
+        for (std::size_t i = 0; i < iv.size(); ++i) std::fprintf(fi, "%lld%c", iv[i], i % 10 == 9 ? '\n' : ' ');
+        for (std::size_t i = 0; i < dv.size(); ++i) std::fprintf(fd, "%.17g%c", dv[i], i % 10 == 9 ? '\n' : ' ');
+        std::fclose(fi);
+        std::fclose(fd);
+    }
+    long long ibytes = file_size(ipath), dbytes = file_size(dpath);
+
+    std::printf("read %zu integers (%.1f MB)\n", n, ibytes / 1e6);
+    report("ifstream >>", timed([&] {
+               std::ifstream in(ipath);
+               unsigned long long s = 0;
+               long long x;
+               while (in >> x) s += static_cast<unsigned long long>(x);
+               return s;
+           }), ibytes, isum);
+    report("fscanf %lld", timed([&] {
+               FILE *fp = std::fopen(ipath.c_str(), "rb");
+               unsigned long long s = 0;
+               long long x;
+               while (std::fscanf(fp, "%lld", &x) == 1) s += static_cast<unsigned long long>(x);
+               std::fclose(fp);
+               return s;
+           }), ibytes, isum);
+    report("FioReader (mmap)", timed([&] {
+               FioReader in;
+               unsigned long long s = 0;
+               long long x;
+               if (fio_open(&in, ipath.c_str()) != 0) return s;
+               while (fio_read_i64(&in, &x) == 1) s += static_cast<unsigned long long>(x);
+               fio_close(&in);
+               return s;
+           }), ibytes, isum);
+    report("FioReader (fread)", timed([&] {
+               FioReader in;
+               FILE *fp = std::fopen(ipath.c_str(), "rb");
+               unsigned long long s = 0;
+               long long x;
+               fio_open_file(&in, fp);
+               while (fio_read_i64(&in, &x) == 1) s += static_cast<unsigned long long>(x);
+               fio_close(&in);
+               std::fclose(fp);
+               return s;
+           }), ibytes, isum);
+
+    std::printf("read %zu doubles (%.1f MB)\n", dv.size(), dbytes / 1e6);
+    report("ifstream >>", timed([&] {
+               std::ifstream in(dpath);
+               unsigned long long s = 0;
+               double x;
+               while (in >> x) s += bits(x);
+               return s;
+           }), dbytes, dsum);
+    report("fscanf %lf", timed([&] {
+               FILE *fp = std::fopen(dpath.c_str(), "rb");
+               unsigned long long s = 0;
+               double x;
+               while (std::fscanf(fp, "%lf", &x) == 1) s += bits(x);
+               std::fclose(fp);
+               return s;
+           }), dbytes, dsum);
+    report("FioReader (mmap)", timed([&] {
+               FioReader in;
+               unsigned long long s = 0;
+               double x;
+               if (fio_open(&in, dpath.c_str()) != 0) return s;
+               while (fio_read_double(&in, &x) == 1) s += bits(x);
+               fio_close(&in);
+               return s;
+           }), dbytes, dsum);
+
+    /* 写：校验和取输出文件的字节数，三种方式必须一致 */
+    std::printf("write %zu integers\n", n);
+    auto wsize = [&](const std::function<void()> &fn) {
+        fn();
+        return static_cast<unsigned long long>(file_size(opath));
+    };
+    unsigned long long ref = wsize([&] {
+        FILE *fp = std::fopen(opath.c_str(), "wb");
+        for (long long x : iv) std::fprintf(fp, "%lld\n", x);
+        std::fclose(fp);
+    });
+    report("ofstream <<", timed([&] {
+               return wsize([&] {
+                   std::ofstream out(opath);
+                   for (long long x : iv) out << x << '\n';
+               });
+           }), (long long)ref, ref);
+    report("fprintf %lld", timed([&] {
+               return wsize([&] {
+                   FILE *fp = std::fopen(opath.c_str(), "wb");
+                   for (long long x : iv) std::fprintf(fp, "%lld\n", x);
+                   std::fclose(fp);
+               });
+           }), (long long)ref, ref);
+    report("FioWriter", timed([&] {
+               return wsize([&] {
+                   FILE *fp = std::fopen(opath.c_str(), "wb");
+                   FioWriter w;
+                   fio_writer_init(&w, fp, 0);
+                   for (long long x : iv) {
+                       fio_put_i64(&w, x);
+                       fio_put_char(&w, '\n');
+                   }
+                   fio_writer_close(&w);
+                   std::fclose(fp);
+               });
+           }), (long long)ref, ref);
+
+    std::printf("write %zu doubles (%%.6f)\n", dv.size());
+    ref = wsize([&] {
+        FILE *fp = std::fopen(opath.c_str(), "wb");
+        for (double x : dv) std::fprintf(fp, "%.6f\n", x);
+        std::fclose(fp);
+    });
+    report("ofstream << fixed", timed([&] {
+               return wsize([&] {
+                   std::ofstream out(opath);
+                   out.setf(std::ios::fixed);
+                   out.precision(6);
+                   for (double x : dv) out << x << '\n';
+               });
+           }), (long long)ref, ref);
+    report("fprintf %.6f", timed([&] {
+               return wsize([&] {
+                   FILE *fp = std::fopen(opath.c_str(), "wb");
+                   for (double x : dv) std::fprintf(fp, "%.6f\n", x);
+                   std::fclose(fp);
+               });
+           }), (long long)ref, ref);
+    report("FioWriter", timed([&] {
+               return wsize([&] {
+                   FILE *fp = std::fopen(opath.c_str(), "wb");
+                   FioWriter w;
+                   fio_writer_init(&w, fp, 0);
+                   for (double x : dv) {
+                       fio_put_f64(&w, x, 6);
+                       fio_put_char(&w, '\n');
+                   }
+                   fio_writer_close(&w);
+                   std::fclose(fp);
+               });
+           }), (long long)ref, ref);
+
+    std::remove(ipath.c_str());
+    std::remove(dpath.c_str());
+    std::remove(opath.c_str());
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * 135. Candy 的并行版本：两遍贪心改写成两个分段扫描，多线程两级块扫描，header-only，C++17
+ *
+ * 两遍贪心里
+ *   L[i] = 1（i == 0 或 r[i] <= r[i-1]），否则 L[i-1] + 1
+ *   R[i] = 1（i == n-1 或 r[i] <= r[i+1]），否则 R[i+1] + 1
+ * 都是“遇到重置点归 1、否则加 1”的分段扫描，等价于
+ *   L[i] = i - s(i) + 1，s(i) = i 之前（含）最后一个左重置点
+ *   R[i] = e(i) - i + 1，e(i) = i 之后（含）第一个右重置点
+ * s、e 分别是重置点下标的前缀 max / 后缀 min，满足结合律，可以分块并行：
+ * 1. 数组切成 tile（默认 4096 个元素，L1/L2 放得下），每个线程负责连续的一段 tile，
+ *    算出每个 tile 内最后一个左重置点、第一个右重置点
+ * 2. 两级扫描求每个 tile 的进位：线程先在自己的 tile 里归约，线程间的进位顺序扫描（T 个值），
+ *    再各自把进位扫进自己的 tile
+ * 3. 每个 tile 先倒着扫一遍得到 R（写进每线程一块 tile 大小的缓冲），再正着扫一遍得到 L，
+ *    当场累加 max(L, R)：tile 在缓存里，L、R 都不落回内存，最后各线程的部分和相加
+ * 输入总共从内存读两遍（第 1 步和第 3 步），不需要 O(n) 的辅助数组。
+ *
+ * 结果用 uint64_t：n = 10^9 的严格递增序列答案约 5·10^17。
+ *
+ * 单线程时内层循环是条件传送链，与评分分布无关，约 2 ns/元素；一遍扫描（candy_onepass）
+ * 在随机评分上被分支预测失败拖慢（约 2.5 倍于本实现），但在长单调段上更快（约 2 倍），
+ * 所以单调段多的输入要 2 个线程以上才划算。测速见 candy_scan_bench.cpp。
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace candy {
+
+/* 参考实现：与 problems/0135-candy 的 v1 相同的两遍贪心，只是下标和结果放宽到 64 位 */
+inline std::uint64_t candy_sequential(const int *r, std::size_t n) {
+    if (n == 0) return 0;
+    std::vector<std::uint32_t> left(n, 1);
+    for (std::size_t i = 1; i < n; ++i)
+        if (r[i] > r[i - 1]) left[i] = left[i - 1] + 1;
+    std::uint64_t sum = left[n - 1];
+    std::uint32_t right = 1;
+    for (std::size_t i = n - 1; i-- > 0;) {
+        right = r[i] > r[i + 1] ? right + 1 : 1;
+        sum += std::max(left[i], right);
+    }
+    return sum;
+}
+
+/* 一遍扫描、O(1) 额外空间（problems/0135-candy 的 v2），大规模测速时当参考，不用再开 n 个辅助数 */
+inline std::uint64_t candy_onepass(const int *r, std::size_t n) {
+    if (n == 0) return 0;
+    std::uint64_t sum = 1, up = 0, down = 0, peak = 0;
+    for (std::size_t i = 1; i < n; ++i) {
+        if (r[i] > r[i - 1]) {
+            peak = ++up;
+            down = 0;
+            sum += up + 1;
+        } else if (r[i] == r[i - 1]) {
+            up = down = peak = 0;
+            sum += 1;
+        } else {
+            up = 0;
+            ++down;
+            sum += down + (peak >= down ? 0 : 1);
+        }
+    }
+    return sum;
+}
+
+namespace detail {
+
+constexpr std::size_t kNone = SIZE_MAX;  // 没有左重置点，前缀 max 的单位元
+
+struct TileCarry {
+    std::size_t last_l;    // tile 内最后一个左重置点，没有则 kNone
+    std::size_t first_r;   // tile 内第一个右重置点，没有则 n
+};
+
+inline bool reset_l(const int *r, std::size_t i) { return i == 0 || r[i] <= r[i - 1]; }
+inline bool reset_r(const int *r, std::size_t n, std::size_t i) { return i == n - 1 || r[i] <= r[i + 1]; }
+
+/* 第 1 步：tile [a, b) 的摘要 */
+inline TileCarry summarize(const int *r, std::size_t n, std::size_t a, std::size_t b) {
+    TileCarry c{kNone, n};
+    for (std::size_t i = b; i-- > a;)
+        if (reset_l(r, i)) { c.last_l = i; break; }
+    for (std::size_t i = a; i < b; ++i)
+        if (reset_r(r, n, i)) { c.first_r = i; break; }
+    return c;
+}
+
+/* 前缀 max，kNone 视为比任何下标都小 */
+inline std::size_t max_l(std::size_t x, std::size_t y) {
+    if (x == kNone) return y;
+    if (y == kNone) return x;
+    return std::max(x, y);
+}
+
+/* 第 3 步：s_in = a 之前最后一个左重置点（a == 0 时无意义，reset_l(0) 恒成立），
+ * e_in = b 及之后第一个右重置点；buf 至少 b - a 个元素 */
+inline std::uint64_t tile_sum(const int *r, std::size_t n, std::size_t a, std::size_t b, std::size_t s_in,
+                              std::size_t e_in, std::uint32_t *buf) {
+    /* 两端的 i == n-1、i == 0 单独处理，内层循环只剩比较和条件传送 */
+    std::size_t e = e_in, hi = b;
+    if (b == n) {
+        e = hi = n - 1;
+        buf[hi - a] = 1;
+    }
+    for (std::size_t i = hi; i-- > a;) {
+        e = r[i] <= r[i + 1] ? i : e;
+        buf[i - a] = static_cast<std::uint32_t>(e - i + 1);
+    }
+    std::size_t s = s_in, lo = a;
+    std::uint64_t sum = 0;
+    if (a == 0) {
+        s = 0;
+        lo = 1;
+        sum = buf[0];
+    }
+    for (std::size_t i = lo; i < b; ++i) {
+        s = r[i] <= r[i - 1] ? i : s;
+        std::uint32_t L = static_cast<std::uint32_t>(i - s + 1);
+        sum += std::max(L, buf[i - a]);
+    }
+    return sum;
+}
+
+template <typename Fn>
+void parallel_for(unsigned threads, Fn fn) {
+    if (threads <= 1) {
+        fn(0u);
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(fn, t);
+    fn(0u);
+    for (auto &th : pool) th.join();
+}
+
+}  // namespace detail
+
+/*
+ * threads 为 0 时按硬件线程数，并保证每个线程至少 1M 个元素；tile 是第 3 步的缓存块大小。
+ * 结果与 candy_sequential 逐位相同。
+ */
+inline std::uint64_t candy_parallel(const int *r, std::size_t n, unsigned threads = 0, std::size_t tile = 4096) {
+    using namespace detail;
+    if (n == 0) return 0;
+    if (tile == 0) tile = 4096;
+    std::size_t ntiles = (n + tile - 1) / tile;
+    if (threads == 0) {
+        static const unsigned hw = std::max(1u, std::thread::hardware_concurrency());  // glibc 每次都读 /sys
+        threads = hw;
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, n >> 20)));
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, ntiles));
+
+    /* 线程 t 负责 tile [tb[t], tb[t+1]) */
+    std::vector<std::size_t> tb(threads + 1);
+    for (unsigned t = 0; t <= threads; ++t) tb[t] = ntiles * t / threads;
+
+    std::vector<TileCarry> carry(ntiles);
+    std::vector<TileCarry> block(threads);
+    std::vector<std::uint64_t> partial(threads);
+
+    /* 第 1 步 + 块内归约 */
+    parallel_for(threads, [&](unsigned t) {
+        TileCarry acc{kNone, n};
+        for (std::size_t k = tb[t]; k < tb[t + 1]; ++k) {
+            carry[k] = summarize(r, n, k * tile, std::min(n, (k + 1) * tile));
+            acc.last_l = max_l(acc.last_l, carry[k].last_l);
+            if (acc.first_r == n) acc.first_r = carry[k].first_r;
+        }
+        block[t] = acc;
+    });
+
+    /* 第 2 步：块间进位（T 个值，顺序扫描），in[t] 是线程 t 的区间之前/之后的进位 */
+    std::vector<TileCarry> in(threads);
+    std::size_t s = kNone;
+    for (unsigned t = 0; t < threads; ++t) {
+        in[t].last_l = s;
+        s = max_l(s, block[t].last_l);
+    }
+    std::size_t e = n;
+    for (unsigned t = threads; t-- > 0;) {
+        in[t].first_r = e;
+        if (block[t].first_r != n) e = block[t].first_r;
+    }
+
+    /* 块内把进位扫进各 tile，随即做第 3 步 */
+    parallel_for(threads, [&](unsigned t) {
+        std::size_t k0 = tb[t], k1 = tb[t + 1];
+        /* 右进位要从后往前推：先把本线程各 tile 的 e_in 算出来 */
+        std::vector<std::size_t> e_in(k1 - k0);
+        std::size_t ec = in[t].first_r;
+        for (std::size_t k = k1; k-- > k0;) {
+            e_in[k - k0] = ec;
+            if (carry[k].first_r != n) ec = carry[k].first_r;
+        }
+        std::vector<std::uint32_t> buf(tile);
+        std::size_t sc = in[t].last_l;
+        std::uint64_t sum = 0;
+        for (std::size_t k = k0; k < k1; ++k) {
+            sum += tile_sum(r, n, k * tile, std::min(n, (k + 1) * tile), sc, e_in[k - k0], buf.data());
+            sc = max_l(sc, carry[k].last_l);
+        }
+        partial[t] = sum;
+    });
+
+    std::uint64_t total = 0;
+    for (auto p : partial) total += p;
+    return total;
+}
+
+}  // namespace candy
@@ -0,0 +1,126 @@
+/*
+ * candy_scan.hpp 的正确性检查与扩展性测速
+ * - 正确性：随机评分（值域小，大量相等）、长单调段跨 tile/跨线程边界、全增/全减/全等、n = 1, 2，
+ *   tile ∈ {1, 7, 64, 4096}，线程数 ∈ {1, 2, 3, 7, 16}，与两遍贪心、一遍扫描两个参考逐位比对
+ * - 测速：n 个评分（默认 10^8，约 400MB；10^9 需要 4GB），线程数从 1 翻倍到硬件线程数，
+ *   与一遍扫描比较并核对结果，两种输入：均匀随机 [0, 20000]，随机长度的上坡/下坡/平台段
+ *
+ * 编译: g++ -std=c++17 -O2 -pthread candy_scan_bench.cpp -o candy_scan_bench
+ * 用法: candy_scan_bench [n，默认 100000000] [最大线程数，默认硬件线程数]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../../include/bench_util.h"
+#include "candy_scan.hpp"
+
+static void fill_uniform(std::vector<int> &r, unsigned seed, int hi) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> d(0, hi);
+    for (auto &x : r) x = d(rng);
+}
+
+/* 随机长度（1..maxlen）的上坡、下坡、平台段首尾相接 */
+static void fill_runs(std::vector<int> &r, unsigned seed, std::size_t maxlen) {
+    std::mt19937_64 rng(seed);
+    std::size_t i = 0;
+    int v = 0;
+    while (i < r.size()) {
+        std::size_t len = 1 + rng() % maxlen;
+        int dir = static_cast<int>(rng() % 3) - 1;
+        for (std::size_t j = 0; j < len && i < r.size(); ++j, ++i) {
+            r[i] = v;
+            v += dir;
+        }
+    }
+}
+
+static int check(const std::vector<int> &r, const char *what) {
+    std::uint64_t ref = candy::candy_sequential(r.data(), r.size());
+    if (candy::candy_onepass(r.data(), r.size()) != ref) {
+        std::printf("FAIL %s n=%zu: onepass != sequential\n", what, r.size());
+        return 1;
+    }
+    static const unsigned threads[] = {1, 2, 3, 7, 16};
+    static const std::size_t tiles[] = {1, 7, 64, 4096};
+    for (unsigned t : threads)
+        for (std::size_t tile : tiles) {
+            std::uint64_t got = candy::candy_parallel(r.data(), r.size(), t, tile);
+            if (got != ref) {
+                std::printf("FAIL %s n=%zu threads=%u tile=%zu: %llu != %llu\n", what, r.size(), t, tile,
+                            (unsigned long long)got, (unsigned long long)ref);
+                return 1;
+            }
+        }
+    return 0;
+}
+
+static int correctness() {
+    int fails = 0;
+    for (std::size_t n : {1, 2, 3, 5, 100, 4095, 4096, 4097, 100000}) {
+        std::vector<int> r(n);
+        fill_uniform(r, 1 + (unsigned)n, 3);
+        fails += check(r, "uniform[0,3]");
+        fill_uniform(r, 2 + (unsigned)n, 20000);
+        fails += check(r, "uniform[0,2e4]");
+        fill_runs(r, 3 + (unsigned)n, 20000);
+        fails += check(r, "runs<=2e4");
+        fill_runs(r, 4 + (unsigned)n, 50);
+        fails += check(r, "runs<=50");
+        for (std::size_t i = 0; i < n; ++i) r[i] = (int)i;
+        fails += check(r, "increasing");
+        for (std::size_t i = 0; i < n; ++i) r[i] = -(int)i;
+        fails += check(r, "decreasing");
+        for (auto &x : r) x = 7;
+        fails += check(r, "equal");
+        /* 一个覆盖整段的山峰：左、右进位都要穿过所有 tile 和线程 */
+        for (std::size_t i = 0; i < n; ++i) r[i] = -(int)(i > n / 3 ? i - n / 3 : n / 3 - i);
+        fails += check(r, "mountain");
+    }
+    std::printf("correctness: %s\n", fails ? "FAILED" : "ok");
+    return fails;
+}
+
+static void scaling(const char *name, const std::vector<int> &r, unsigned max_threads) {
+    std::size_t n = r.size();
+    double t0 = now_ms();
+    std::uint64_t ref = candy::candy_onepass(r.data(), n);
+    double base = now_ms() - t0;
+    std::printf("\n%s, n = %zu, answer = %llu\n", name, n, (unsigned long long)ref);
+    std::printf("  %-10s %10s %10s %9s\n", "threads", "ms", "GB/s", "speedup");
+    std::printf("  %-10s %10.1f %10.2f %9s\n", "onepass", base, n * 4.0 / base / 1e6, "1.00");
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) counts.push_back(t);
+    counts.push_back(max_threads);
+    for (unsigned t : counts) {
+        double best = 1e300;
+        std::uint64_t got = 0;
+        for (int rep = 0; rep < 3; ++rep) {
+            double a = now_ms();
+            got = candy::candy_parallel(r.data(), n, t);
+            best = std::min(best, now_ms() - a);
+        }
+        std::printf("  %-10u %10.1f %10.2f %9.2f%s\n", t, best, n * 4.0 / best / 1e6, base / best,
+                    got == ref ? "" : "  MISMATCH");
+    }
+}
+
+int main(int argc, char **argv) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    unsigned max_threads = argc > 2 ? (unsigned)std::strtoul(argv[2], nullptr, 10) : hw;
+    if (max_threads == 0) max_threads = hw;
+    std::printf("hardware threads: %u\n", hw);
+
+    if (correctness()) return 1;
+
+    std::vector<int> r(n);
+    fill_uniform(r, 12345, 20000);
+    scaling("uniform [0, 20000]", r, max_threads);
+    fill_runs(r, 54321, 4096);
+    scaling("runs (length <= 4096)", r, max_threads);
+    return 0;
+}
@@ -0,0 +1,463 @@
+/*
+ * 开放寻址的扁平哈希表（Swiss table 布局），header-only，C++17
+ *
+ * 用来替换解答里的 std::unordered_map / unordered_set：后者每个元素一个结点、一次分配，
+ * 查找要追指针。这里：
+ * - 一次分配：控制字节数组 + 槽数组放在同一块内存里，容量为 2 的幂，最大装载率 7/8
+ * - 每个槽对应一个控制字节：空 0x80、已删除 0xFE、占用时存哈希值的低 7 位（H2）
+ * - 探测以“组”为单位：一次 SIMD 比较同时检查一组控制字节（AVX2 32 个、SSE2 16 个，
+ *   其他平台用 64 位 SWAR 8 个），H2 命中才去比较键；组里有空位就说明键不存在
+ * - 组间按三角数步长探测，控制字节尾部复制一份前 W 字节，任意位置都能整组读取
+ * - 删除时，如果周围的探测链不可能经过这里，直接置空，否则留删除标记
+ * - reserve(n) 一次预留到位，之后插入 n 个元素都不会再分配
+ *
+ * 用法与 unordered_map 基本相同（find / contains / operator[] / try_emplace / erase / 遍历），
+ * 但插入可能让所有迭代器和引用失效（扩容时整体搬迁）。
+ *
+ *   fhm::FlatHashMap<int, int> seen;
+ *   seen.reserve(nums.size());
+ *   if (auto it = seen.find(target - x); it != seen.end()) ...
+ *   seen[x] = i;
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/* 定义 FHM_NO_SIMD 可强制使用可移植的 SWAR 组 */
+#if defined(FHM_NO_SIMD)
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define FHM_HAVE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FHM_HAVE_SSE2 1
+#endif
+
+namespace fhm {
+
+/* ========== 哈希 ========== */
+/* 整数键用 64×64→128 位乘法折叠（高低半异或），低位和高位都充分混合 */
+inline std::uint64_t mix(std::uint64_t x) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t p = static_cast<__uint128_t>(x) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::uint64_t>(p) ^ static_cast<std::uint64_t>(p >> 64);
+#else
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    return x ^ (x >> 33);
+#endif
+}
+
+template <typename K, typename = void>
+struct Hash {
+    std::uint64_t operator()(const K &k) const { return mix(std::hash<K>{}(k)); }
+};
+
+template <typename K>
+struct Hash<K, std::enable_if_t<std::is_integral_v<K> || std::is_enum_v<K> || std::is_pointer_v<K>>> {
+    std::uint64_t operator()(K k) const {
+        if constexpr (std::is_pointer_v<K>) return mix(reinterpret_cast<std::uintptr_t>(k));
+        else return mix(static_cast<std::uint64_t>(k));
+    }
+};
+
+namespace detail {
+
+using ctrl_t = std::int8_t;
+constexpr ctrl_t kEmpty = -128;      // 0x80
+constexpr ctrl_t kDeleted = -2;      // 0xFE
+
+inline int ctz(std::uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return static_cast<int>(i);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+inline int clz(std::uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanReverse64(&i, x);
+    return 63 - static_cast<int>(i);
+#else
+    return __builtin_clzll(x);
+#endif
+}
+
+/* 组内命中的位置集合；SIMD 版每槽 1 位，SWAR 版每槽占 1 字节的最高位（Shift = 3） */
+template <int Shift>
+struct BitMask {
+    std::uint64_t bits;
+    explicit operator bool() const { return bits != 0; }
+    int lowest() const { return ctz(bits) >> Shift; }
+    int highest() const { return (63 - clz(bits)) >> Shift; }
+    /* 逐个取出命中位置 */
+    struct It {
+        std::uint64_t b;
+        int operator*() const { return ctz(b) >> Shift; }
+        It &operator++() { b &= b - 1; return *this; }
+        bool operator!=(const It &o) const { return b != o.b; }
+    };
+    It begin() const { return It{bits}; }
+    It end() const { return It{0}; }
+};
+
+#if defined(FHM_HAVE_AVX2)
+struct Group {
+    static constexpr std::size_t kWidth = 32;
+    __m256i v;
+    explicit Group(const ctrl_t *p) : v(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p))) {}
+    BitMask<0> match(ctrl_t h) const {
+        return BitMask<0>{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(h))))};
+    }
+    BitMask<0> match_empty() const { return match(kEmpty); }
+    /* 空和已删除的最高位都是 1，占用的是 0 */
+    BitMask<0> match_empty_or_deleted() const {
+        return BitMask<0>{static_cast<std::uint32_t>(_mm256_movemask_epi8(v))};
+    }
+};
+#elif defined(FHM_HAVE_SSE2)
+struct Group {
+    static constexpr std::size_t kWidth = 16;
+    __m128i v;
+    explicit Group(const ctrl_t *p) : v(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+    BitMask<0> match(ctrl_t h) const {
+        return BitMask<0>{static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(h))))};
+    }
+    BitMask<0> match_empty() const { return match(kEmpty); }
+    BitMask<0> match_empty_or_deleted() const {
+        return BitMask<0>{static_cast<std::uint32_t>(_mm_movemask_epi8(v))};
+    }
+};
+#else
+struct Group {
+    static constexpr std::size_t kWidth = 8;
+    static constexpr std::uint64_t kLsbs = 0x0101010101010101ull, kMsbs = 0x8080808080808080ull;
+    std::uint64_t w;
+    explicit Group(const ctrl_t *p) { std::memcpy(&w, p, 8); }   // 小端
+    /* 经典的“字中找零字节”，可能有假阳性（之后要比较键，无妨），不会漏 */
+    BitMask<3> match(ctrl_t h) const {
+        std::uint64_t x = w ^ (kLsbs * static_cast<std::uint8_t>(h));
+        return BitMask<3>{(x - kLsbs) & ~x & kMsbs};
+    }
+    /* 0x80：最高位 1 且次低位 0；0xFE 的次低位是 1 */
+    BitMask<3> match_empty() const { return BitMask<3>{w & (~w << 6) & kMsbs}; }
+    BitMask<3> match_empty_or_deleted() const { return BitMask<3>{w & kMsbs}; }
+};
+#endif
+
+constexpr std::size_t kWidth = Group::kWidth;
+
+/* 容量 cap（2 的幂）下最多容纳的元素数 */
+constexpr std::size_t max_load(std::size_t cap) { return cap - cap / 8; }
+
+/* 槽的存放策略：map 存 pair<const K, V>，set 只存 K */
+template <typename K, typename V>
+struct MapPolicy {
+    using key_type = K;
+    using slot_type = std::pair<const K, V>;
+    static const K &key(const slot_type &s) { return s.first; }
+    /* 扩容搬迁：键是 const，只能借 const_cast 移动出来，源对象随后立即析构 */
+    static void transfer(slot_type *dst, slot_type *src) {
+        ::new (static_cast<void *>(dst)) slot_type(std::move(const_cast<K &>(src->first)), std::move(src->second));
+        src->~slot_type();
+    }
+};
+
+template <typename K>
+struct SetPolicy {
+    using key_type = K;
+    using slot_type = K;
+    static const K &key(const slot_type &s) { return s; }
+    static void transfer(slot_type *dst, slot_type *src) {
+        ::new (static_cast<void *>(dst)) slot_type(std::move(*src));
+        src->~slot_type();
+    }
+};
+
+/* ========== 底层表 ========== */
+template <typename Policy, typename HashFn, typename Eq>
+class RawTable {
+public:
+    using key_type = typename Policy::key_type;
+    using slot_type = typename Policy::slot_type;
+
+    template <bool Const>
+    class Iter {
+        using Table = std::conditional_t<Const, const RawTable, RawTable>;
+        using Ref = std::conditional_t<Const, const slot_type &, slot_type &>;
+        Table *t_ = nullptr;
+        std::size_t i_ = 0;
+        void skip() { while (i_ < t_->cap_ && t_->ctrl_[i_] < 0) ++i_; }
+        friend class RawTable;
+
+    public:
+        Iter() = default;
+        Iter(Table *t, std::size_t i, bool do_skip) : t_(t), i_(i) { if (do_skip) skip(); }
+        operator Iter<true>() const { return Iter<true>(t_, i_, false); }
+        Ref operator*() const { return t_->slots_[i_]; }
+        std::remove_reference_t<Ref> *operator->() const { return &t_->slots_[i_]; }
+        Iter &operator++() { ++i_; skip(); return *this; }
+        bool operator==(const Iter &o) const { return i_ == o.i_; }
+        bool operator!=(const Iter &o) const { return i_ != o.i_; }
+    };
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    RawTable() = default;
+    explicit RawTable(std::size_t n) { reserve(n); }
+    RawTable(const RawTable &o) : hash_(o.hash_), eq_(o.eq_) {
+        reserve(o.size_);
+        for (const auto &s : o) insert_unique(s);
+    }
+    RawTable(RawTable &&o) noexcept { swap(o); }
+    RawTable &operator=(RawTable o) noexcept { swap(o); return *this; }
+    ~RawTable() { destroy(); }
+
+    void swap(RawTable &o) noexcept {
+        std::swap(ctrl_, o.ctrl_);
+        std::swap(slots_, o.slots_);
+        std::swap(cap_, o.cap_);
+        std::swap(size_, o.size_);
+        std::swap(growth_left_, o.growth_left_);
+        std::swap(hash_, o.hash_);
+        std::swap(eq_, o.eq_);
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return cap_; }
+    /* 本表占用的字节数（一次分配） */
+    std::size_t memory_bytes() const { return cap_ ? alloc_bytes(cap_) : 0; }
+
+    iterator begin() { return iterator(this, 0, true); }
+    iterator end() { return iterator(this, cap_, false); }
+    const_iterator begin() const { return const_iterator(this, 0, true); }
+    const_iterator end() const { return const_iterator(this, cap_, false); }
+
+    void clear() {
+        for (std::size_t i = 0; i < cap_; ++i)
+            if (ctrl_[i] >= 0) slots_[i].~slot_type();
+        if (cap_) {
+            std::memset(ctrl_, static_cast<std::uint8_t>(kEmpty), cap_ + kWidth);
+            growth_left_ = max_load(cap_);
+        }
+        size_ = 0;
+    }
+
+    /* 保证能再放下 n 个元素而不扩容（按总数计） */
+    void reserve(std::size_t n) {
+        if (n <= size_ + growth_left_ && cap_) return;
+        std::size_t cap = kWidth;
+        while (max_load(cap) < n) cap *= 2;
+        rehash(cap);
+    }
+
+    template <typename Q>
+    iterator find(const Q &key) {
+        return iterator(this, find_index(key, hash_(key)), false);
+    }
+    template <typename Q>
+    const_iterator find(const Q &key) const {
+        return const_iterator(this, const_cast<RawTable *>(this)->find_index(key, hash_(key)), false);
+    }
+    template <typename Q>
+    bool contains(const Q &key) const { return find(key) != end(); }
+
+    /* 找到返回 {位置, false}；否则在空槽上用 ctor(void*) 构造新元素，返回 {位置, true} */
+    template <typename Ctor>
+    std::pair<iterator, bool> find_or_construct(const key_type &key, Ctor &&ctor) {
+        std::uint64_t h = hash_(key);
+        std::size_t i = find_index(key, h);
+        if (i != cap_) return {iterator(this, i, false), false};
+        i = prepare_insert(h);
+        ctor(static_cast<void *>(slots_ + i));
+        return {iterator(this, i, false), true};
+    }
+
+    template <typename Q>
+    std::size_t erase(const Q &key) {
+        std::size_t i = find_index(key, hash_(key));
+        if (i == cap_) return 0;
+        erase_at(i);
+        return 1;
+    }
+    iterator erase(iterator it) {
+        erase_at(it.i_);
+        ++it;
+        return it;
+    }
+
+private:
+    ctrl_t *ctrl_ = nullptr;           // cap_ + kWidth 个控制字节，末尾 kWidth 个是开头的副本
+    slot_type *slots_ = nullptr;
+    std::size_t cap_ = 0, size_ = 0, growth_left_ = 0;
+    [[no_unique_address]] HashFn hash_{};
+    [[no_unique_address]] Eq eq_{};
+
+    static constexpr std::size_t slot_offset(std::size_t cap) {
+        std::size_t a = alignof(slot_type);
+        return (cap + kWidth + a - 1) / a * a;
+    }
+    static constexpr std::size_t alloc_bytes(std::size_t cap) { return slot_offset(cap) + cap * sizeof(slot_type); }
+
+    static ctrl_t h2(std::uint64_t h) { return static_cast<ctrl_t>(h & 0x7F); }
+    std::size_t h1(std::uint64_t h) const { return static_cast<std::size_t>(h >> 7) & (cap_ - 1); }
+
+    void set_ctrl(std::size_t i, ctrl_t c) {
+        ctrl_[i] = c;
+        if (i < kWidth) ctrl_[cap_ + i] = c;   // 维护尾部副本
+    }
+
+    template <typename Q>
+    std::size_t find_index(const Q &key, std::uint64_t h) {
+        if (!cap_) return 0;
+        std::size_t mask = cap_ - 1, pos = h1(h), step = 0;
+        ctrl_t tag = h2(h);
+        for (;;) {
+            Group g(ctrl_ + pos);
+            for (int j : g.match(tag)) {
+                std::size_t i = (pos + static_cast<std::size_t>(j)) & mask;
+                if (eq_(Policy::key(slots_[i]), key)) return i;
+            }
+            if (g.match_empty()) return cap_;
+            step += kWidth;                       // 三角数步长：容量为 2 的幂时能访问到每一组
+            pos = (pos + step) & mask;
+        }
+    }
+
+    /* 探测链上第一个空或已删除的槽 */
+    std::size_t find_free(std::uint64_t h) const {
+        std::size_t mask = cap_ - 1, pos = h1(h), step = 0;
+        for (;;) {
+            auto m = Group(ctrl_ + pos).match_empty_or_deleted();
+            if (m) return (pos + static_cast<std::size_t>(m.lowest())) & mask;
+            step += kWidth;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    std::size_t prepare_insert(std::uint64_t h) {
+        std::size_t i = cap_ ? find_free(h) : 0;
+        /* 复用删除标记不消耗 growth_left；只有占用真正的空槽才需要 */
+        if (!cap_ || (growth_left_ == 0 && ctrl_[i] != kDeleted)) {
+            /* 删除标记很多时原地重建即可，否则容量翻倍 */
+            rehash(cap_ && size_ <= max_load(cap_) / 2 ? cap_ : (cap_ ? cap_ * 2 : kWidth));
+            i = find_free(h);
+        }
+        growth_left_ -= ctrl_[i] == kEmpty;
+        set_ctrl(i, h2(h));
+        ++size_;
+        return i;
+    }
+
+    void erase_at(std::size_t i) {
+        slots_[i].~slot_type();
+        --size_;
+        /* 前后两组里空位之间的距离小于一组：不可能有探测链整组满着经过 i，可以直接置空 */
+        std::size_t mask = cap_ - 1, before = (i - kWidth) & mask;
+        auto ea = Group(ctrl_ + i).match_empty();
+        auto eb = Group(ctrl_ + before).match_empty();
+        bool never_full = ea && eb &&
+                          static_cast<std::size_t>(ea.lowest()) + (kWidth - 1 - static_cast<std::size_t>(eb.highest())) < kWidth;
+        set_ctrl(i, never_full ? kEmpty : kDeleted);
+        growth_left_ += never_full;
+    }
+
+    void insert_unique(const slot_type &s) {
+        std::size_t i = prepare_insert(hash_(Policy::key(s)));
+        ::new (static_cast<void *>(slots_ + i)) slot_type(s);
+    }
+
+    void rehash(std::size_t new_cap) {
+        void *mem = ::operator new(alloc_bytes(new_cap), std::align_val_t(alignof(slot_type) > 16 ? alignof(slot_type) : 16));
+        ctrl_t *old_ctrl = ctrl_;
+        slot_type *old_slots = slots_;
+        std::size_t old_cap = cap_;
+
+        ctrl_ = static_cast<ctrl_t *>(mem);
+        slots_ = reinterpret_cast<slot_type *>(static_cast<char *>(mem) + slot_offset(new_cap));
+        cap_ = new_cap;
+        std::memset(ctrl_, static_cast<std::uint8_t>(kEmpty), new_cap + kWidth);
+        growth_left_ = max_load(new_cap) - size_;
+
+        for (std::size_t i = 0; i < old_cap; ++i) {
+            if (old_ctrl[i] < 0) continue;
+            std::uint64_t h = hash_(Policy::key(old_slots[i]));
+            std::size_t j = find_free(h);
+            set_ctrl(j, h2(h));
+            Policy::transfer(slots_ + j, old_slots + i);
+        }
+        if (old_ctrl) ::operator delete(old_ctrl, std::align_val_t(alignof(slot_type) > 16 ? alignof(slot_type) : 16));
+    }
+
+    void destroy() {
+        if (!ctrl_) return;
+        for (std::size_t i = 0; i < cap_; ++i)
+            if (ctrl_[i] >= 0) slots_[i].~slot_type();
+        ::operator delete(ctrl_, std::align_val_t(alignof(slot_type) > 16 ? alignof(slot_type) : 16));
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        cap_ = size_ = growth_left_ = 0;
+    }
+};
+
+}  // namespace detail
+
+/* ========== 对外类型 ========== */
+template <typename K, typename V, typename HashFn = Hash<K>, typename Eq = std::equal_to<K>>
+class FlatHashMap : public detail::RawTable<detail::MapPolicy<K, V>, HashFn, Eq> {
+    using Base = detail::RawTable<detail::MapPolicy<K, V>, HashFn, Eq>;
+
+public:
+    using value_type = std::pair<const K, V>;
+    using typename Base::iterator;
+    using Base::Base;
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+        return this->find_or_construct(key, [&](void *p) {
+            ::new (p) value_type(std::piecewise_construct, std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        });
+    }
+    std::pair<iterator, bool> insert(const value_type &kv) { return try_emplace(kv.first, kv.second); }
+    V &operator[](const K &key) { return try_emplace(key).first->second; }
+    V &at(const K &key) {
+        auto it = this->find(key);
+        if (it == this->end()) throw std::out_of_range("fhm::FlatHashMap::at");
+        return it->second;
+    }
+    std::size_t count(const K &key) const { return this->contains(key) ? 1 : 0; }
+};
+
+template <typename K, typename HashFn = Hash<K>, typename Eq = std::equal_to<K>>
+class FlatHashSet : public detail::RawTable<detail::SetPolicy<K>, HashFn, Eq> {
+    using Base = detail::RawTable<detail::SetPolicy<K>, HashFn, Eq>;
+
+public:
+    using value_type = K;
+    using typename Base::iterator;
+    using Base::Base;
+
+    std::pair<iterator, bool> insert(const K &key) {
+        return this->find_or_construct(key, [&](void *p) { ::new (p) K(key); });
+    }
+    std::size_t count(const K &key) const { return this->contains(key) ? 1 : 0; }
+};
+
+}  // namespace fhm
@@ -0,0 +1,178 @@
+/*
+ * flat_hash_map.hpp 的正确性检查与测速
+ * - 随机插入/删除/查找与 std::unordered_map 逐步比对（含大量删除，覆盖删除标记与原地重建）
+ * - Two Sum（n = 10^7，答案在最后两个元素）：unordered_map / unordered_map+reserve / FlatHashMap+reserve
+ * - Zipf 查找混合：10^6 个键，10^7 次访问（s = 0.99，10% 不存在的键），以及按 Zipf 序列计数
+ * 内存分配次数与字节数由 include/alloc_count.hpp 统计。
+ *
+ * 编译: g++ -std=c++17 -O2 [-mavx2] flat_hash_map_bench.cpp -o flat_hash_map_bench
+ *       （不加 -mavx2 用 SSE2 的 16 字节组）
+ * 用法: flat_hash_map_bench [Two Sum 的 n，默认 10000000]
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "../../include/bench_util.h"
+#include "../../include/alloc_count.hpp"
+#include "flat_hash_map.hpp"
+
+/* 与 0001-two-sum/cpp/v1-solution.cpp 相同，只是哈希表类型可换 */
+template <typename Map>
+static std::vector<int> two_sum(const std::vector<int> &nums, int target, bool reserve) {
+    Map seen;
+    if (reserve) seen.reserve(nums.size());
+    for (int i = 0; i < (int)nums.size(); ++i) {
+        auto it = seen.find(target - nums[i]);
+        if (it != seen.end()) return {it->second, i};
+        seen[nums[i]] = i;
+    }
+    return {};
+}
+
+struct Stat {
+    double sec;
+    std::size_t allocs, bytes;
+};
+
+template <typename Fn>
+static Stat measure(Fn fn) {
+    std::size_t a0 = alloc_count::allocs, b0 = alloc_count::bytes;
+    double t0 = now_sec();
+    fn();
+    double t = now_sec() - t0;
+    return Stat{t, alloc_count::allocs - a0, alloc_count::bytes - b0};
+}
+
+static bool check() {
+    std::mt19937_64 rng(12345);
+    std::unordered_map<long long, long long> ref;
+    fhm::FlatHashMap<long long, long long> m;
+    fhm::FlatHashSet<long long> s;
+    bool ok = true;
+    for (int step = 0; step < 2000000 && ok; ++step) {
+        long long k = static_cast<long long>(rng() % 20000);   // 键空间小，插删频繁碰撞
+        switch (rng() % 4) {
+        case 0:
+        case 1: {
+            long long v = static_cast<long long>(rng());
+            ref[k] = v;
+            m[k] = v;
+            s.insert(k);
+            break;
+        }
+        case 2: {
+            std::size_t a = ref.erase(k), b = m.erase(k), c = s.erase(k);
+            ok = a == b && a == c;
+            break;
+        }
+        default: {
+            auto it = m.find(k);
+            auto jt = ref.find(k);
+            ok = (it == m.end()) == (jt == ref.end()) && (jt == ref.end() || it->second == jt->second) &&
+                 s.contains(k) == (jt != ref.end());
+        }
+        }
+        ok = ok && m.size() == ref.size() && s.size() == ref.size();
+    }
+    /* 遍历一遍，内容一致 */
+    std::size_t n = 0;
+    for (const auto &kv : m) {
+        auto jt = ref.find(kv.first);
+        ok = ok && jt != ref.end() && jt->second == kv.second;
+        ++n;
+    }
+    ok = ok && n == ref.size();
+    /* 字符串键、拷贝、clear */
+    fhm::FlatHashMap<std::string, int> sm;
+    for (int i = 0; i < 1000; ++i) sm["k" + std::to_string(i)] = i;
+    auto sm2 = sm;
+    sm.clear();
+    ok = ok && sm.empty() && sm2.size() == 1000 && sm2.at("k777") == 777 && !sm.contains("k1");
+    return ok;
+}
+
+/* Zipf(s) 分布的 n 个秩，返回 count 个样本（秩从 0 开始） */
+static std::vector<std::uint32_t> zipf_samples(std::size_t n, double s, std::size_t count, std::mt19937_64 &rng) {
+    std::vector<double> cdf(n);
+    double acc = 0;
+    for (std::size_t i = 0; i < n; ++i) cdf[i] = acc += 1.0 / std::pow(static_cast<double>(i + 1), s);
+    std::uniform_real_distribution<double> u(0, acc);
+    std::vector<std::uint32_t> out(count);
+    for (auto &x : out) x = static_cast<std::uint32_t>(std::lower_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin());
+    return out;
+}
+
+int main(int argc, char **argv) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    bool ok = check();
+    std::printf("正确性检查: %s\n", ok ? "通过" : "失败");
+    std::printf("组宽 %zu 字节（%s）\n\n", fhm::detail::kWidth,
+                fhm::detail::kWidth == 32 ? "AVX2" : fhm::detail::kWidth == 16 ? "SSE2" : "SWAR");
+
+    /* Two Sum：互不相同的随机值，唯一答案放在最后两个位置，扫描全程都要插入 */
+    std::mt19937_64 rng(2024);
+    std::vector<int> nums(n);
+    for (std::size_t i = 0; i < n; ++i) nums[i] = static_cast<int>(i * 2 + 7);   // 全是不小于 7 的奇数
+    std::shuffle(nums.begin(), nums.end() - 2, rng);
+    nums[n - 2] = 2;
+    nums[n - 1] = 4;                                                            // 偶数 + 偶数 = 6，只此一对
+    int target = 6;
+    std::vector<int> r1, r2, r3;
+    Stat s1 = measure([&] { r1 = two_sum<std::unordered_map<int, int>>(nums, target, false); });
+    Stat s2 = measure([&] { r2 = two_sum<std::unordered_map<int, int>>(nums, target, true); });
+    Stat s3 = measure([&] { r3 = two_sum<fhm::FlatHashMap<int, int>>(nums, target, true); });
+    ok = ok && r1 == r2 && r1 == r3 && r1 == std::vector<int>{static_cast<int>(n - 2), static_cast<int>(n - 1)};
+    std::printf("Two Sum n = %zu\n", n);
+    std::printf("  %-28s %10s %12s %12s\n", "", "耗时 ms", "分配次数", "分配 MB");
+    auto row = [](const char *name, const Stat &s) {
+        std::printf("  %-28s %10.1f %12zu %12.1f\n", name, s.sec * 1e3, s.allocs, s.bytes / 1048576.0);
+    };
+    row("unordered_map", s1);
+    row("unordered_map + reserve", s2);
+    row("FlatHashMap + reserve", s3);
+
+    /* Zipf 查找：10^6 个随机键，访问序列里 10% 换成不存在的键 */
+    std::size_t nkeys = 1000000, nops = 10000000;
+    std::vector<std::uint64_t> keys(nkeys);
+    for (auto &k : keys) k = rng() | 1;                                         // 存在的键都是奇数
+    auto ranks = zipf_samples(nkeys, 0.99, nops, rng);
+    std::vector<std::uint64_t> ops(nops);
+    for (std::size_t i = 0; i < nops; ++i) ops[i] = i % 10 == 9 ? (rng() & ~1ull) : keys[ranks[i]];
+
+    std::unordered_map<std::uint64_t, std::uint64_t> um;
+    fhm::FlatHashMap<std::uint64_t, std::uint64_t> fm;
+    um.reserve(nkeys);
+    fm.reserve(nkeys);
+    for (std::size_t i = 0; i < nkeys; ++i) {
+        um[keys[i]] = i;
+        fm[keys[i]] = i;
+    }
+    std::uint64_t h1 = 0, h2 = 0;
+    Stat l1 = measure([&] {
+        for (auto k : ops) { auto it = um.find(k); h1 += it == um.end() ? 1 : it->second; }
+    });
+    Stat l2 = measure([&] {
+        for (auto k : ops) { auto it = fm.find(k); h2 += it == fm.end() ? 1 : it->second; }
+    });
+    ok = ok && h1 == h2;
+
+    /* 频度统计（freq_list 那种“访问一次计数加一”）：从空表开始 */
+    std::unordered_map<std::uint64_t, std::uint32_t> uc;
+    fhm::FlatHashMap<std::uint64_t, std::uint32_t> fc;
+    Stat c1 = measure([&] { for (auto k : ops) ++uc[k]; });
+    Stat c2 = measure([&] { for (auto k : ops) ++fc[k]; });
+    ok = ok && uc.size() == fc.size() && uc[ops[0]] == fc[ops[0]];
+
+    std::printf("\nZipf(0.99) 混合，%zu 个键，%zu 次访问，ns/次\n", nkeys, nops);
+    std::printf("  %-28s %14s %14s\n", "", "unordered_map", "FlatHashMap");
+    std::printf("  %-28s %14.1f %14.1f\n", "查找（10% 不存在）", l1.sec * 1e9 / nops, l2.sec * 1e9 / nops);
+    std::printf("  %-28s %14.1f %14.1f\n", "计数 ++m[k]（不预留）", c1.sec * 1e9 / nops, c2.sec * 1e9 / nops);
+    std::printf("  %-28s %14zu %14zu\n", "计数时的分配次数", c1.allocs, c2.allocs);
+    std::printf("  %-28s %14s %14.1f\n", "表占用 MB（查找用的表）", "-", fm.memory_bytes() / 1048576.0);
+    std::printf("\n结果一致: %s\n", ok ? "是" : "否");
+    return ok ? 0 : 1;
+}
@@ -41,12 +41,18 @@
  *
  * 进阶：你可以想出一个时间复杂度小于 `O(n2)` 的算法吗？
  *
- * Approach: TODO
- * Time: O(?), Space: O(?)
+ * Approach: 哈希表，边扫描边查 target - nums[i] 是否出现过
+ * Time: O(n), Space: O(n)
  */
 class Solution {
 public:
     vector<int> twoSum(vector<int>& nums, int target) {
-        
+        unordered_map<int, int> seen;
+        for (int i = 0; i < (int)nums.size(); ++i) {
+            auto it = seen.find(target - nums[i]);
+            if (it != seen.end()) return {it->second, i};
+            seen[nums[i]] = i;
+        }
+        return {};
     }
 };
\ No newline at end of file
@@ -36,12 +36,21 @@
  * 	- `1 &lt;= n &lt;= 2 * 104`
  * 	- `0 &lt;= ratings[i] &lt;= 2 * 104`
  *
- * Approach: TODO
- * Time: O(?), Space: O(?)
+ * Approach: 两遍贪心，左→右满足左邻约束，右→左满足右邻约束，取两者较大值
+ * Time: O(n), Space: O(n)
  */
 class Solution {
 public:
     int candy(vector<int>& ratings) {
-        
+        int n = ratings.size();
+        vector<int> left(n, 1);
+        for (int i = 1; i < n; ++i)
+            if (ratings[i] > ratings[i - 1]) left[i] = left[i - 1] + 1;
+        int sum = left[n - 1], right = 1;
+        for (int i = n - 2; i >= 0; --i) {
+            right = ratings[i] > ratings[i + 1] ? right + 1 : 1;
+            sum += max(left[i], right);
+        }
+        return sum;
     }
 };
\ No newline at end of file
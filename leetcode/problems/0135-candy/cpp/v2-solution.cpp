@@ -0,0 +1,64 @@
+/*
+ * LeetCode 135. Candy [Hard]
+ * Link: https://leetcode.cn/problems/candy (source: leetcode.cn)
+ * Tags: Greedy, Array
+ *
+ * Problem:
+ * `n` 个孩子站成一排。给你一个整数数组 `ratings` 表示每个孩子的评分。
+ *
+ * 你需要按照以下要求，给这些孩子分发糖果：
+ *
+ * 	- 每个孩子至少分配到 `1` 个糖果。
+ * 	- 相邻两个孩子中，评分更高的那个会获得更多的糖果。
+ *
+ * 请你给每个孩子分发糖果，计算并返回需要准备的 最少糖果数目 。
+ *
+ * &nbsp;
+ *
+ * 示例&nbsp;1：
+ *
+ * 输入：ratings = [1,0,2]
+ * 输出：5
+ * 解释：你可以分别给第一个、第二个、第三个孩子分发 2、1、2 颗糖果。
+ *
+ * 示例&nbsp;2：
+ *
+ * 输入：ratings = [1,2,2]
+ * 输出：4
+ * 解释：你可以分别给第一个、第二个、第三个孩子分发 1、2、1 颗糖果。
+ *      第三个孩子只得到 1 颗糖果，这满足题面中的两个条件。
+ *
+ * &nbsp;
+ *
+ * 提示：
+ *
+ * 	- `n == ratings.length`
+ * 	- `1 &lt;= n &lt;= 2 * 104`
+ * 	- `0 &lt;= ratings[i] &lt;= 2 * 104`
+ *
+ * Approach: 一遍扫描，记录当前上坡长度 up、下坡长度 down 和坡顶高度 peak；
+ *           下坡每延长一格，整段下坡各加 1，下坡长度追上坡顶时坡顶也要加 1
+ * Time: O(n), Space: O(1)
+ */
+class Solution {
+public:
+    int candy(vector<int>& ratings) {
+        int n = ratings.size();
+        int sum = 1, up = 0, down = 0, peak = 0;
+        for (int i = 1; i < n; ++i) {
+            if (ratings[i] > ratings[i - 1]) {
+                peak = ++up;
+                down = 0;
+                sum += up + 1;
+            } else if (ratings[i] == ratings[i - 1]) {
+                up = down = peak = 0;
+                sum += 1;
+            } else {
+                up = 0;
+                ++down;
+                sum += down + (peak >= down ? 0 : 1);
+            }
+        }
+        return sum;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+ * LeetCode 135. Candy [Hard]
+ * Link: https://leetcode.cn/problems/candy (source: leetcode.cn)
+ * Tags: Greedy, Array
+ *
+ * Problem:
+ * `n` 个孩子站成一排。给你一个整数数组 `ratings` 表示每个孩子的评分。
+ *
+ * 你需要按照以下要求，给这些孩子分发糖果：
+ *
+ * 	- 每个孩子至少分配到 `1` 个糖果。
+ * 	- 相邻两个孩子中，评分更高的那个会获得更多的糖果。
+ *
+ * 请你给每个孩子分发糖果，计算并返回需要准备的 最少糖果数目 。
+ *
+ * &nbsp;
+ *
+ * 示例&nbsp;1：
+ *
+ * 输入：ratings = [1,0,2]
+ * 输出：5
+ * 解释：你可以分别给第一个、第二个、第三个孩子分发 2、1、2 颗糖果。
+ *
+ * 示例&nbsp;2：
+ *
+ * 输入：ratings = [1,2,2]
+ * 输出：4
+ * 解释：你可以分别给第一个、第二个、第三个孩子分发 1、2、1 颗糖果。
+ *      第三个孩子只得到 1 颗糖果，这满足题面中的两个条件。
+ *
+ * &nbsp;
+ *
+ * 提示：
+ *
+ * 	- `n == ratings.length`
+ * 	- `1 &lt;= n &lt;= 2 * 104`
+ * 	- `0 &lt;= ratings[i] &lt;= 2 * 104`
+ *
+ * Approach: 两遍贪心改写成两个分段扫描（左、右重置点的前缀 max / 后缀 min），
+ *           用 include/candy_scan.hpp 分 tile 多线程扫描；n 小时自动退化为单线程
+ *           （仅本地使用：提交到 OJ 时换回 v1）
+ * Time: O(n / T + T), Space: O(n / tile + T·tile)
+ */
+#include "candy_scan.hpp"
+
+class Solution {
+public:
+    int candy(vector<int>& ratings) {
+        return (int)candy::candy_parallel(ratings.data(), ratings.size());
+    }
+};
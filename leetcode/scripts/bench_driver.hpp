@@ -0,0 +1,287 @@
+/*
+ * leet.py bench 使用的 C++ 驱动：解析 LeetCode 格式的输入字面量、调用 Solution、
+ * 统计 ns/次、分配次数/字节数和峰值 RSS，结果以一行 JSON 输出给 leet.py。
+ *
+ * 不需要手写：leet.py bench 会为每个 vN-solution.cpp 生成一个入口文件，大致是
+ *
+ *     #include "bench_driver.hpp"
+ *     #define main lcb_solution_main      // 解答里自带的本地测试 main 不参与
+ *     #include ".../v1-solution.cpp"
+ *     #undef main
+ *     int main(int argc, char **argv) {
+ *         lcb::Case c(argc, argv);
+ *         auto a0 = c.arg<vector<int>>(0);
+ *         auto a1 = c.arg<int>(1);
+ *         return c.run([](auto &t) -> decltype(auto) {
+ *             Solution s;
+ *             return s.twoSum(std::get<0>(t), std::get<1>(t));
+ *         }, a0, a1);
+ *     }
+ *
+ * 用法: <binary> <用例文件> [--min-ms 200] [--unordered]
+ *   用例文件每行一个参数的字面量（与 LeetCode 自定义测试用例的格式相同）。
+ *   --unordered：返回值是 vector 时先排序再输出（题目允许“任意顺序”时用）。
+ *
+ * 分配计数来自 include/alloc_count.hpp（替换全局 operator new/delete），本头文件只能被一个翻译单元包含。
+ */
+#ifndef LEET_BENCH_DRIVER_HPP
+#define LEET_BENCH_DRIVER_HPP
+
+#include <bits/stdc++.h>
+#include <sys/resource.h>
+#include "../../include/alloc_count.hpp"
+#include "../../include/bench_util.h"
+
+using namespace std;   // LeetCode 的解答默认可以直接写 vector、string
+
+namespace lcb {
+
+[[noreturn]] inline void fail(const std::string &msg) {
+    std::fprintf(stderr, "bench_driver: %s\n", msg.c_str());
+    std::exit(2);
+}
+
+/*==================== 字面量解析 ====================*/
+struct Reader {
+    const char *p, *end;
+
+    void ws() { while (p < end && std::isspace(static_cast<unsigned char>(*p))) ++p; }
+    bool eat(char c) {
+        ws();
+        if (p < end && *p == c) { ++p; return true; }
+        return false;
+    }
+    void expect(char c) {
+        if (!eat(c)) fail(std::string("expected '") + c + "'");
+    }
+};
+
+template <class T> struct is_vector : std::false_type {};
+template <class T, class A> struct is_vector<std::vector<T, A>> : std::true_type {};
+
+template <class T>
+void parse(Reader &r, T &out) {
+    r.ws();
+    if constexpr (std::is_same_v<T, bool>) {
+        if (r.end - r.p >= 4 && !std::strncmp(r.p, "true", 4)) { out = true; r.p += 4; }
+        else if (r.end - r.p >= 5 && !std::strncmp(r.p, "false", 5)) { out = false; r.p += 5; }
+        else fail("bad bool");
+    } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, char>) {
+        auto res = std::from_chars(r.p, r.end, out);
+        if (res.ec != std::errc()) fail("bad integer");
+        r.p = res.ptr;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        char *e = nullptr;
+        out = static_cast<T>(std::strtod(r.p, &e));
+        if (e == r.p) fail("bad number");
+        r.p = e;
+    } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, char>) {
+        char q = r.p < r.end ? *r.p : 0;
+        if (q != '"' && q != '\'') fail("bad string");
+        std::string s;
+        for (++r.p; r.p < r.end && *r.p != q; ++r.p) {
+            if (*r.p == '\\' && r.p + 1 < r.end) ++r.p;
+            s.push_back(*r.p);
+        }
+        r.expect(q);
+        if constexpr (std::is_same_v<T, char>) {
+            if (s.size() != 1) fail("bad char");
+            out = s[0];
+        } else {
+            out = std::move(s);
+        }
+    } else if constexpr (is_vector<T>::value) {
+        out.clear();
+        r.expect('[');
+        if (r.eat(']')) return;
+        do {
+            typename T::value_type v{};
+            parse(r, v);
+            out.push_back(std::move(v));
+        } while (r.eat(','));
+        r.expect(']');
+    } else {
+        static_assert(sizeof(T) == 0, "unsupported parameter type");
+    }
+}
+
+/*==================== 输出与规范化 ====================*/
+template <class T>
+void format(std::string &s, const T &v) {
+    if constexpr (std::is_same_v<T, bool>) {
+        s += v ? "true" : "false";
+    } else if constexpr (std::is_same_v<T, char>) {
+        s += '"';
+        s += v;
+        s += '"';
+    } else if constexpr (std::is_integral_v<T>) {
+        char buf[32];
+        auto res = std::to_chars(buf, buf + sizeof(buf), v);
+        s.append(buf, res.ptr);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%.5f", static_cast<double>(v));   /* 与 OJ 的显示一致 */
+        s += buf;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        s += '"';
+        for (char c : v) {
+            if (c == '"' || c == '\\') s += '\\';
+            s += c;
+        }
+        s += '"';
+    } else if constexpr (is_vector<T>::value) {
+        s += '[';
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            if (i) s += ',';
+            format(s, v[i]);
+        }
+        s += ']';
+    } else {
+        static_assert(sizeof(T) == 0, "unsupported return type");
+    }
+}
+
+/* 参数的大致字节数，用来决定一批预先拷贝多少份 */
+template <class T>
+std::size_t footprint(const T &v) {
+    if constexpr (is_vector<T>::value) {
+        std::size_t n = sizeof(T);
+        for (const auto &x : v) n += footprint(x);
+        return n;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return sizeof(T) + v.size();
+    } else {
+        return sizeof(T);
+    }
+}
+
+template <class T>
+inline void keep(const T &v) {
+    asm volatile("" : : "r"(&v) : "memory");
+}
+
+inline std::uint64_t fnv1a(const std::string &s) {
+    std::uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) h = (h ^ c) * 1099511628211ull;
+    return h;
+}
+
+inline std::string json_escape(const std::string &s) {
+    std::string o;
+    for (char c : s) {
+        if (c == '"' || c == '\\') { o += '\\'; o += c; }
+        else if (static_cast<unsigned char>(c) < 0x20) o += ' ';
+        else o += c;
+    }
+    return o;
+}
+
+/* ru_maxrss 在 execve 后保留父进程（python）的峰值，Linux 上优先读 VmHWM */
+inline long peak_rss_kb() {
+    if (std::FILE *f = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        long kb = -1;
+        while (std::fgets(line, sizeof(line), f))
+            if (std::sscanf(line, "VmHWM: %ld", &kb) == 1) break;
+        std::fclose(f);
+        if (kb >= 0) return kb;
+    }
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;   /* Linux 上单位是 KB */
+}
+
+/*==================== 用例与计时 ====================*/
+class Case {
+public:
+    Case(int argc, char **argv) {
+        if (argc < 2) fail("usage: <binary> <case file> [--min-ms N] [--unordered]");
+        for (int i = 2; i < argc; ++i) {
+            std::string a = argv[i];
+            if (a == "--min-ms" && i + 1 < argc) min_ms_ = std::atof(argv[++i]);
+            else if (a == "--unordered") unordered_ = true;
+            else fail("unknown option " + a);
+        }
+        std::ifstream in(argv[1], std::ios::binary);
+        if (!in) fail(std::string("cannot open ") + argv[1]);
+        for (std::string line; std::getline(in, line);) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) lines_.push_back(std::move(line));
+        }
+    }
+
+    template <class T>
+    T arg(std::size_t i) const {
+        if (i >= lines_.size()) fail("missing argument " + std::to_string(i));
+        Reader r{lines_[i].data(), lines_[i].data() + lines_[i].size()};
+        T v{};
+        parse(r, v);
+        return v;
+    }
+
+    /*
+     * fn 接收参数元组的引用（解答可能原地修改参数，所以每次调用都给一份新拷贝）。
+     * 先调用一次取结果、分配次数和 RSS，再按批计时：一批的拷贝在计时外准备好，
+     * 取各批平均值的最小者，总时长至少 min_ms。
+     */
+    template <class Fn, class... Args>
+    int run(Fn fn, const Args &...args) {
+        using Tuple = std::tuple<Args...>;
+        std::string out;
+        std::size_t allocs, bytes;
+        {
+            Tuple t(args...);
+            std::size_t a0 = alloc_count::allocs, b0 = alloc_count::bytes;
+            decltype(auto) res = fn(t);
+            allocs = alloc_count::allocs - a0;
+            bytes = alloc_count::bytes - b0;
+            using R = std::decay_t<decltype(res)>;
+            if constexpr (is_vector<R>::value) {
+                if (unordered_) {
+                    R sorted = res;
+                    std::sort(sorted.begin(), sorted.end());
+                    format(out, sorted);
+                } else {
+                    format(out, res);
+                }
+            } else {
+                format(out, res);
+            }
+        }
+        long rss = peak_rss_kb();
+
+        std::size_t fp = 0;
+        ((fp += footprint(args)), ...);
+        std::size_t batch = std::clamp<std::size_t>((64u << 20) / (fp + 64), 1, 1024);
+        double best = 1e300, total = 0;
+        std::size_t iters = 0;
+        for (int round = 0; round < 3 || total < min_ms_ * 1e6; ++round) {
+            std::vector<Tuple> copies(batch, Tuple(args...));
+            double t0 = now_sec();
+            for (auto &t : copies) {
+                decltype(auto) res = fn(t);
+                keep(res);
+            }
+            double ns = (now_sec() - t0) * 1e9;
+            best = std::min(best, ns / static_cast<double>(batch));
+            total += ns;
+            iters += batch;
+            if (round > 10000) break;
+        }
+
+        std::printf("{\"ns\": %.1f, \"iters\": %zu, \"allocs\": %zu, \"bytes\": %zu, \"rss_kb\": %ld, "
+                    "\"hash\": \"%016llx\", \"out_len\": %zu, \"out\": \"%s\"}\n",
+                    best, iters, allocs, bytes, rss, static_cast<unsigned long long>(fnv1a(out)),
+                    out.size(), out.size() <= 256 ? json_escape(out).c_str() : "");
+        return 0;
+    }
+
+private:
+    std::vector<std::string> lines_;
+    double min_ms_ = 200;
+    bool unordered_ = false;
+};
+
+}  // namespace lcb
+
+#endif  // LEET_BENCH_DRIVER_HPP
@@ -8,16 +8,23 @@ Leet Manager (robust CN/COM, CSRF-aware)
 - Send x-csrftoken + cookies for GraphQL
 - Fallback to /api/problems/all/ when GraphQL slug lookup fails
 
-Commands: new / quick / remove / index / readme
+Commands: new / quick / remove / index / readme / bench
 """
 
 import argparse
+import concurrent.futures
 import csv
 import datetime as dt
+import hashlib
+import html
 import json
+import os
+import random
 import re
 import shutil
+import subprocess
 import sys
+import tempfile
 from pathlib import Path
 
 try:
@@ -69,6 +76,8 @@ def html_to_text(s: str) -> str:
     s = re.sub(r"</\s*p\s*>", "\n\n", s, flags=re.I)
     s = re.sub(r"<\s*li\s*>", "- ", s, flags=re.I)
     s = re.sub(r"<\s*code\s*>(.*?)</\s*code\s*>", r"`\1`", s, flags=re.I | re.S)
+    # 10<sup>4</sup> -> 10^4, otherwise it flattens to "104"
+    s = re.sub(r"<\s*sup\s*>(.*?)</\s*sup\s*>", r"^\1", s, flags=re.I | re.S)
     s = re.sub(r"<[^>]+>", "", s)
     s = re.sub(r"\r?\n\s*\r?\n\s*\r?\n+", "\n\n", s)
     return s.strip()
@@ -439,6 +448,402 @@ def cmd_remove(args):
     cmd_readme(None)
     print("[ok] removed")
 
+# ---------------------- Bench (offline judge) ----------------------
+
+BENCH_DRIVER = THIS_FILE.parent / "bench_driver.hpp"
+ALLOC_COUNT = THIS_FILE.parent.parent.parent / "include" / "alloc_count.hpp"   # #included by the driver
+BENCH_INCLUDE = ROOT / "include"          # shared headers solutions may #include (flat_hash_map.hpp, ...)
+BENCH_CACHE = ROOT / ".cache" / "bench"
+
+# C++ types the driver can parse / print (after stripping const and &)
+_BENCH_SCALARS = ("int", "long", "long long", "unsigned", "double", "float", "bool", "char", "string")
+
+def _split_top(s: str, sep: str = ",") -> list[str]:
+    """Split on sep outside of <> / [] / () and quotes."""
+    parts, depth, quote, cur = [], 0, None, []
+    for ch in s:
+        if quote:
+            cur.append(ch)
+            if ch == quote:
+                quote = None
+            continue
+        if ch in "\"'":
+            quote = ch
+        elif ch in "<[(":
+            depth += 1
+        elif ch in ">])":
+            depth -= 1
+        elif ch == sep and depth == 0:
+            parts.append("".join(cur).strip())
+            cur = []
+            continue
+        cur.append(ch)
+    if "".join(cur).strip():
+        parts.append("".join(cur).strip())
+    return parts
+
+def _bench_type(t: str) -> str:
+    t = re.sub(r"\bconst\b|&", " ", t)
+    t = re.sub(r"\bstd::", "", t)
+    return re.sub(r"\s+", " ", t).strip().replace("< ", "<").replace(" >", ">")
+
+def _bench_supported(t: str) -> bool:
+    while t.startswith("vector<") and t.endswith(">"):
+        t = t[len("vector<"):-1].strip()
+    return t in _BENCH_SCALARS
+
+def parse_cpp_signature(skeleton: str) -> dict | None:
+    """class Solution { public: RET name(PARAMS) {  ->  {ret, name, params: [(type, name)]}"""
+    m = re.search(r"class\s+Solution\s*\{.*?public:\s*(.+?)\s+(\w+)\s*\(([^)]*)\)\s*\{", skeleton or "", re.S)
+    if not m:
+        return None
+    params = []
+    for p in _split_top(m.group(3)):
+        pm = re.match(r"^(.*?)([A-Za-z_]\w*)$", p.strip())
+        if not pm:
+            return None
+        params.append((_bench_type(pm.group(1)), pm.group(2)))
+    return {"ret": _bench_type(m.group(1)), "name": m.group(2), "params": params}
+
+def _bench_text(meta: dict) -> str:
+    return html.unescape(meta.get("desc_text", "") or "").replace(" ", " ")
+
+def parse_examples(meta: dict) -> list[dict]:
+    """示例/Example blocks -> [{"args": {name: literal}, "expect": literal}]"""
+    out, cur = [], None
+    for line in _bench_text(meta).splitlines():
+        line = line.strip().replace("`", "")
+        m = re.match(r"^(输入|Input)\s*[:：]\s*(.*)$", line)
+        if m:
+            args = {}
+            for part in _split_top(m.group(2)):
+                am = re.match(r"^([A-Za-z_]\w*)\s*=\s*(.*)$", part)
+                if am:
+                    args[am.group(1)] = am.group(2).strip()
+            cur = {"args": args, "expect": None}
+            out.append(cur)
+            continue
+        m = re.match(r"^(输出|Output)\s*[:：]\s*(.*)$", line)
+        if m and cur is not None and cur["expect"] is None:
+            cur["expect"] = m.group(2).strip()
+    return [c for c in out if c["args"]]
+
+def _eval_bound(expr: str) -> float | None:
+    """'-109', '2 * 104', '10^4', '231 - 1' -> number. Flattened <sup> is undone heuristically."""
+    total = None
+    for term in re.split(r"\s*\*\s*", expr.strip()):
+        term = term.strip().replace(" ", "")
+        m = re.match(r"^(-?)(\d+)\^(\d+)(?:-(\d+))?$", term)
+        if m:
+            v = float(int(m.group(2)) ** int(m.group(3))) - int(m.group(4) or 0)
+        elif re.match(r"^-?10[1-9]$", term):                 # 10<sup>4</sup> flattened to 104
+            v = 10.0 ** int(term[-1])
+        elif re.match(r"^-?2(31|32|63)(-1)?$", term):         # 2<sup>31</sup> - 1
+            core = term.lstrip("-")
+            v = 2.0 ** int(core[1:3]) - (1 if core.endswith("-1") else 0)
+        elif re.match(r"^-?\d+(\.\d+)?$", term):
+            v = float(term)
+        else:
+            return None
+        if term.startswith("-"):
+            v = -abs(v)
+        total = v if total is None else total * v
+    return total
+
+def parse_constraints(meta: dict) -> dict:
+    """'a <= X <= b' lines -> {"nums": {"len": (lo, hi), "val": (lo, hi)}, ...}"""
+    info, alias = {}, {}
+    for line in _bench_text(meta).splitlines():
+        line = line.strip().lstrip("-").strip().replace("`", "").replace("≤", "<=")
+        m = re.match(r"^(\w+)\s*==\s*(\w+)\.length$", line)
+        if m:
+            alias[m.group(1)] = m.group(2)
+            continue
+        m = re.match(r"^(.+?)\s*<=\s*([\w.\[\]]+)\s*<=\s*(.+?)$", line)
+        if not m:
+            continue
+        lo, hi = _eval_bound(m.group(1)), _eval_bound(m.group(3))
+        if lo is None or hi is None:
+            continue
+        for target in m.group(2).split(","):
+            tm = re.match(r"^(\w+)(\.length|\[i\](?:\[j\])?|\[i\]\.length)?$", target)
+            if not tm:
+                continue
+            name, what = tm.group(1), tm.group(2) or ""
+            kind = "len" if what.endswith("length") else "val"
+            if name in alias and not what:
+                name, kind = alias[name], "len"
+            info.setdefault(name, {})[kind] = (lo, hi)
+    return info
+
+def _gen_value(t: str, spec: dict, rng: random.Random, sort: bool) -> str:
+    if t.startswith("vector<"):
+        inner = t[len("vector<"):-1].strip()
+        lo, hi = spec.get("len", (1, 10 ** 4))
+        n = int(hi)
+        items = [_gen_value(inner, {"val": spec.get("val", (0, 10 ** 4))}, rng, False) for _ in range(n)]
+        if sort and inner in ("int", "long", "long long", "unsigned", "double", "float"):
+            items.sort(key=float)
+        return "[" + ",".join(items) + "]"
+    lo, hi = spec.get("val", (0, 10 ** 4))
+    if t in ("double", "float"):
+        return f"{rng.uniform(lo, hi):.5f}"
+    if t == "bool":
+        return rng.choice(["true", "false"])
+    if t in ("string", "char"):
+        n = 1 if t == "char" else int(spec.get("len", (1, 1000))[1])
+        return '"' + "".join(rng.choice("abcdefghijklmnopqrstuvwxyz") for _ in range(n)) + '"'
+    return str(rng.randint(int(lo), int(hi)))
+
+def _gen_pair_sum(arr: dict, tgt: dict, rng: random.Random, sort: bool) -> tuple[str, str]:
+    """Two Sum style input: distinct values with exactly one pair summing to the target, at random indices."""
+    n = max(2, int(arr.get("len", (2, 10 ** 4))[1]))
+    lo, hi = (int(v) for v in arr.get("val", (0, 10 ** 4)))
+    tlo, thi = (int(v) for v in tgt.get("val", (2 * lo, 2 * hi)))
+    while True:
+        a = rng.randint(lo, hi)
+        if max(tlo, a + lo) <= min(thi, a + hi):
+            break
+    t = rng.randint(max(tlo, a + lo), min(thi, a + hi))
+    seen, rest = {a, t - a}, []
+    while len(rest) < n - 2:
+        x = rng.randint(lo, hi)
+        for _ in range(100):                                 # keep the planted pair the only answer
+            if x not in seen and t - x not in seen:
+                break
+            x = rng.randint(lo, hi)
+        seen.add(x)
+        rest.append(x)
+    i, j = sorted(rng.sample(range(n), 2))
+    rest.insert(i, a)
+    rest.insert(j, t - a)
+    if sort:
+        rest.sort()
+    return "[" + ",".join(map(str, rest)) + "]", str(t)
+
+def bench_cases(meta: dict, sig: dict, gen: bool) -> list[dict]:
+    """Examples (with expected output) + generated cases at the constraint limits."""
+    names = [n for _, n in sig["params"]]
+    cases = []
+    for i, ex in enumerate(parse_examples(meta), 1):
+        args = ex["args"]
+        vals = [args.get(n) for n in names]
+        if any(v is None for v in vals):                     # names differ: fall back to order
+            vals = list(args.values())
+        if len(vals) == len(names):
+            cases.append({"label": f"example {i}", "lines": vals, "expect": ex["expect"]})
+    if not gen:
+        return cases
+    cfg = meta.get("bench") or {}
+    if cfg.get("gen") is False:
+        return cases
+    limits = parse_constraints(meta)
+    for name, over in (cfg.get("params") or {}).items():
+        spec = limits.setdefault(name, {})
+        if "len" in over:
+            spec["len"] = (1, over["len"])
+        if "min" in over or "max" in over:
+            lo, hi = spec.get("val", (0, 10 ** 4))
+            spec["val"] = (over.get("min", lo), over.get("max", hi))
+    if not all(_bench_supported(t) for t, _ in sig["params"]):
+        return cases
+    for variant in ("random", "sorted"):
+        rng = random.Random(f"{meta.get('id')}-{variant}")   # fixed seed: same input on every run
+        lines = [_gen_value(t, limits.get(n, {}), rng, variant == "sorted") for t, n in sig["params"]]
+        pair = cfg.get("pair_sum")                           # ["nums", "target"]: plant one valid pair
+        if pair and all(p in names for p in pair):
+            ia, it = names.index(pair[0]), names.index(pair[1])
+            lines[ia], lines[it] = _gen_pair_sum(limits.get(pair[0], {}), limits.get(pair[1], {}), rng,
+                                                 variant == "sorted")
+        sizes = [str(l.count(",") + 1) for l, (t, _) in zip(lines, sig["params"]) if t.startswith("vector")]
+        label = f"gen {variant}" + (f" n={'/'.join(sizes)}" if sizes else "")
+        cases.append({"label": label, "lines": lines, "expect": None})
+    return cases
+
+def bench_glue(solution: Path, sig: dict) -> str:
+    decls, gets = [], []
+    for i, (t, _) in enumerate(sig["params"]):
+        decls.append(f"    auto a{i} = c.arg<{t}>({i});")
+        gets.append(f"std::get<{i}>(t)")
+    call = f"s.{sig['name']}({', '.join(gets)})"
+    if sig["ret"] == "void":                                 # in-place: judge the first argument
+        body = f"        {call};\n        return (std::get<0>(t));"
+    else:
+        body = f"        return {call};"
+    args = "".join(f", a{i}" for i in range(len(sig["params"])))
+    return "\n".join([
+        f'#include "{BENCH_DRIVER.as_posix()}"',
+        "#define main lcb_solution_main",
+        f'#include "{solution.resolve().as_posix()}"',
+        "#undef main",
+        "",
+        "int main(int argc, char **argv) {",
+        "    lcb::Case c(argc, argv);",
+        *decls,
+        "    return c.run([](auto &t) -> decltype(auto) {",
+        "        Solution s;",
+        body,
+        f"    }}{args});",
+        "}",
+        "",
+    ])
+
+def _bench_compile(job: tuple) -> tuple:
+    """(key, glue, solution, cxx, flags) -> (key, binary | None, error text, cache hit). Cached by content hash."""
+    key, glue, solution, cxx, flags = job
+    h = hashlib.sha256()
+    shared = [p.read_text(encoding="utf-8") for p in sorted(BENCH_INCLUDE.glob("*.h*"))]
+    for part in (" ".join([cxx, *flags]), BENCH_DRIVER.read_text(encoding="utf-8"),
+                 ALLOC_COUNT.read_text(encoding="utf-8"), *shared, glue,
+                 solution.read_text(encoding="utf-8")):
+        h.update(part.encode("utf-8"))
+        h.update(b"\0")
+    digest = h.hexdigest()[:20]
+    binary = BENCH_CACHE / (digest + (".exe" if os.name == "nt" else ""))
+    if binary.exists():
+        return key, binary, "", True
+    BENCH_CACHE.mkdir(parents=True, exist_ok=True)
+    src = BENCH_CACHE / f"{digest}.cpp"
+    src.write_text(glue, encoding="utf-8")
+    tmp = binary.with_name(binary.name + ".tmp")
+    try:
+        r = subprocess.run([cxx, *flags, str(src), "-o", str(tmp)], capture_output=True, text=True)
+    except OSError as e:
+        return key, None, str(e), False
+    if r.returncode != 0:
+        return key, None, r.stderr, False
+    os.replace(tmp, binary)                                  # atomic: parallel runs never see half a binary
+    return key, binary, "", False
+
+def _bench_normalize(lit: str | None, unordered: bool):
+    if lit is None:
+        return None
+    s = re.sub(r"\s+", "", lit)
+    try:
+        v = json.loads(s)
+    except Exception:
+        return s
+    if isinstance(v, float):
+        v = round(v, 5)
+    if unordered and isinstance(v, list):
+        v = sorted(v, key=lambda x: json.dumps(x))
+    return json.dumps(v)
+
+def _fmt_ns(ns: float) -> str:
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return f"{ns / scale:.2f} {unit}"
+    return f"{ns:.1f} ns"
+
+def _fmt_kb(kb: int) -> str:
+    return f"{kb / 1024:.1f} MB" if kb >= 1024 else f"{kb} KB"
+
+def cmd_bench(args):
+    cxx = args.cxx or os.environ.get("CXX") or "g++"
+    flags = ["-std=c++17", "-O2", "-pipe", f"-I{BENCH_INCLUDE.as_posix()}"]
+    dirs = []
+    for d in sorted(PROBLEMS.glob("*")):
+        if not d.is_dir():
+            continue
+        if args.id and not any(d.name.startswith(f"{int(i):04d}-") for i in args.id):
+            continue
+        dirs.append(d)
+    if args.clean_cache and BENCH_CACHE.exists():
+        shutil.rmtree(BENCH_CACHE)
+
+    # 1) collect problems / versions
+    plans, jobs = [], []
+    for d in dirs:
+        meta_path = d / "meta.json"
+        if not meta_path.exists():
+            continue
+        meta = json.loads(meta_path.read_text(encoding="utf-8"))
+        sig = parse_cpp_signature((meta.get("skeletons") or {}).get("cpp") or "")
+        if not sig:
+            print(f"[skip] {d.name}: no C++ skeleton in meta.json")
+            continue
+        if not all(_bench_supported(t) for t, _ in sig["params"]) or not (
+                sig["ret"] == "void" or _bench_supported(sig["ret"])):
+            print(f"[skip] {d.name}: unsupported signature {sig['ret']} {sig['name']}(...)")
+            continue
+        versions = sorted((d / "cpp").glob("v*-solution.cpp"),
+                          key=lambda p: int(re.match(r"v(\d+)", p.name).group(1)))
+        if args.versions:
+            versions = [p for p in versions if p.name.split("-")[0] in args.versions]
+        if not versions:
+            continue
+        cfg = meta.get("bench") or {}
+        unordered = cfg.get("unordered")
+        if unordered is None:
+            unordered = bool(re.search(r"任意顺序|any order", _bench_text(meta), re.I))
+        plans.append({"dir": d, "meta": meta, "sig": sig, "versions": versions, "unordered": unordered,
+                      "cases": bench_cases(meta, sig, not args.no_gen)})
+        for v in versions:
+            jobs.append(((d.name, v.name), bench_glue(v, sig), v, cxx, flags))
+
+    if not plans:
+        print("[error] nothing to bench")
+        return
+
+    # 2) compile in parallel, cached by content hash
+    binaries, cached = {}, 0
+    workers = args.jobs or os.cpu_count() or 1
+    with concurrent.futures.ThreadPoolExecutor(max_workers=workers) as ex:
+        for key, binary, err, hit in ex.map(_bench_compile, jobs):
+            binaries[key] = binary
+            cached += hit
+            if binary is None:
+                print(f"[CE] {key[0]}/{key[1]}:\n{err.strip()[:2000]}")
+    print(f"[ok] {len(jobs)} binaries ({cached} cached, {len(jobs) - cached} compiled) in {BENCH_CACHE}")
+
+    # 3) run sequentially so timings do not disturb each other
+    run_flags = ["--min-ms", str(args.min_ms)]
+    failed = False
+    with tempfile.TemporaryDirectory() as tmp:
+        for plan in plans:
+            d, sig = plan["dir"], plan["sig"]
+            vnames = [v.name.split("-")[0] for v in plan["versions"]]
+            print(f"\n== {d.name}  {sig['ret']} {sig['name']}({', '.join(t for t, _ in sig['params'])})")
+            col = 34
+            print(f"  {'case':<22}" + "".join(f"{v:<{col}}" for v in vnames))
+            for ci, case in enumerate(plan["cases"]):
+                case_file = Path(tmp) / f"{d.name}-{ci}.txt"
+                case_file.write_text("\n".join(case["lines"]) + "\n", encoding="utf-8")
+                want = _bench_normalize(case["expect"], plan["unordered"])
+                cells, first_out = [], None
+                for v in plan["versions"]:
+                    binary = binaries.get((d.name, v.name))
+                    if binary is None:
+                        cells.append("CE")
+                        failed = True
+                        continue
+                    cmd = [str(binary), str(case_file), *run_flags] + (["--unordered"] if plan["unordered"] else [])
+                    try:
+                        r = subprocess.run(cmd, capture_output=True, text=True, timeout=args.timeout)
+                        res = json.loads(r.stdout.strip().splitlines()[-1]) if r.returncode == 0 else None
+                    except subprocess.TimeoutExpired:
+                        cells.append("TLE")
+                        failed = True
+                        continue
+                    except (ValueError, IndexError):
+                        res = None
+                    if res is None:
+                        cells.append("RE")
+                        failed = True
+                        continue
+                    out = _bench_normalize(res["out"], plan["unordered"]) if res["out"] else res["hash"]
+                    if want is not None:
+                        status = "ok" if out == want else "WA"
+                    else:                                    # generated: agree with the first version?
+                        first_out = first_out or out
+                        status = "==" if out == first_out else "!="
+                    failed |= status in ("WA", "!=")
+                    cells.append(f"{status:<3}{_fmt_ns(res['ns']):>10} {res['allocs']:>7}a {_fmt_kb(res['rss_kb']):>9}")
+                print(f"  {case['label']:<22}" + "".join(f"{c:<{col}}" for c in cells))
+    print("\n(ns/call best batch average, allocations per call, peak RSS; ok/WA vs expected, ==/!= vs first version)")
+    if failed:
+        sys.exit(1)
+
 # ---------------------- CLI ----------------------
 
 def build_cli() -> argparse.ArgumentParser:
@@ -468,6 +873,17 @@ def build_cli() -> argparse.ArgumentParser:
     p_md = sub.add_parser("readme", help="rebuild README.md")
     p_md.set_defaults(func=cmd_readme)
 
+    p_b = sub.add_parser("bench", help="offline judge + benchmark of cpp/vN-solution.cpp")
+    p_b.add_argument("--id", type=int, nargs="+", help="problem ids; default: all")
+    p_b.add_argument("--versions", nargs="+", help="e.g. v1 v2; default: all")
+    p_b.add_argument("--min-ms", type=float, default=200, help="timing budget per case and version")
+    p_b.add_argument("--jobs", type=int, help="parallel compile jobs; default: cpu count")
+    p_b.add_argument("--cxx", help="compiler; default: $CXX or g++")
+    p_b.add_argument("--timeout", type=float, default=120, help="seconds per run")
+    p_b.add_argument("--no-gen", action="store_true", help="examples only, no generated large inputs")
+    p_b.add_argument("--clean-cache", action="store_true", help="drop cached binaries first")
+    p_b.set_defaults(func=cmd_bench)
+
     return p
 
 def main(argv=None):
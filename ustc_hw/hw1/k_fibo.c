@@ -1,5 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "../../include/fastio.h"
+#include "kfibo_fast.h"
 
 // 计算 k 阶斐波那契数列的第 m 项
 long long kFibo(int k, int m) {
@@ -34,12 +37,53 @@ long long kFibo(int k, int m) {
     return next;  // 返回 f_m
 }
 
-int main() {
+// 非交互模式：文件里是若干组 k m，每组输出一行 f_0 ... f_{m-1}
+// 逐项用 kFibo 是 O(m^2 k)，这里用 kfibo_fast.h 的环形缓冲一遍生成，每项 O(1)；
+// 超出 64 位后与 kFibo 一样按补码回绕
+static int runFile(const char *path) {
+    FioReader in;
+    FioWriter out;
+    int k, m, ret = 0;
+    if (fio_open(&in, path) != 0) {
+        perror(path);
+        return 1;
+    }
+    if (fio_writer_init(&out, stdout, 0) != 0) {
+        perror("malloc");
+        fio_close(&in);
+        return 1;
+    }
+    while (fio_read_int(&in, &k) == 1 && fio_read_int(&in, &m) == 1) {
+        KfIter it;
+        if (k < 1) {
+            fprintf(stderr, "invalid input\n");
+        } else if (!kf_iter_init(&it, k, 0)) {
+            perror("calloc");
+            ret = 1;
+            break;
+        } else {
+            for (int i = 0; i < m; i++) {
+                if (i) fio_put_char(&out, ' ');
+                fio_put_i64(&out, (long long)kf_iter_next(&it));
+            }
+            kf_iter_free(&it);
+        }
+        fio_put_char(&out, '\n');
+    }
+    fio_close(&in);
+    return (fio_writer_close(&out) != 0) | ret;
+}
+
+// 用法: k_fibo            交互输入 k m
+//       k_fibo -f FILE    从文件读（FILE 为 - 时读 stdin）
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "-f") == 0) return runFile(argv[2]);
+
     int k, m;
     printf("Enter k and m: ");
-    scanf("%d %d", &k, &m);
+    if (scanf("%d %d", &k, &m) != 2) return 1;
     for (int i = 0; i < m; i++) {
-        printf("%d ", kFibo(k, i));
+        printf("%lld ", kFibo(k, i));
     }
     return 0;
 }
@@ -0,0 +1,244 @@
+/*
+ * kfibo_batch.h 的正确性检查与测速（terms/s，所有序列的项数之和除以时间）
+ * - 对照：k_fibo.c 的 kFibo 逐项调用 / kfibo_fast.h 的环形缓冲逐条序列 / 批量标量 / 批量 AVX2
+ * - 两种批次：k 阶斐波那契（k 各不相同），以及带随机系数与初值的一般递推
+ * - 流式写文件：分块写入临时文件再读回核对
+ *
+ * 编译: gcc -O2 -mavx2 kfibo_batch.c -o kfibo_batch   （不加 -mavx2 则只有标量）
+ * 用法: kfibo_batch [序列条数，默认 1024] [每条项数，默认 100000]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/bench_util.h"
+#include "kfibo_batch.h"
+#include "kfibo_fast.h"
+
+/* 原实现（k_fibo.c） */
+long long kFibo(int k, int m) {
+    if (k < 1 || m < 0) {
+        fprintf(stderr, "invalid input\n");
+        return -1;
+    }
+
+    if (m < k - 1) return 0;
+    if (m == k - 1) return 1;
+
+    long long *w = (long long *)calloc(k, sizeof(long long));
+    if (!w) {
+        perror("calloc");
+        return -1;
+    }
+
+    w[k - 1] = 1;
+
+    long long next = 0;
+    for (int i = k; i <= m; i++) {
+        next = 0;
+        for (int j = 0; j < k; j++) next += w[j];
+        for (int j = 0; j < k - 1; j++) w[j] = w[j + 1];
+        w[k - 1] = next;
+    }
+
+    free(w);
+    return next;
+}
+
+static uint64_t rng_state = 88172645463325252ull;
+static uint32_t rnd(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static const uint32_t primes[] = {1000000007u, 998244353u, 2147483647u, 1000003u, 65537u, 3u};
+#define NPRIMES (sizeof(primes) / sizeof(primes[0]))
+
+/* 一般递推的朴素参考：整段放在数组里直接求和 */
+static uint32_t *naive_general(const KbSpec *s, size_t m) {
+    uint32_t *f = (uint32_t *)malloc(m * sizeof(uint32_t));
+    for (size_t i = 0; i < m; ++i) {
+        if (i < (size_t)s->k) {
+            f[i] = s->init ? s->init[i] % s->mod : (uint32_t)(i == (size_t)s->k - 1);
+            continue;
+        }
+        uint64_t acc = 0;
+        for (int t = 1; t <= s->k; ++t) acc = (acc + (uint64_t)(s->coef ? s->coef[t - 1] : 1) * f[i - t]) % s->mod;
+        f[i] = (uint32_t)acc;
+    }
+    return f;
+}
+
+static bool check(void) {
+    bool ok = true;
+    for (int round = 0; round < 2; ++round) {
+        size_t n = 37;                               /* 不是 8 的倍数，覆盖补齐的列 */
+        KbSpec spec[37];
+        uint32_t *coef[37] = {0}, *init[37] = {0};
+        for (size_t j = 0; j < n; ++j) {
+            int k = 1 + (int)(rnd() % 40);
+            uint32_t p = primes[rnd() % NPRIMES];
+            if (round == 1 && j % 3) {
+                coef[j] = (uint32_t *)malloc((size_t)k * sizeof(uint32_t));
+                init[j] = (uint32_t *)malloc((size_t)k * sizeof(uint32_t));
+                for (int t = 0; t < k; ++t) { coef[j][t] = rnd(); init[j][t] = rnd(); }
+            } else if (round == 0 && j % 5 == 0) {
+                p = 2 + rnd() % 1000;                /* 全 1 系数允许偶数模数 */
+            }
+            spec[j] = (KbSpec){k, p, coef[j], init[j]};
+        }
+        size_t m = 3000;
+        KBatch b;
+        uint32_t *out = (uint32_t *)malloc(m * n * sizeof(uint32_t));
+        for (int simd = 0; simd < 2; ++simd) {
+            if (!kb_init(&b, spec, n)) { printf("kb_init 失败\n"); return false; }
+            b.simd = simd;
+            kb_generate(&b, out, 1000);              /* 分两次调用，检查流式衔接 */
+            kb_generate(&b, out + 1000 * n, m - 1000);
+            kb_free(&b);
+            for (size_t j = 0; j < n; ++j) {
+                uint32_t *ref = naive_general(&spec[j], m);
+                for (size_t i = 0; i < m; ++i) {
+                    if (out[i * n + j] != ref[i]) {
+                        printf("第 %zu 条序列第 %zu 项不一致（round %d, simd %d）\n", j, i, round, simd);
+                        ok = false;
+                        break;
+                    }
+                }
+                free(ref);
+            }
+        }
+        /* 全 1 系数、缺省初值时还要与 kFibo 本身对上（不溢出的范围） */
+        if (round == 0) {
+            for (size_t j = 0; j < n; ++j)
+                for (int i = 0; i < 50; ++i)
+                    ok &= out[(size_t)i * n + j] == (uint32_t)((unsigned long long)kFibo(spec[j].k, i) % spec[j].mod);
+        }
+        free(out);
+        for (size_t j = 0; j < n; ++j) { free(coef[j]); free(init[j]); }
+    }
+
+    /* 写文件再读回 */
+    KbSpec spec[5] = {{2, 1000000007u, NULL, NULL}, {3, 97u, NULL, NULL}, {7, 65537u, NULL, NULL},
+                      {10, 1000003u, NULL, NULL}, {1, 5u, NULL, NULL}};
+    KBatch b, c;
+    FILE *fp = tmpfile();
+    if (!fp || !kb_init(&b, spec, 5) || !kb_init(&c, spec, 5)) return false;
+    ok &= kb_generate_file(&b, fp, 10007, 1000) == 10007;
+    rewind(fp);
+    uint32_t row[5], want[5];
+    for (int i = 0; i < 10007; ++i) {
+        kb_generate(&c, want, 1);
+        ok &= fread(row, sizeof(row), 1, fp) == 1 && memcmp(row, want, sizeof(row)) == 0;
+    }
+    fclose(fp);
+    kb_free(&b);
+    kb_free(&c);
+    return ok;
+}
+
+static void make_specs(KbSpec *spec, uint32_t **coef, size_t n, int kmax, bool general) {
+    for (size_t j = 0; j < n; ++j) {
+        int k = 2 + (int)(rnd() % (uint32_t)(kmax - 1));
+        coef[j] = NULL;
+        if (general) {
+            coef[j] = (uint32_t *)malloc((size_t)k * sizeof(uint32_t));
+            for (int t = 0; t < k; ++t) coef[j][t] = rnd();
+        }
+        spec[j] = (KbSpec){k, primes[j % 3], coef[j], NULL};
+    }
+}
+
+/* 生成 n 条序列各 m 项，流式写进一块 chunk 行的缓冲，返回 terms/s */
+static double bench_batch(const KbSpec *spec, size_t n, size_t m, bool simd, uint32_t *chunk, size_t chunk_terms) {
+    KBatch b;
+    if (!kb_init(&b, spec, n)) return 0;
+    b.simd = simd;
+    double t0 = now_sec();
+    for (size_t done = 0; done < m; done += chunk_terms)
+        kb_generate(&b, chunk, m - done < chunk_terms ? m - done : chunk_terms);
+    double t = now_sec() - t0;
+    kb_free(&b);
+    return (double)n * (double)m / t;
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1024;
+    size_t m = argc > 2 ? strtoull(argv[2], NULL, 10) : 100000;
+    if (n == 0 || m == 0) return 1;
+
+    bool ok = check();
+    printf("正确性检查: %s\n\n", ok ? "通过" : "失败");
+
+#ifdef __AVX2__
+    const char *isa = "AVX2";
+#else
+    const char *isa = "标量（未加 -mavx2）";
+#endif
+    size_t chunk_terms = 256;
+    uint32_t *chunk = (uint32_t *)malloc(chunk_terms * n * sizeof(uint32_t));
+    KbSpec *spec = (KbSpec *)malloc(n * sizeof(KbSpec));
+    uint32_t **coef = (uint32_t **)malloc(n * sizeof(uint32_t *));
+    if (!chunk || !spec || !coef) return 1;
+
+    printf("%zu 条序列 × %zu 项，批量内核: %s，单位 Mterms/s\n", n, m, isa);
+    printf("  批次                 kFibo逐项   环形缓冲逐条   批量标量   批量SIMD\n");
+    const int kmaxs[] = {8, 64, 1000};
+    for (int g = 0; g < 2; ++g) {
+        for (size_t q = 0; q < sizeof(kmaxs) / sizeof(kmaxs[0]); ++q) {
+            int kmax = kmaxs[q];
+            if (g == 1 && kmax > 64) continue;       /* 一般递推每项 O(kmax)，大 k 没有意义 */
+            make_specs(spec, coef, n, kmax, g == 1);
+
+            /* kFibo 每项 O(m·k)，只测前 2000 项、前 16 条序列 */
+            double r_old = 0;
+            if (g == 0) {
+                volatile long long sink = 0;
+                size_t nn = n < 16 ? n : 16, mm = 2000;
+                double t0 = now_sec();
+                for (size_t j = 0; j < nn; ++j)
+                    for (size_t i = 0; i < mm; ++i) sink += kFibo(spec[j].k, (int)i) % spec[j].mod;
+                r_old = (double)(nn * mm) / (now_sec() - t0);
+                (void)sink;
+            }
+            double r_iter = 0;
+            if (g == 0) {
+                volatile uint64_t sink = 0;
+                double t0 = now_sec();
+                for (size_t j = 0; j < n; ++j) {
+                    KfIter it;
+                    if (!kf_iter_init(&it, spec[j].k, spec[j].mod)) return 1;
+                    for (size_t i = 0; i < m; ++i) sink += kf_iter_next(&it);
+                    kf_iter_free(&it);
+                }
+                r_iter = (double)(n * m) / (now_sec() - t0);
+                (void)sink;
+            }
+            double r_sc = bench_batch(spec, n, m, false, chunk, chunk_terms);
+            double r_simd = bench_batch(spec, n, m, true, chunk, chunk_terms);
+            char name[64];
+            snprintf(name, sizeof(name), "%s k<=%d", g ? "一般系数" : "k阶斐波那契", kmax);
+            if (g == 0) printf("  %-22s %9.3f %12.1f %10.1f %10.1f\n", name, r_old / 1e6, r_iter / 1e6, r_sc / 1e6, r_simd / 1e6);
+            else printf("  %-22s %9s %12s %10.1f %10.1f\n", name, "-", "-", r_sc / 1e6, r_simd / 1e6);
+            for (size_t j = 0; j < n; ++j) free(coef[j]);
+        }
+    }
+
+    /* 流式写文件：只占环形缓冲和一块输出 */
+    make_specs(spec, coef, n, 64, false);
+    KBatch b;
+    FILE *fp = fopen("/dev/null", "wb");
+    if (fp && kb_init(&b, spec, n)) {
+        double t0 = now_sec();
+        size_t w = kb_generate_file(&b, fp, m, chunk_terms);
+        double t = now_sec() - t0;
+        printf("\n写文件（/dev/null，每块 %zu 行）: %.1f Mterms/s\n", chunk_terms, (double)w * n / t / 1e6);
+        kb_free(&b);
+    }
+    if (fp) fclose(fp);
+    free(chunk);
+    free(spec);
+    free(coef);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+/*
+ * 批量生成多条 k 阶线性递推序列（kFibo 家族），SoA 布局 + AVX2，header-only
+ *
+ * 每条序列有自己的 k、模数、系数和初值：
+ *     f_i = c_1 f_{i-1} + ... + c_k f_{i-k}  (mod p)，i >= k
+ * 系数缺省为全 1（即 k 阶斐波那契），初值缺省为 0, ..., 0, 1。
+ *
+ * 历史值按 SoA 存放：环形缓冲的每一行是“同一项号、所有序列”，一行 lanes 个 uint32，
+ * 一个 AVX2 寄存器一次推进 8 条序列。两条内核：
+ * - 所有序列都是全 1 系数时：f_i = 2 f_{i-1} - f_{i-1-k}（见 kfibo_fast.h），每项 O(1)。
+ *   各序列的 k 不同，f_{i-1-k} 落在不同的行上，用 gather 取；取模只需加减后一次条件减，
+ *   用 min_epu32(x, x - p) 无分支完成（要求 p < 2^31）
+ * - 一般系数：每项 O(kmax) 次模乘。乘法用 Montgomery 约减（R = 2^32）：_mm256_mul_epu32
+ *   直接给出 32×32→64 的乘积，约减只要低半部分的乘法，比 Barrett 少一次高位乘；
+ *   系数预先转成 Montgomery 形式，mont(cR, f) = c·f，历史值保持普通形式。要求 p 为奇数
+ * 递推在前 kmax 项内各序列还处于初值阶段，这部分逐条序列用标量代码算。
+ *
+ * 输出按项号流式给出：kb_generate 每次写 nterms 行（out[t * n + j] 为第 j 条序列的
+ * 第 b->i + t 项），kb_generate_file 分块写二进制文件，内存占用只有环形缓冲与一块输出。
+ * 不加 -mavx2 编译时走等价的标量循环。
+ */
+#ifndef KFIBO_BATCH_H
+#define KFIBO_BATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#define KB_ALIGN 64
+#define KB_VEC 8                /* 一个 AVX2 寄存器的 uint32 个数，lanes 按它补齐 */
+
+typedef struct {
+    int k;
+    uint32_t mod;               /* 2 <= mod < 2^31；批次里有序列带系数时须为奇数 */
+    const uint32_t *coef;       /* c_1..c_k；NULL 表示全 1 */
+    const uint32_t *init;       /* f_0..f_{k-1}；NULL 表示 0, ..., 0, 1 */
+} KbSpec;
+
+typedef struct {
+    size_t n, lanes;            /* 序列条数；补齐到 KB_VEC 的倍数后的列数 */
+    int kmax;
+    size_t rows;                /* 环形缓冲行数，2 的幂，>= kmax + 2 */
+    bool general;               /* 有任一序列带系数 */
+    bool simd;                  /* 可以清掉，强制走标量循环（测速用） */
+    uint32_t *k, *mod, *pinv;   /* 每列的 k、模数、-p^{-1} mod 2^32 */
+    int32_t *koff;              /* 每列 k * lanes，gather 下标用 */
+    uint32_t *coef;             /* general：kmax 行 × lanes，第 t-1 行是 c_t（Montgomery 形式） */
+    uint32_t *init;             /* kmax 行 × lanes */
+    uint32_t *hist;             /* rows 行 × lanes */
+    uint64_t i;                 /* 下一个要生成的项号 */
+} KBatch;
+
+static inline void *kb_aligned_alloc(size_t bytes) {
+    if (bytes == 0) bytes = KB_ALIGN;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, KB_ALIGN);
+#else
+    void *p = NULL;
+    return posix_memalign(&p, KB_ALIGN, bytes) == 0 ? p : NULL;
+#endif
+}
+
+static inline void kb_aligned_free(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+static inline void *kb_aligned_calloc(size_t n, size_t size) {
+    if (size && n > SIZE_MAX / size) return NULL;
+    void *p = kb_aligned_alloc(n * size);
+    if (p) memset(p, 0, n * size);
+    return p;
+}
+
+static inline void kb_free(KBatch *b) {
+    kb_aligned_free(b->k);
+    kb_aligned_free(b->mod);
+    kb_aligned_free(b->pinv);
+    kb_aligned_free(b->koff);
+    kb_aligned_free(b->coef);
+    kb_aligned_free(b->init);
+    kb_aligned_free(b->hist);
+    memset(b, 0, sizeof(*b));
+}
+
+/* 参数不合法或内存不足返回 false */
+static inline bool kb_init(KBatch *b, const KbSpec *spec, size_t n) {
+    memset(b, 0, sizeof(*b));
+    if (n == 0) return false;
+    int kmax = 1;
+    for (size_t j = 0; j < n; ++j) {
+        if (spec[j].k < 1 || spec[j].mod < 2 || spec[j].mod >= 0x80000000u) return false;
+        if (spec[j].k > kmax) kmax = spec[j].k;
+        b->general |= spec[j].coef != NULL;
+    }
+    for (size_t j = 0; b->general && j < n; ++j)
+        if (!(spec[j].mod & 1)) return false;           /* Montgomery 需要奇模数 */
+    size_t lanes = (n + KB_VEC - 1) / KB_VEC * KB_VEC;
+    size_t rows = 1;
+    while (rows < (size_t)kmax + 2) rows <<= 1;
+    if (rows > INT32_MAX / lanes) return false;      /* gather 下标是 int32 */
+
+    b->n = n;
+    b->lanes = lanes;
+    b->kmax = kmax;
+    b->rows = rows;
+    b->simd = true;
+    b->k = (uint32_t *)kb_aligned_calloc(lanes, sizeof(uint32_t));
+    b->mod = (uint32_t *)kb_aligned_calloc(lanes, sizeof(uint32_t));
+    b->pinv = (uint32_t *)kb_aligned_calloc(lanes, sizeof(uint32_t));
+    b->koff = (int32_t *)kb_aligned_calloc(lanes, sizeof(int32_t));
+    b->init = (uint32_t *)kb_aligned_calloc((size_t)kmax * lanes, sizeof(uint32_t));
+    b->hist = (uint32_t *)kb_aligned_calloc(rows * lanes, sizeof(uint32_t));
+    if (b->general) b->coef = (uint32_t *)kb_aligned_calloc((size_t)kmax * lanes, sizeof(uint32_t));
+    if (!b->k || !b->mod || !b->pinv || !b->koff || !b->init || !b->hist || (b->general && !b->coef)) {
+        kb_free(b);
+        return false;
+    }
+
+    for (size_t j = 0; j < lanes; ++j) {
+        /* 补齐的列：k = 1、模 3 的常数序列，只为让内核不用处理尾巴 */
+        KbSpec s = j < n ? spec[j] : (KbSpec){1, 3, NULL, NULL};
+        uint32_t p = s.mod;
+        b->k[j] = (uint32_t)s.k;
+        b->mod[j] = p;
+        b->koff[j] = (int32_t)((size_t)s.k * lanes);
+        if (p & 1) {
+            uint32_t inv = p;                       /* 牛顿迭代求 p^{-1} mod 2^32 */
+            for (int t = 0; t < 5; ++t) inv *= 2 - p * inv;
+            b->pinv[j] = 0u - inv;
+        }
+        for (int t = 0; t < s.k; ++t)
+            b->init[(size_t)t * lanes + j] = s.init ? s.init[t] % p : (uint32_t)(t == s.k - 1);
+        if (b->general) {
+            /* 全 1 系数的序列在一般内核里也要显式写出系数；超过 k 的部分保持 0 */
+            for (int t = 0; t < s.k; ++t) {
+                uint64_t c = s.coef ? s.coef[t] % p : 1;
+                b->coef[(size_t)t * lanes + j] = (uint32_t)((c << 32) % p);
+            }
+        }
+    }
+    return true;
+}
+
+/*==================== 标量部分 ====================*/
+static inline uint32_t *kb_row(const KBatch *b, uint64_t i) {
+    return b->hist + (size_t)(i & (b->rows - 1)) * b->lanes;
+}
+
+/* 第 j 列的第 i 项，历史取自环形缓冲；处理初值阶段，也用作标量内核的参考 */
+static inline uint32_t kb_term_scalar(const KBatch *b, size_t j, uint64_t i) {
+    uint64_t k = b->k[j], p = b->mod[j];
+    size_t L = b->lanes;
+    if (i < k) return b->init[(size_t)i * L + j];
+    if (b->general) {
+        uint64_t acc = 0;
+        for (uint64_t t = 1; t <= k; ++t) {
+            /* 系数是 Montgomery 形式，一次 REDC 即得 c·f mod p */
+            uint64_t c = b->coef[(size_t)(t - 1) * L + j];
+            uint64_t prod = c * kb_row(b, i - t)[j];
+            uint32_t m = (uint32_t)prod * b->pinv[j];
+            uint64_t r = (prod + (uint64_t)m * p) >> 32;
+            acc += r >= p ? r - p : r;
+        }
+        return (uint32_t)(acc % p);
+    }
+    if (i == k) {
+        uint64_t s = 0;
+        for (uint64_t t = 1; t <= k; ++t) s += kb_row(b, i - t)[j];
+        return (uint32_t)(s % p);
+    }
+    return (uint32_t)((2 * (uint64_t)kb_row(b, i - 1)[j] + p - kb_row(b, i - 1 - k)[j]) % p);
+}
+
+/* 稳态（i > kmax）一行的标量版本：与 AVX2 内核逐条对应，编译器也可以自动向量化一部分 */
+static inline void kb_row_scalar(KBatch *b, uint64_t i) {
+    size_t L = b->lanes;
+    uint32_t *dst = kb_row(b, i);
+    if (!b->general) {
+        const uint32_t *prev = kb_row(b, i - 1);
+        for (size_t j = 0; j < L; ++j) {
+            uint32_t p = b->mod[j];
+            uint32_t t = prev[j] + prev[j];
+            t = t >= p ? t - p : t;
+            uint32_t old = kb_row(b, i - 1 - b->k[j])[j];
+            dst[j] = t >= old ? t - old : t + p - old;
+        }
+        return;
+    }
+    for (size_t j = 0; j < L; ++j) dst[j] = 0;
+    for (int t = 1; t <= b->kmax; ++t) {
+        const uint32_t *h = kb_row(b, i - (uint64_t)t), *c = b->coef + (size_t)(t - 1) * L;
+        for (size_t j = 0; j < L; ++j) {
+            uint32_t p = b->mod[j];
+            uint64_t prod = (uint64_t)c[j] * h[j];
+            uint32_t m = (uint32_t)prod * b->pinv[j];
+            uint32_t r = (uint32_t)((prod + (uint64_t)m * p) >> 32);
+            r = r >= p ? r - p : r;
+            uint32_t s = dst[j] + r;
+            dst[j] = s >= p ? s - p : s;
+        }
+    }
+}
+
+/*==================== AVX2 内核 ====================*/
+#ifdef __AVX2__
+/* a, b < p < 2^31：无符号 min 选出落在 [0, p) 的那个 */
+static inline __m256i kb_addmod(__m256i a, __m256i b, __m256i p) {
+    __m256i s = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(s, _mm256_sub_epi32(s, p));
+}
+
+static inline __m256i kb_submod(__m256i a, __m256i b, __m256i p) {
+    __m256i d = _mm256_sub_epi32(a, b);
+    return _mm256_min_epu32(d, _mm256_add_epi32(d, p));
+}
+
+/* Montgomery 乘：a·b·2^{-32} mod p，a, b < p。偶数、奇数下标的 32 位元素分两路做 64 位乘 */
+static inline __m256i kb_montmul(__m256i a, __m256i b, __m256i p, __m256i pinv) {
+    __m256i p_hi = _mm256_srli_epi64(p, 32);
+    __m256i t0 = _mm256_mul_epu32(a, b);
+    __m256i t1 = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i m0 = _mm256_mul_epu32(t0, pinv);
+    __m256i m1 = _mm256_mul_epu32(t1, _mm256_srli_epi64(pinv, 32));
+    __m256i u0 = _mm256_add_epi64(t0, _mm256_mul_epu32(m0, p));
+    __m256i u1 = _mm256_add_epi64(t1, _mm256_mul_epu32(m1, p_hi));
+    __m256i r = _mm256_blend_epi32(_mm256_srli_epi64(u0, 32), u1, 0xAA);
+    return _mm256_min_epu32(r, _mm256_sub_epi32(r, p));
+}
+
+static inline void kb_row_avx2(KBatch *b, uint64_t i) {
+    size_t L = b->lanes;
+    uint32_t *dst = kb_row(b, i);
+    if (!b->general) {
+        const uint32_t *prev = kb_row(b, i - 1);
+        const __m256i total = _mm256_set1_epi32((int)(b->rows * L));
+        const __m256i step = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        /* f_{i-1-k} 在 hist 中的下标 = (i-1 行的起点) - k·L + j，为负时绕回 */
+        __m256i base = _mm256_add_epi32(_mm256_set1_epi32((int)(prev - b->hist)), step);
+        for (size_t j = 0; j < L; j += KB_VEC) {
+            __m256i p = _mm256_loadu_si256((const __m256i *)(b->mod + j));
+            __m256i last = _mm256_loadu_si256((const __m256i *)(prev + j));
+            __m256i idx = _mm256_sub_epi32(base, _mm256_loadu_si256((const __m256i *)(b->koff + j)));
+            idx = _mm256_add_epi32(idx, _mm256_and_si256(_mm256_srai_epi32(idx, 31), total));
+            __m256i old = _mm256_i32gather_epi32((const int *)b->hist, idx, 4);
+            __m256i v = kb_submod(kb_addmod(last, last, p), old, p);
+            _mm256_storeu_si256((__m256i *)(dst + j), v);
+            base = _mm256_add_epi32(base, _mm256_set1_epi32(KB_VEC));
+        }
+        return;
+    }
+    for (size_t j = 0; j < L; j += KB_VEC) {
+        __m256i p = _mm256_loadu_si256((const __m256i *)(b->mod + j));
+        __m256i pinv = _mm256_loadu_si256((const __m256i *)(b->pinv + j));
+        __m256i acc = _mm256_setzero_si256();
+        for (int t = 1; t <= b->kmax; ++t) {
+            __m256i h = _mm256_loadu_si256((const __m256i *)(kb_row(b, i - (uint64_t)t) + j));
+            __m256i c = _mm256_loadu_si256((const __m256i *)(b->coef + (size_t)(t - 1) * L + j));
+            acc = kb_addmod(acc, kb_montmul(c, h, p, pinv), p);
+        }
+        _mm256_storeu_si256((__m256i *)(dst + j), acc);
+    }
+}
+#endif
+
+/*==================== 对外接口 ====================*/
+/* 生成第 b->i 项（所有序列）到环形缓冲，返回该行 */
+static inline const uint32_t *kb_next_row(KBatch *b) {
+    uint64_t i = b->i++;
+    if (i <= (uint64_t)b->kmax) {
+        uint32_t *dst = kb_row(b, i);
+        for (size_t j = 0; j < b->lanes; ++j) dst[j] = kb_term_scalar(b, j, i);
+        return dst;
+    }
+#ifdef __AVX2__
+    if (b->simd) {
+        kb_row_avx2(b, i);
+        return kb_row(b, i);
+    }
+#endif
+    kb_row_scalar(b, i);
+    return kb_row(b, i);
+}
+
+/* 接着生成 nterms 项，out[t * n + j] 为第 j 条序列的第 (调用前的 b->i) + t 项 */
+static inline void kb_generate(KBatch *b, uint32_t *out, size_t nterms) {
+    for (size_t t = 0; t < nterms; ++t) memcpy(out + t * b->n, kb_next_row(b), b->n * sizeof(uint32_t));
+}
+
+/*
+ * 接着生成 nterms 项写入 fp（二进制，本机字节序，布局同 kb_generate），
+ * 每次缓冲 chunk_terms 行。返回成功写出的项数（行数），出错时小于 nterms。
+ */
+static inline size_t kb_generate_file(KBatch *b, FILE *fp, size_t nterms, size_t chunk_terms) {
+    if (chunk_terms == 0) chunk_terms = 1;
+    uint32_t *buf = (uint32_t *)malloc(chunk_terms * b->n * sizeof(uint32_t));
+    if (!buf) return 0;
+    size_t done = 0;
+    while (done < nterms) {
+        size_t c = nterms - done < chunk_terms ? nterms - done : chunk_terms;
+        kb_generate(b, buf, c);
+        if (fwrite(buf, sizeof(uint32_t) * b->n, c, fp) != c) break;
+        done += c;
+    }
+    free(buf);
+    return done;
+}
+
+#endif /* KFIBO_BATCH_H */
@@ -0,0 +1,187 @@
+/*
+ * kfibo_fast.h 的演示、正确性检查与测速
+ * - 与 k_fibo.c 相同的交互：输入 k、m，输出前 m 项（环形缓冲，O(m)）
+ * - 环形缓冲 / 伴随矩阵 / Kitamasa / 大整数 与原 kFibo 交叉比对
+ * - 单项 f_m（m = 10^18）的耗时随 k 的变化，整段输出与原 main 的对比
+ *
+ * 编译: gcc -O2 kfibo_fast.c -o kfibo_fast
+ * 用法: kfibo_fast          交互模式，同 k_fibo.c
+ *       kfibo_fast bench    正确性检查 + 测速
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/bench_util.h"
+#include "kfibo_fast.h"
+
+#define MOD 1000000007u
+
+/* 原实现（k_fibo.c），作为基准 */
+long long kFibo(int k, int m) {
+    if (k < 1 || m < 0) {
+        fprintf(stderr, "invalid input\n");
+        return -1;
+    }
+
+    if (m < k - 1) return 0;
+    if (m == k - 1) return 1;
+
+    long long *w = (long long *)calloc(k, sizeof(long long));
+    if (!w) {
+        perror("calloc");
+        return -1;
+    }
+
+    w[k - 1] = 1;
+
+    long long next = 0;
+    for (int i = k; i <= m; i++) {
+        next = 0;
+        for (int j = 0; j < k; j++) next += w[j];
+        for (int j = 0; j < k - 1; j++) w[j] = w[j + 1];
+        w[k - 1] = next;
+    }
+
+    free(w);
+    return next;
+}
+
+static bool check(void) {
+    bool ok = true;
+    /* 不溢出的范围内与 kFibo 逐项比对 */
+    for (int k = 1; k <= 12; ++k) {
+        KfIter it, it_raw;
+        if (!kf_iter_init(&it, k, MOD)) return false;
+        if (!kf_iter_init(&it_raw, k, 0)) { kf_iter_free(&it); return false; }
+        for (int m = 0; m < 60; ++m) {
+            long long ref = kFibo(k, m);
+            uint64_t a = kf_iter_next(&it), raw = kf_iter_next(&it_raw);
+            uint32_t b = kf_term_matrix(k, (uint64_t)m, MOD);
+            uint32_t c = kf_term_kitamasa(k, (uint64_t)m, MOD);
+            KfBig big = {0};
+            kf_term_big(k, (uint64_t)m, &big);
+            uint64_t r = (uint64_t)ref % MOD;
+            if (raw != (uint64_t)ref || a != r || b != r || c != r || kf_big_mod(&big, MOD) != r) {
+                printf("k=%d m=%d 不一致: ref=%lld iter=%llu matrix=%u kitamasa=%u\n", k, m, ref,
+                       (unsigned long long)a, b, c);
+                ok = false;
+            }
+            kf_big_free(&big);
+        }
+        kf_iter_free(&it);
+        kf_iter_free(&it_raw);
+    }
+    /* 大 m：各方法之间互相比对，覆盖 NTT 路径与其他模数 */
+    const uint32_t mods[] = {MOD, 998244353u, 2147483647u, 2u};
+    const int ks[] = {2, 5, 63, 64, 100, 300};
+    for (size_t a = 0; a < sizeof(mods) / sizeof(mods[0]); ++a) {
+        for (size_t b = 0; b < sizeof(ks) / sizeof(ks[0]); ++b) {
+            int k = ks[b];
+            uint64_t m = 20000 + (uint64_t)k * 7;
+            KfIter it;
+            if (!kf_iter_init(&it, k, mods[a])) return false;
+            uint64_t v = 0;
+            for (uint64_t i = 0; i <= m; ++i) v = kf_iter_next(&it);
+            kf_iter_free(&it);
+            uint32_t c = kf_term_kitamasa(k, m, mods[a]);
+            uint32_t d = k <= 64 ? kf_term_matrix(k, m, mods[a]) : (uint32_t)v;
+            if (c != v || d != v) {
+                printf("k=%d m=%llu mod=%u 不一致: iter=%llu matrix=%u kitamasa=%u\n", k,
+                       (unsigned long long)m, mods[a], (unsigned long long)v, d, c);
+                ok = false;
+            }
+        }
+    }
+    /* 大整数：斐波那契数 F(1000) 的前几位已知，另与取模结果核对 */
+    KfBig big = {0};
+    kf_term_big(2, 1000, &big);
+    char *s = kf_big_to_dec(&big);
+    ok &= s && strncmp(s, "43466557686937456435688527675040625802564660517371780402481729", 62) == 0;
+    ok &= kf_big_mod(&big, MOD) == kf_term_kitamasa(2, 1000, MOD);
+    free(s);
+    kf_big_free(&big);
+    return ok;
+}
+
+static void bench(void) {
+    const uint64_t m = 1000000000000000000ull;
+    printf("单项 f_m mod 1e9+7，m = 1e18，单位 ms\n");
+    printf("     k      伴随矩阵    Kitamasa\n");
+    const int ks[] = {2, 10, 50, 100, 1000, 10000, 100000};
+    for (size_t i = 0; i < sizeof(ks) / sizeof(ks[0]); ++i) {
+        int k = ks[i];
+        double tm = -1, tk;
+        uint32_t a = 0, b;
+        if (k <= 100) {
+            double t0 = now_sec();
+            a = kf_term_matrix(k, m, MOD);
+            tm = (now_sec() - t0) * 1e3;
+        }
+        double t0 = now_sec();
+        b = kf_term_kitamasa(k, m, MOD);
+        tk = (now_sec() - t0) * 1e3;
+        if (tm >= 0) printf("%8d  %11.3f %11.3f%s\n", k, tm, tk, a == b ? "" : "  不一致!");
+        else printf("%8d  %11s %11.3f\n", k, "-", tk);
+    }
+
+    printf("\n整段输出前 m 项（k = 10），单位 ms\n");
+    printf("       m     原 main(kFibo 逐项)   环形缓冲\n");
+    for (int n = 1000; n <= 100000000; n *= 10) {
+        double t_old = -1;
+        volatile long long sink = 0;
+        if (n <= 10000) {
+            double t0 = now_sec();
+            for (int i = 0; i < n; ++i) sink += kFibo(10, i);
+            t_old = (now_sec() - t0) * 1e3;
+        }
+        double t0 = now_sec();
+        KfIter it;
+        if (!kf_iter_init(&it, 10, MOD)) return;
+        for (int i = 0; i < n; ++i) sink += (long long)kf_iter_next(&it);
+        kf_iter_free(&it);
+        double t_new = (now_sec() - t0) * 1e3;
+        if (t_old >= 0) printf("%10d  %18.3f  %10.3f\n", n, t_old, t_new);
+        else printf("%10d  %18s  %10.3f\n", n, "-", t_new);
+        (void)sink;
+    }
+
+    printf("\n精确值（大整数，环形缓冲）\n");
+    const int bk[] = {2, 10, 100};
+    for (size_t i = 0; i < sizeof(bk) / sizeof(bk[0]); ++i) {
+        KfBig big = {0};
+        double t0 = now_sec();
+        kf_term_big(bk[i], 100000, &big);
+        double t1 = now_sec();
+        char *s = kf_big_to_dec(&big);
+        printf("k=%-4d f_100000 共 %zu 位，前 20 位 %.20s，计算 %.1f ms\n", bk[i], s ? strlen(s) : 0,
+               s ? s : "", (t1 - t0) * 1e3);
+        free(s);
+        kf_big_free(&big);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        bool ok = check();
+        printf("正确性检查: %s\n\n", ok ? "通过" : "失败");
+        bench();
+        return ok ? 0 : 1;
+    }
+
+    int k, m;
+    printf("Enter k and m: ");
+    if (scanf("%d %d", &k, &m) != 2 || k < 1 || m < 0) {
+        fprintf(stderr, "invalid input\n");
+        return 1;
+    }
+    /* 前 m 项只走一遍环形缓冲；超出 64 位后按无符号自然回绕，需要精确值用 kf_term_big */
+    KfIter it;
+    if (!kf_iter_init(&it, k, 0)) {
+        perror("calloc");
+        return 1;
+    }
+    for (int i = 0; i < m; i++) printf("%llu ", (unsigned long long)kf_iter_next(&it));
+    printf("\n");
+    kf_iter_free(&it);
+    return 0;
+}
@@ -0,0 +1,374 @@
+/*
+ * k 阶斐波那契数列的快速计算（fibonacci.c 的 k_fibo、k_fibo.c 的 kFibo 的扩展版），header-only
+ *
+ * 定义同原题：f_0 = ... = f_{k-2} = 0，f_{k-1} = 1，f_i = f_{i-1} + ... + f_{i-k}（i >= k）。
+ * 原实现每算一项都把窗口整体左移（O(k)），main 又对每个 i 从头算一遍，总共 O(m^2 k)。
+ *
+ * 关键等式（fibonacci.c 里已经用到）：f_i = 2 f_{i-1} - f_{i-1-k}，i >= k + 1。
+ * 于是：
+ * - 整段输出：kf_iter_* 用长度 k+1 的环形缓冲，每项 O(1)，与 k 无关
+ * - 单项 f_m：
+ *     kf_term_matrix   k×k 伴随矩阵快速幂，O(k^3 log m)，只适合小 k
+ *     kf_term_kitamasa 在 Q(x) = x^{k+1} - 2x^k + 1（即 (x-1)·特征多项式）下求 x^m mod Q，
+ *                      Q 只有三项，取模是一遍 O(k) 的线性扫描；平方用朴素乘法（k 小）或
+ *                      三模数 NTT + Garner 合并（k 大），总计 O(k log k log m)
+ * - 取模结果要求 2 <= mod < 2^31；精确值用 KfBig（32 位 limb 的非负大整数）配合环形缓冲计算
+ */
+#ifndef KFIBO_FAST_H
+#define KFIBO_FAST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*==================== 环形缓冲：逐项生成 ====================*/
+typedef struct {
+    int k;
+    uint32_t mod;          /* 0 表示不取模（按 uint64_t 自然溢出） */
+    uint64_t *w;           /* 最近 k+1 项 */
+    int head;              /* 最老一项的位置 */
+    uint64_t last;         /* 最新一项 */
+    uint64_t i;            /* 下一次 kf_iter_next 返回 f_i */
+} KfIter;
+
+/* 失败（k < 1 或内存不足）返回 false */
+static inline bool kf_iter_init(KfIter *it, int k, uint32_t mod) {
+    if (k < 1) return false;
+    it->w = (uint64_t *)calloc((size_t)k + 1, sizeof(uint64_t));
+    if (!it->w) return false;
+    it->k = k;
+    it->mod = mod;
+    it->head = 0;
+    it->last = 0;
+    it->i = 0;
+    return true;
+}
+
+static inline void kf_iter_free(KfIter *it) {
+    free(it->w);
+    it->w = NULL;
+}
+
+static inline uint64_t kf_iter_next(KfIter *it) {
+    int k = it->k;
+    uint64_t v;
+    if (it->i + 1 < (uint64_t)k) v = 0;
+    else if (it->i <= (uint64_t)k) v = it->mod == 1 ? 0 : 1;                 /* f_{k-1} = f_k = 1 */
+    else if (it->mod) v = (2 * it->last + it->mod - it->w[it->head]) % it->mod;
+    else v = 2 * it->last - it->w[it->head];
+    /* 窗口保存 f_{i-k} .. f_i：新值覆盖最老一项 f_{i-k-1} */
+    it->w[it->head] = v;
+    it->head = it->head == k ? 0 : it->head + 1;
+    it->last = v;
+    it->i++;
+    return v;
+}
+
+/* 把 f_0 .. f_{n-1} 写到 out（取模） */
+static inline bool kf_seq_mod(int k, uint32_t mod, uint32_t *out, size_t n) {
+    KfIter it;
+    if (!kf_iter_init(&it, k, mod)) return false;
+    for (size_t i = 0; i < n; ++i) out[i] = (uint32_t)kf_iter_next(&it);
+    kf_iter_free(&it);
+    return true;
+}
+
+/*==================== 伴随矩阵快速幂 ====================*/
+/* c = a * b（k×k，行主序），c 不能与 a、b 重叠。返回 false 表示内存不足 */
+static inline bool kf_matmul(const uint32_t *a, const uint32_t *b, uint32_t *c, int k, uint32_t mod) {
+    uint64_t *acc = (uint64_t *)malloc((size_t)k * sizeof(uint64_t));
+    if (!acc) return false;
+    for (int i = 0; i < k; ++i) {
+        memset(acc, 0, (size_t)k * sizeof(uint64_t));
+        for (int t = 0; t < k; ++t) {
+            uint64_t x = a[(size_t)i * k + t];
+            if (!x) continue;
+            const uint32_t *row = b + (size_t)t * k;
+            for (int j = 0; j < k; ++j) acc[j] = (acc[j] + x * row[j]) % mod;
+        }
+        for (int j = 0; j < k; ++j) c[(size_t)i * k + j] = (uint32_t)acc[j];
+    }
+    free(acc);
+    return true;
+}
+
+/*
+ * 状态向量 (f_i, f_{i-1}, ..., f_{i-k+1})，一步转移的矩阵第一行全 1，其余为下移。
+ * 从 i = k-1 的状态 (1, 0, ..., 0) 出发走 m-k+1 步，f_m 就是 M^{m-k+1} 的 [0][0]。
+ * 内存不足时返回 UINT32_MAX。
+ */
+static inline uint32_t kf_term_matrix(int k, uint64_t m, uint32_t mod) {
+    if (m + 1 < (uint64_t)k) return 0;
+    uint64_t e = m - (uint64_t)(k - 1);
+    size_t kk = (size_t)k * k;
+    uint32_t *M = (uint32_t *)calloc(kk, sizeof(uint32_t));
+    uint32_t *R = (uint32_t *)calloc(kk, sizeof(uint32_t));
+    uint32_t *T = (uint32_t *)calloc(kk, sizeof(uint32_t));
+    if (!M || !R || !T) {
+        free(M); free(R); free(T);
+        return UINT32_MAX;
+    }
+    for (int j = 0; j < k; ++j) M[j] = 1 % mod;
+    for (int i = 1; i < k; ++i) M[(size_t)i * k + i - 1] = 1 % mod;
+    for (int i = 0; i < k; ++i) R[(size_t)i * k + i] = 1 % mod;
+    bool ok = true;
+    while (ok && e) {
+        if (e & 1) {
+            ok = kf_matmul(R, M, T, k, mod);
+            memcpy(R, T, kk * sizeof(uint32_t));
+        }
+        e >>= 1;
+        if (ok && e) {
+            ok = kf_matmul(M, M, T, k, mod);
+            memcpy(M, T, kk * sizeof(uint32_t));
+        }
+    }
+    uint32_t ans = ok ? R[0] : UINT32_MAX;
+    free(M); free(R); free(T);
+    return ans;
+}
+
+/*==================== NTT（三个模数 + Garner 合并到任意模数） ====================*/
+static const uint32_t kf_ntt_p[3] = {998244353u, 167772161u, 469762049u};   /* 原根都是 3 */
+
+static inline uint32_t kf_pow_mod(uint64_t a, uint64_t e, uint32_t p) {
+    uint64_t r = 1 % p;
+    a %= p;
+    while (e) {
+        if (e & 1) r = r * a % p;
+        a = a * a % p;
+        e >>= 1;
+    }
+    return (uint32_t)r;
+}
+
+/* 原地 NTT，n 为 2 的幂；invert 时做逆变换（含除以 n）。返回 false 表示内存不足（a 未改动） */
+static inline bool kf_ntt(uint32_t *a, size_t n, uint32_t p, bool invert) {
+    uint32_t *wp = (uint32_t *)malloc((n / 2 + 1) * sizeof(uint32_t));
+    if (!wp) return false;
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) { uint32_t t = a[i]; a[i] = a[j]; a[j] = t; }
+    }
+    /* 每层的单位根幂次先算好（wp），内层循环只做乘加 */
+    for (size_t len = 2; len <= n; len <<= 1) {
+        uint64_t w = kf_pow_mod(3, (p - 1) / len, p);
+        if (invert) w = kf_pow_mod(w, p - 2, p);
+        size_t half = len >> 1;
+        wp[0] = 1;
+        for (size_t j = 1; j < half; ++j) wp[j] = (uint32_t)(wp[j - 1] * w % p);
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                uint32_t u = a[i + j];
+                uint32_t v = (uint32_t)((uint64_t)a[i + j + half] * wp[j] % p);
+                a[i + j] = u + v >= p ? u + v - p : u + v;
+                a[i + j + half] = u >= v ? u - v : u + p - v;
+            }
+        }
+    }
+    free(wp);
+    if (invert) {
+        uint64_t inv_n = kf_pow_mod(n, p - 2, p);
+        for (size_t i = 0; i < n; ++i) a[i] = (uint32_t)(a[i] * inv_n % p);
+    }
+    return true;
+}
+
+/* out[0..2n-1) = a[0..n)^2 mod mod；out 可以与 a 相同。返回 false 表示内存不足 */
+static inline bool kf_square_ntt(const uint32_t *a, size_t n, uint32_t *out, uint32_t mod) {
+    size_t L = 1;
+    while (L < 2 * n - 1) L <<= 1;
+    uint32_t *buf = (uint32_t *)malloc(3 * L * sizeof(uint32_t));
+    if (!buf) return false;
+    for (int t = 0; t < 3; ++t) {
+        uint32_t *b = buf + (size_t)t * L, p = kf_ntt_p[t];
+        for (size_t i = 0; i < n; ++i) b[i] = a[i] % p;
+        memset(b + n, 0, (L - n) * sizeof(uint32_t));
+        if (!kf_ntt(b, L, p, false)) { free(buf); return false; }
+        for (size_t i = 0; i < L; ++i) b[i] = (uint32_t)((uint64_t)b[i] * b[i] % p);
+        if (!kf_ntt(b, L, p, true)) { free(buf); return false; }
+    }
+    /* Garner：x = x1 + x2·p1 + x3·p1·p2，再对 mod 取余 */
+    const uint64_t p1 = kf_ntt_p[0], p2 = kf_ntt_p[1], p3 = kf_ntt_p[2];
+    const uint64_t inv_p1_p2 = kf_pow_mod(p1, p2 - 2, (uint32_t)p2);
+    const uint64_t inv_p1p2_p3 = kf_pow_mod(p1 * p2 % p3, p3 - 2, (uint32_t)p3);
+    const uint64_t p1_m = p1 % mod, p1p2_m = p1 * p2 % mod;
+    for (size_t i = 0; i < 2 * n - 1; ++i) {
+        uint64_t x1 = buf[i], a2 = buf[L + i], a3 = buf[2 * L + i];
+        uint64_t x2 = (a2 + p2 - x1 % p2) % p2 * inv_p1_p2 % p2;
+        uint64_t s = (x1 + x2 % p3 * (p1 % p3)) % p3;
+        uint64_t x3 = (a3 + p3 - s) % p3 * inv_p1p2_p3 % p3;
+        out[i] = (uint32_t)((x1 % mod + x2 % mod * p1_m + x3 % mod * p1p2_m) % mod);
+    }
+    free(buf);
+    return true;
+}
+
+/* 朴素平方，k 小时比 NTT 快。out 可以与 a 相同。返回 false 表示内存不足 */
+static inline bool kf_square_naive(const uint32_t *a, size_t n, uint32_t *out, uint32_t mod) {
+    uint64_t *acc = (uint64_t *)calloc(2 * n, sizeof(uint64_t));
+    if (!acc) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (!a[i]) continue;
+        for (size_t j = 0; j < n; ++j) acc[i + j] = (acc[i + j] + (uint64_t)a[i] * a[j]) % mod;
+    }
+    for (size_t i = 0; i + 1 < 2 * n; ++i) out[i] = (uint32_t)acc[i];
+    free(acc);
+    return true;
+}
+
+#ifndef KF_NTT_THRESHOLD
+#define KF_NTT_THRESHOLD 64          /* k 不小于此值时平方改用 NTT */
+#endif
+
+/*==================== Kitamasa ====================*/
+/* 把次数 < 2(k+1) 的多项式 a 对 Q(x) = x^{k+1} - 2x^k + 1 取模：x^{k+1} ≡ 2x^k - 1 */
+static inline void kf_reduce(uint32_t *a, size_t deg_plus1, int k, uint32_t mod) {
+    size_t D = (size_t)k + 1;
+    for (size_t d = deg_plus1; d-- > D;) {
+        uint64_t c = a[d];
+        if (!c) continue;
+        a[d] = 0;
+        a[d - 1] = (uint32_t)((a[d - 1] + 2 * c) % mod);
+        a[d - D] = (uint32_t)((a[d - D] + mod - c) % mod);
+    }
+}
+
+/*
+ * f_m mod mod。r(x) = x^m mod Q 求出后，f_m = Σ r_j f_j（j = 0..k）= r_{k-1} + r_k。
+ * 内存不足时返回 UINT32_MAX。
+ */
+static inline uint32_t kf_term_kitamasa(int k, uint64_t m, uint32_t mod) {
+    if (k < 1 || mod < 2) return UINT32_MAX;
+    if (m + 1 < (uint64_t)k) return 0;
+    if (m <= (uint64_t)k) return 1;
+    size_t D = (size_t)k + 1;
+    uint32_t *r = (uint32_t *)calloc(2 * D, sizeof(uint32_t));
+    if (!r) return UINT32_MAX;
+    r[0] = 1;
+    int top = 63;
+    while (!((m >> top) & 1)) --top;
+    for (int b = top; b >= 0; --b) {
+        if (b != top) {
+            bool sq = k >= KF_NTT_THRESHOLD ? kf_square_ntt(r, D, r, mod) : kf_square_naive(r, D, r, mod);
+            if (!sq) { free(r); return UINT32_MAX; }
+            kf_reduce(r, 2 * D - 1, k, mod);
+        }
+        if ((m >> b) & 1) {                 /* 乘 x：整体右移一位再约一次 */
+            memmove(r + 1, r, D * sizeof(uint32_t));
+            r[0] = 0;
+            kf_reduce(r, D + 1, k, mod);
+        }
+    }
+    uint32_t ans = (uint32_t)(((uint64_t)r[k - 1] + r[k]) % mod);
+    free(r);
+    return ans;
+}
+
+/*==================== 精确值：大整数 ====================*/
+typedef struct {
+    uint32_t *d;           /* 小端 limb */
+    size_t n, cap;
+} KfBig;
+
+static inline void kf_big_free(KfBig *x) { free(x->d); x->d = NULL; x->n = x->cap = 0; }
+
+static inline bool kf_big_reserve(KfBig *x, size_t n) {
+    if (n <= x->cap) return true;
+    size_t cap = x->cap ? x->cap * 2 : 4;
+    while (cap < n) cap *= 2;
+    uint32_t *p = (uint32_t *)realloc(x->d, cap * sizeof(uint32_t));
+    if (!p) return false;
+    x->d = p;
+    x->cap = cap;
+    return true;
+}
+
+/* dst = 2*a - dst，调用者保证结果非负（数列不减，总成立） */
+static inline bool kf_big_twice_minus(KfBig *dst, const KfBig *a) {
+    size_t n = a->n + 1;
+    if (!kf_big_reserve(dst, n)) return false;
+    for (size_t i = dst->n; i < n; ++i) dst->d[i] = 0;
+    int64_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int64_t v = carry - (int64_t)dst->d[i];
+        if (i < a->n) v += 2 * (int64_t)a->d[i];
+        dst->d[i] = (uint32_t)v;
+        carry = v >> 32;                    /* 算术右移：借位为 -1 */
+    }
+    while (n && dst->d[n - 1] == 0) --n;
+    dst->n = n;
+    return true;
+}
+
+/* f_m 的精确值，O(m · 位数) 时间、O(k · 位数) 空间。失败返回 false */
+static inline bool kf_term_big(int k, uint64_t m, KfBig *out) {
+    kf_big_free(out);
+    if (k < 1) return false;
+    if (m + 1 < (uint64_t)k) return true;          /* 0：n = 0 */
+    if (m <= (uint64_t)k) {
+        if (!kf_big_reserve(out, 1)) return false;
+        out->d[0] = 1;
+        out->n = 1;
+        return true;
+    }
+    /* 窗口保存 f_{i-k-1} .. f_{i-1}；初始为 f_0 .. f_k */
+    KfBig *w = (KfBig *)calloc((size_t)k + 1, sizeof(KfBig));
+    if (!w) return false;
+    bool ok = kf_big_reserve(&w[k - 1], 1) && kf_big_reserve(&w[k], 1);
+    if (ok) {
+        w[k - 1].d[0] = w[k].d[0] = 1;
+        w[k - 1].n = w[k].n = 1;
+    }
+    int head = 0, last = k;
+    for (uint64_t i = (uint64_t)k + 1; ok && i <= m; ++i) {
+        ok = kf_big_twice_minus(&w[head], &w[last]);   /* f_i = 2 f_{i-1} - f_{i-1-k} */
+        last = head;
+        head = head == k ? 0 : head + 1;
+    }
+    if (ok) {
+        *out = w[last];
+        w[last].d = NULL;
+    }
+    for (int i = 0; i <= k; ++i) kf_big_free(&w[i]);
+    free(w);
+    return ok;
+}
+
+static inline uint32_t kf_big_mod(const KfBig *x, uint32_t mod) {
+    uint64_t r = 0;
+    for (size_t i = x->n; i-- > 0;) r = ((r << 32) | x->d[i]) % mod;
+    return (uint32_t)r;
+}
+
+/* 十进制字符串（调用者 free），O(位数^2) */
+static inline char *kf_big_to_dec(const KfBig *x) {
+    size_t n = x->n;
+    uint32_t *t = (uint32_t *)malloc((n ? n : 1) * sizeof(uint32_t));
+    char *s = (char *)malloc(n * 10 + 2);
+    if (!t || !s) { free(t); free(s); return NULL; }
+    memcpy(t, x->d, n * sizeof(uint32_t));
+    size_t len = 0;
+    while (n) {                                  /* 每次除以 10^9，取出低 9 位十进制 */
+        uint64_t r = 0;
+        for (size_t i = n; i-- > 0;) {
+            uint64_t cur = (r << 32) | t[i];
+            t[i] = (uint32_t)(cur / 1000000000u);
+            r = cur % 1000000000u;
+        }
+        while (n && t[n - 1] == 0) --n;
+        for (int j = 0; j < 9 && (n || r); ++j) { s[len++] = (char)('0' + r % 10); r /= 10; }
+    }
+    if (len == 0) s[len++] = '0';
+    for (size_t i = 0; i < len / 2; ++i) { char c = s[i]; s[i] = s[len - 1 - i]; s[len - 1 - i] = c; }
+    s[len] = '\0';
+    free(t);
+    return s;
+}
+
+#endif /* KFIBO_FAST_H */
@@ -0,0 +1,577 @@
+/*
+ * 压缩的有序整数集合（Roaring 风格），header-only
+ *
+ * 2_29.c、intersection.c 中的有序集合都用裸 int 数组存放。这里把 32 位值按高 16 位分块，
+ * 每块（2^16 个值）根据内容选用三种容器之一：
+ * - ARRAY：有序 uint16_t 数组，元素数 <= 4096 时使用（每个值 2 字节）
+ * - BITMAP：1024 个 uint64_t 的位图（固定 8KB），元素较多时使用
+ * - RUN：  [start, start+len] 游程列表，连续段很多时由 rs_run_optimize 转换
+ * 交、差、并逐对容器计算：位图之间按字做与/或/与非并用 popcount 计数，
+ * 数组之间两指针归并，其余组合按“对一方逐个查询”或“都展开成位图”处理。
+ *
+ * int 值先异或 0x80000000 映射为 uint32，使有符号顺序与无符号顺序一致。
+ * 序列化格式为小端、与平台无关（见 rs_serialize）。
+ *
+ * 容器运算返回 1（结果非空）、0（结果为空）或 -1（内存不足）；集合级函数返回 false 表示
+ * 内存不足，此时结果集合已释放为空集。
+ */
+#ifndef COMPRESSED_SET_H
+#define COMPRESSED_SET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RS_ARRAY_MAX 4096
+#define RS_BITMAP_WORDS 1024
+
+typedef enum { RS_ARRAY = 1, RS_BITMAP = 2, RS_RUN = 3 } RsType;
+
+typedef struct {
+    uint16_t start, len;    /* 覆盖 [start, start+len] */
+} RsRun;
+
+typedef struct {
+    uint8_t type;
+    uint32_t card;          /* 元素个数（1..65536） */
+    uint32_t n;             /* ARRAY: 元素数；RUN: 游程数；BITMAP: 未用 */
+    union {
+        uint16_t *array;
+        uint64_t *bitmap;
+        RsRun *runs;
+    } u;
+} RsContainer;
+
+typedef struct {
+    uint16_t *keys;         /* 各容器的高 16 位，递增 */
+    RsContainer *cs;
+    size_t n, cap;
+} RSet;
+
+static inline uint32_t rs_map(int x) { return (uint32_t)x ^ 0x80000000u; }
+static inline int rs_unmap(uint32_t u) { return (int)(u ^ 0x80000000u); }
+
+/*==================== 容器 ====================*/
+static inline void ct_free(RsContainer *c) {
+    free(c->u.array);
+    c->u.array = NULL;
+    c->card = c->n = 0;
+}
+
+static inline size_t ct_bytes(const RsContainer *c) {
+    switch (c->type) {
+    case RS_ARRAY:  return c->n * sizeof(uint16_t);
+    case RS_BITMAP: return RS_BITMAP_WORDS * sizeof(uint64_t);
+    default:        return c->n * sizeof(RsRun);
+    }
+}
+
+static inline bool ct_contains(const RsContainer *c, uint16_t v) {
+    if (c->type == RS_BITMAP) return (c->u.bitmap[v >> 6] >> (v & 63)) & 1;
+    if (c->type == RS_ARRAY) {
+        size_t l = 0, r = c->n;
+        while (l < r) {
+            size_t m = (l + r) / 2;
+            if (c->u.array[m] < v) l = m + 1;
+            else r = m;
+        }
+        return l < c->n && c->u.array[l] == v;
+    }
+    size_t l = 0, r = c->n;          /* 找最后一个 start <= v 的游程 */
+    while (l < r) {
+        size_t m = (l + r) / 2;
+        if (c->u.runs[m].start <= v) l = m + 1;
+        else r = m;
+    }
+    return l > 0 && v - c->u.runs[l - 1].start <= c->u.runs[l - 1].len;
+}
+
+static inline void bitmap_set_range(uint64_t *w, uint32_t lo, uint32_t hi) {   /* [lo, hi] */
+    uint32_t a = lo >> 6, b = hi >> 6;
+    uint64_t ma = ~0ULL << (lo & 63), mb = ~0ULL >> (63 - (hi & 63));
+    if (a == b) { w[a] |= ma & mb; return; }
+    w[a] |= ma;
+    for (uint32_t i = a + 1; i < b; ++i) w[i] = ~0ULL;
+    w[b] |= mb;
+}
+
+/* 把任意容器展开到 1024 字的位图 */
+static inline void ct_to_bitmap(const RsContainer *c, uint64_t *w) {
+    if (c->type == RS_BITMAP) { memcpy(w, c->u.bitmap, RS_BITMAP_WORDS * 8); return; }
+    memset(w, 0, RS_BITMAP_WORDS * 8);
+    if (c->type == RS_ARRAY) {
+        for (uint32_t i = 0; i < c->n; ++i) w[c->u.array[i] >> 6] |= 1ULL << (c->u.array[i] & 63);
+    } else {
+        for (uint32_t i = 0; i < c->n; ++i)
+            bitmap_set_range(w, c->u.runs[i].start, (uint32_t)c->u.runs[i].start + c->u.runs[i].len);
+    }
+}
+
+static inline uint32_t bitmap_card(const uint64_t *w) {
+    uint32_t s = 0;
+    for (int i = 0; i < RS_BITMAP_WORDS; ++i) s += (uint32_t)__builtin_popcountll(w[i]);
+    return s;
+}
+
+/* 由位图生成容器：元素少则转为数组；接管或复制 w（接管时失败也会释放 w）。card 为 0 时返回 0 */
+static inline int ct_from_bitmap(RsContainer *c, uint64_t *w, uint32_t card, bool take) {
+    if (card == 0) { if (take) free(w); return 0; }
+    if (card <= RS_ARRAY_MAX) {
+        c->type = RS_ARRAY;
+        c->u.array = (uint16_t *)malloc(card * sizeof(uint16_t));
+        if (!c->u.array) { if (take) free(w); return -1; }
+        uint32_t k = 0;
+        for (int i = 0; i < RS_BITMAP_WORDS; ++i)
+            for (uint64_t x = w[i]; x; x &= x - 1)
+                c->u.array[k++] = (uint16_t)(i * 64 + __builtin_ctzll(x));
+        c->n = card;
+        if (take) free(w);
+    } else {
+        c->type = RS_BITMAP;
+        if (take) c->u.bitmap = w;
+        else {
+            c->u.bitmap = (uint64_t *)malloc(RS_BITMAP_WORDS * 8);
+            if (!c->u.bitmap) return -1;
+            memcpy(c->u.bitmap, w, RS_BITMAP_WORDS * 8);
+        }
+        c->n = 0;
+    }
+    c->card = card;
+    return 1;
+}
+
+/* 由有序 uint16 数组生成容器（复制） */
+static inline int ct_from_sorted(RsContainer *c, const uint16_t *v, uint32_t n) {
+    if (n == 0) return 0;
+    if (n <= RS_ARRAY_MAX) {
+        c->type = RS_ARRAY;
+        c->u.array = (uint16_t *)malloc(n * sizeof(uint16_t));
+        if (!c->u.array) return -1;
+        memcpy(c->u.array, v, n * sizeof(uint16_t));
+        c->n = c->card = n;
+        return 1;
+    }
+    uint64_t *w = (uint64_t *)calloc(RS_BITMAP_WORDS, 8);
+    if (!w) return -1;
+    for (uint32_t i = 0; i < n; ++i) w[v[i] >> 6] |= 1ULL << (v[i] & 63);
+    return ct_from_bitmap(c, w, n, true);
+}
+
+/* --- 交 --- */
+static inline int ct_and(const RsContainer *a, const RsContainer *b, RsContainer *r) {
+    static _Thread_local uint16_t buf[RS_ARRAY_MAX];
+    if (a->type == RS_ARRAY && b->type == RS_ARRAY) {
+        uint32_t i = 0, j = 0, k = 0;
+        while (i < a->n && j < b->n) {
+            uint16_t x = a->u.array[i], y = b->u.array[j];
+            buf[k] = x;
+            k += (x == y);
+            i += (x <= y);
+            j += (y <= x);
+        }
+        return ct_from_sorted(r, buf, k);
+    }
+    if (a->type == RS_ARRAY || b->type == RS_ARRAY) {   /* 数组逐个查询另一方 */
+        const RsContainer *s = a->type == RS_ARRAY ? a : b, *o = s == a ? b : a;
+        uint32_t k = 0;
+        for (uint32_t i = 0; i < s->n; ++i)
+            if (ct_contains(o, s->u.array[i])) buf[k++] = s->u.array[i];
+        return ct_from_sorted(r, buf, k);
+    }
+    if (a->type == RS_RUN && b->type == RS_RUN) {       /* 区间求交 */
+        RsRun *out = (RsRun *)malloc((a->n + b->n) * sizeof(RsRun));
+        if (!out) return -1;
+        uint32_t i = 0, j = 0, k = 0, card = 0;
+        while (i < a->n && j < b->n) {
+            uint32_t as = a->u.runs[i].start, ae = as + a->u.runs[i].len;
+            uint32_t bs = b->u.runs[j].start, be = bs + b->u.runs[j].len;
+            uint32_t s = as > bs ? as : bs, e = ae < be ? ae : be;
+            if (s <= e) { out[k].start = (uint16_t)s; out[k].len = (uint16_t)(e - s); card += e - s + 1; k++; }
+            if (ae < be) i++; else j++;
+        }
+        if (k == 0) { free(out); return 0; }
+        r->type = RS_RUN; r->u.runs = out; r->n = k; r->card = card;
+        return 1;
+    }
+    uint64_t *w = (uint64_t *)malloc(RS_BITMAP_WORDS * 8);
+    if (!w) return -1;
+    uint64_t tmp[RS_BITMAP_WORDS];
+    const uint64_t *x = a->u.bitmap, *y = b->u.bitmap;
+    if (a->type != RS_BITMAP) { ct_to_bitmap(a, tmp); x = tmp; }
+    if (b->type != RS_BITMAP) { ct_to_bitmap(b, tmp); y = tmp; }
+    uint32_t card = 0;
+    for (int i = 0; i < RS_BITMAP_WORDS; ++i) {
+        w[i] = x[i] & y[i];
+        card += (uint32_t)__builtin_popcountll(w[i]);
+    }
+    return ct_from_bitmap(r, w, card, true);
+}
+
+/* --- 差 a \ b --- */
+static inline int ct_andnot(const RsContainer *a, const RsContainer *b, RsContainer *r) {
+    static _Thread_local uint16_t buf[RS_ARRAY_MAX];
+    if (a->type == RS_ARRAY) {
+        uint32_t k = 0;
+        if (b->type == RS_ARRAY) {
+            uint32_t j = 0;
+            for (uint32_t i = 0; i < a->n; ++i) {
+                uint16_t x = a->u.array[i];
+                while (j < b->n && b->u.array[j] < x) j++;
+                if (j >= b->n || b->u.array[j] != x) buf[k++] = x;
+            }
+        } else {
+            for (uint32_t i = 0; i < a->n; ++i)
+                if (!ct_contains(b, a->u.array[i])) buf[k++] = a->u.array[i];
+        }
+        return ct_from_sorted(r, buf, k);
+    }
+    uint64_t *w = (uint64_t *)malloc(RS_BITMAP_WORDS * 8);
+    if (!w) return -1;
+    ct_to_bitmap(a, w);
+    uint32_t card;
+    if (b->type == RS_ARRAY) {
+        for (uint32_t i = 0; i < b->n; ++i) w[b->u.array[i] >> 6] &= ~(1ULL << (b->u.array[i] & 63));
+        card = bitmap_card(w);
+    } else {
+        uint64_t tmp[RS_BITMAP_WORDS];
+        const uint64_t *y = b->u.bitmap;
+        if (b->type != RS_BITMAP) { ct_to_bitmap(b, tmp); y = tmp; }
+        card = 0;
+        for (int i = 0; i < RS_BITMAP_WORDS; ++i) {
+            w[i] &= ~y[i];
+            card += (uint32_t)__builtin_popcountll(w[i]);
+        }
+    }
+    return ct_from_bitmap(r, w, card, true);
+}
+
+/* --- 并 --- */
+static inline int ct_or(const RsContainer *a, const RsContainer *b, RsContainer *r) {
+    if (a->type == RS_ARRAY && b->type == RS_ARRAY && a->n + b->n <= RS_ARRAY_MAX) {
+        uint16_t buf[2 * RS_ARRAY_MAX];
+        uint32_t i = 0, j = 0, k = 0;
+        while (i < a->n && j < b->n) {
+            uint16_t x = a->u.array[i], y = b->u.array[j];
+            buf[k++] = x < y ? x : y;
+            i += (x <= y);
+            j += (y <= x);
+        }
+        while (i < a->n) buf[k++] = a->u.array[i++];
+        while (j < b->n) buf[k++] = b->u.array[j++];
+        return ct_from_sorted(r, buf, k);
+    }
+    uint64_t *w = (uint64_t *)malloc(RS_BITMAP_WORDS * 8);
+    if (!w) return -1;
+    ct_to_bitmap(a, w);
+    uint32_t card;
+    if (b->type == RS_ARRAY) {
+        for (uint32_t i = 0; i < b->n; ++i) w[b->u.array[i] >> 6] |= 1ULL << (b->u.array[i] & 63);
+        card = bitmap_card(w);
+    } else {
+        uint64_t tmp[RS_BITMAP_WORDS];
+        const uint64_t *y = b->u.bitmap;
+        if (b->type != RS_BITMAP) { ct_to_bitmap(b, tmp); y = tmp; }
+        card = 0;
+        for (int i = 0; i < RS_BITMAP_WORDS; ++i) {
+            w[i] |= y[i];
+            card += (uint32_t)__builtin_popcountll(w[i]);
+        }
+    }
+    return ct_from_bitmap(r, w, card, true);
+}
+
+static inline bool ct_copy(RsContainer *dst, const RsContainer *src) {
+    *dst = *src;
+    size_t bytes = ct_bytes(src);
+    dst->u.array = (uint16_t *)malloc(bytes);
+    if (!dst->u.array) return false;
+    memcpy(dst->u.array, src->u.array, bytes);
+    return true;
+}
+
+/*==================== 集合 ====================*/
+static inline void rs_init(RSet *s) { s->keys = NULL; s->cs = NULL; s->n = s->cap = 0; }
+
+static inline void rs_free(RSet *s) {
+    for (size_t i = 0; i < s->n; ++i) ct_free(&s->cs[i]);
+    free(s->keys);
+    free(s->cs);
+    rs_init(s);
+}
+
+/* 追加一个容器（接管其数据）；扩容失败返回 false，s 不变，c 仍归调用方 */
+static inline bool rs_append(RSet *s, uint16_t key, const RsContainer *c) {
+    if (s->n == s->cap) {
+        size_t cap = s->cap ? s->cap * 2 : 8;
+        uint16_t *keys = (uint16_t *)realloc(s->keys, cap * sizeof(uint16_t));
+        if (!keys) return false;
+        s->keys = keys;
+        RsContainer *cs = (RsContainer *)realloc(s->cs, cap * sizeof(RsContainer));
+        if (!cs) return false;
+        s->cs = cs;
+        s->cap = cap;
+    }
+    s->keys[s->n] = key;
+    s->cs[s->n] = *c;
+    s->n++;
+    return true;
+}
+
+/* 按容器运算的返回值追加：1 时追加，0 时跳过；返回 false 表示内存不足（c 已释放） */
+static inline bool rs_append_result(RSet *s, uint16_t key, RsContainer *c, int res) {
+    if (res < 0) return false;
+    if (res == 0) return true;
+    if (rs_append(s, key, c)) return true;
+    ct_free(c);
+    return false;
+}
+
+static inline size_t rs_cardinality(const RSet *s) {
+    size_t c = 0;
+    for (size_t i = 0; i < s->n; ++i) c += s->cs[i].card;
+    return c;
+}
+
+/* 占用的堆内存（字节） */
+static inline size_t rs_bytes(const RSet *s) {
+    size_t b = s->cap * (sizeof(uint16_t) + sizeof(RsContainer));
+    for (size_t i = 0; i < s->n; ++i) b += ct_bytes(&s->cs[i]);
+    return b;
+}
+
+static inline bool rs_contains(const RSet *s, int x) {
+    uint32_t u = rs_map(x);
+    uint16_t key = (uint16_t)(u >> 16);
+    size_t l = 0, r = s->n;
+    while (l < r) {
+        size_t m = (l + r) / 2;
+        if (s->keys[m] < key) l = m + 1;
+        else r = m;
+    }
+    return l < s->n && s->keys[l] == key && ct_contains(&s->cs[l], (uint16_t)u);
+}
+
+/* 由递增 int 数组（即 SeqList 的 data/size）构建；内存不足返回 false */
+static inline bool rs_from_sorted(RSet *s, const int *data, size_t n) {
+    rs_init(s);
+    uint16_t *buf = (uint16_t *)malloc(65536 * sizeof(uint16_t));
+    if (!buf) return false;
+    size_t i = 0;
+    while (i < n) {
+        uint16_t key = (uint16_t)(rs_map(data[i]) >> 16);
+        uint32_t k = 0;
+        while (i < n && (uint16_t)(rs_map(data[i]) >> 16) == key) buf[k++] = (uint16_t)rs_map(data[i++]);
+        RsContainer c;
+        if (!rs_append_result(s, key, &c, ct_from_sorted(&c, buf, k))) { free(buf); rs_free(s); return false; }
+    }
+    free(buf);
+    return true;
+}
+
+/* 写回递增 int 数组，返回个数；out 至少能容纳 rs_cardinality 个元素 */
+static inline size_t rs_to_sorted(const RSet *s, int *out) {
+    size_t k = 0;
+    for (size_t i = 0; i < s->n; ++i) {
+        uint32_t hi = (uint32_t)s->keys[i] << 16;
+        const RsContainer *c = &s->cs[i];
+        if (c->type == RS_ARRAY) {
+            for (uint32_t j = 0; j < c->n; ++j) out[k++] = rs_unmap(hi | c->u.array[j]);
+        } else if (c->type == RS_BITMAP) {
+            for (int w = 0; w < RS_BITMAP_WORDS; ++w)
+                for (uint64_t x = c->u.bitmap[w]; x; x &= x - 1)
+                    out[k++] = rs_unmap(hi | (uint32_t)(w * 64 + __builtin_ctzll(x)));
+        } else {
+            for (uint32_t j = 0; j < c->n; ++j)
+                for (uint32_t v = c->u.runs[j].start; v <= (uint32_t)c->u.runs[j].start + c->u.runs[j].len; ++v)
+                    out[k++] = rs_unmap(hi | v);
+        }
+    }
+    return k;
+}
+
+/* 对每个容器，若游程表示更省空间就改用 RUN；内存不足时该容器保持原样 */
+static inline void rs_run_optimize(RSet *s) {
+    for (size_t i = 0; i < s->n; ++i) {
+        RsContainer *c = &s->cs[i];
+        if (c->type == RS_RUN) continue;
+        uint64_t w[RS_BITMAP_WORDS];
+        ct_to_bitmap(c, w);
+        uint32_t runs = 0;                 /* 游程数 = 0->1 的跳变次数 */
+        uint64_t prev_top = 0;
+        for (int j = 0; j < RS_BITMAP_WORDS; ++j) {
+            uint64_t starts = w[j] & ~((w[j] << 1) | prev_top);
+            runs += (uint32_t)__builtin_popcountll(starts);
+            prev_top = w[j] >> 63;
+        }
+        if (runs * sizeof(RsRun) >= ct_bytes(c)) continue;
+        RsRun *out = (RsRun *)malloc(runs * sizeof(RsRun));
+        if (!out) continue;
+        uint32_t k = 0, v = 0;
+        while (v < 65536) {
+            if (!((w[v >> 6] >> (v & 63)) & 1)) { v++; continue; }
+            uint32_t st = v;
+            while (v < 65536 && ((w[v >> 6] >> (v & 63)) & 1)) v++;
+            out[k].start = (uint16_t)st;
+            out[k].len = (uint16_t)(v - 1 - st);
+            k++;
+        }
+        ct_free(c);
+        c->type = RS_RUN;
+        c->u.runs = out;
+        c->n = runs;
+        c->card = 0;
+        for (uint32_t j = 0; j < runs; ++j) c->card += out[j].len + 1u;
+    }
+}
+
+/* r = a ∩ b；内存不足返回 false */
+static inline bool rs_and(const RSet *a, const RSet *b, RSet *r) {
+    rs_init(r);
+    size_t i = 0, j = 0;
+    while (i < a->n && j < b->n) {
+        if (a->keys[i] < b->keys[j]) i++;
+        else if (a->keys[i] > b->keys[j]) j++;
+        else {
+            RsContainer c;
+            if (!rs_append_result(r, a->keys[i], &c, ct_and(&a->cs[i], &b->cs[j], &c))) goto fail;
+            i++; j++;
+        }
+    }
+    return true;
+fail:
+    rs_free(r);
+    return false;
+}
+
+/* r = a \ b；内存不足返回 false */
+static inline bool rs_andnot(const RSet *a, const RSet *b, RSet *r) {
+    rs_init(r);
+    size_t j = 0;
+    for (size_t i = 0; i < a->n; ++i) {
+        while (j < b->n && b->keys[j] < a->keys[i]) j++;
+        RsContainer c;
+        int res = (j < b->n && b->keys[j] == a->keys[i]) ? ct_andnot(&a->cs[i], &b->cs[j], &c)
+                                                         : (ct_copy(&c, &a->cs[i]) ? 1 : -1);
+        if (!rs_append_result(r, a->keys[i], &c, res)) goto fail;
+    }
+    return true;
+fail:
+    rs_free(r);
+    return false;
+}
+
+/* r = a ∪ b；内存不足返回 false */
+static inline bool rs_or(const RSet *a, const RSet *b, RSet *r) {
+    rs_init(r);
+    size_t i = 0, j = 0;
+    while (i < a->n || j < b->n) {
+        RsContainer c;
+        uint16_t key;
+        int res;
+        if (j >= b->n || (i < a->n && a->keys[i] < b->keys[j])) {
+            key = a->keys[i];
+            res = ct_copy(&c, &a->cs[i++]) ? 1 : -1;
+        } else if (i >= a->n || b->keys[j] < a->keys[i]) {
+            key = b->keys[j];
+            res = ct_copy(&c, &b->cs[j++]) ? 1 : -1;
+        } else {
+            key = a->keys[i];
+            res = ct_or(&a->cs[i], &b->cs[j], &c);
+            i++; j++;
+        }
+        if (!rs_append_result(r, key, &c, res)) goto fail;
+    }
+    return true;
+fail:
+    rs_free(r);
+    return false;
+}
+
+/*==================== 序列化 ====================*/
+/*
+ * 格式（全部小端）：
+ *   "RSET" | u32 容器数 | 每个容器: u16 key, u8 type, u32 card, u32 n, 数据
+ *   数据: ARRAY n 个 u16；BITMAP 1024 个 u64；RUN n 对 (u16 start, u16 len)
+ */
+static inline void rs_put_le(FILE *f, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) fputc((int)((v >> (8 * i)) & 0xff), f);
+}
+
+static inline bool rs_get_le(FILE *f, uint64_t *v, int bytes) {
+    *v = 0;
+    for (int i = 0; i < bytes; ++i) {
+        int c = fgetc(f);
+        if (c == EOF) return false;
+        *v |= (uint64_t)c << (8 * i);
+    }
+    return true;
+}
+
+static inline bool rs_serialize(const RSet *s, FILE *f) {
+    fwrite("RSET", 1, 4, f);
+    rs_put_le(f, s->n, 4);
+    for (size_t i = 0; i < s->n; ++i) {
+        const RsContainer *c = &s->cs[i];
+        rs_put_le(f, s->keys[i], 2);
+        rs_put_le(f, c->type, 1);
+        rs_put_le(f, c->card, 4);
+        rs_put_le(f, c->n, 4);
+        if (c->type == RS_ARRAY)
+            for (uint32_t j = 0; j < c->n; ++j) rs_put_le(f, c->u.array[j], 2);
+        else if (c->type == RS_BITMAP)
+            for (int j = 0; j < RS_BITMAP_WORDS; ++j) rs_put_le(f, c->u.bitmap[j], 8);
+        else
+            for (uint32_t j = 0; j < c->n; ++j) {
+                rs_put_le(f, c->u.runs[j].start, 2);
+                rs_put_le(f, c->u.runs[j].len, 2);
+            }
+    }
+    return !ferror(f);
+}
+
+static inline bool rs_deserialize(RSet *s, FILE *f) {
+    rs_init(s);
+    char magic[4];
+    uint64_t cnt, key, type, card, n, v;
+    if (fread(magic, 1, 4, f) != 4 || memcmp(magic, "RSET", 4) != 0) return false;
+    if (!rs_get_le(f, &cnt, 4)) return false;
+    for (uint64_t i = 0; i < cnt; ++i) {
+        if (!rs_get_le(f, &key, 2) || !rs_get_le(f, &type, 1) || !rs_get_le(f, &card, 4) ||
+            !rs_get_le(f, &n, 4))
+            goto fail;
+        RsContainer c;
+        c.type = (uint8_t)type;
+        c.card = (uint32_t)card;
+        c.n = (uint32_t)n;
+        if (type == RS_ARRAY && n <= RS_ARRAY_MAX) {
+            c.u.array = (uint16_t *)malloc((n ? n : 1) * sizeof(uint16_t));
+            if (!c.u.array) goto fail;
+            for (uint64_t j = 0; j < n; ++j) { if (!rs_get_le(f, &v, 2)) { free(c.u.array); goto fail; } c.u.array[j] = (uint16_t)v; }
+        } else if (type == RS_BITMAP) {
+            c.u.bitmap = (uint64_t *)malloc(RS_BITMAP_WORDS * 8);
+            if (!c.u.bitmap) goto fail;
+            for (int j = 0; j < RS_BITMAP_WORDS; ++j) { if (!rs_get_le(f, &v, 8)) { free(c.u.bitmap); goto fail; } c.u.bitmap[j] = v; }
+        } else if (type == RS_RUN && n <= 32768) {
+            c.u.runs = (RsRun *)malloc((n ? n : 1) * sizeof(RsRun));
+            if (!c.u.runs) goto fail;
+            for (uint64_t j = 0; j < n; ++j) {
+                uint64_t st, len;
+                if (!rs_get_le(f, &st, 2) || !rs_get_le(f, &len, 2)) { free(c.u.runs); goto fail; }
+                c.u.runs[j].start = (uint16_t)st;
+                c.u.runs[j].len = (uint16_t)len;
+            }
+        } else {
+            goto fail;
+        }
+        if (!rs_append(s, (uint16_t)key, &c)) { ct_free(&c); goto fail; }
+    }
+    return true;
+fail:
+    rs_free(s);
+    return false;
+}
+
+#endif /* COMPRESSED_SET_H */
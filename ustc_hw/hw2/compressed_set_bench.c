@@ -0,0 +1,121 @@
+// 压缩有序集合（compressed_set.h）与普通 int 数组两指针算法的对比：内存占用与运算吞吐
+// 编译: gcc -O2 -march=native compressed_set_bench.c -o compressed_set_bench
+// 用法: compressed_set_bench [每个集合的元素数，默认 5000000]
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/bench_util.h"
+#include "compressed_set.h"
+
+/* 与 2_29.c 相同的顺序表，只是改为动态长度 */
+typedef struct {
+    int *data;
+    int size;
+} SeqList;
+
+/*==================== 两指针基准 ====================*/
+static int seq_and(const SeqList *A, const SeqList *B, int *out) {
+    int i = 0, j = 0, k = 0;
+    while (i < A->size && j < B->size) {
+        if (A->data[i] < B->data[j]) i++;
+        else if (A->data[i] > B->data[j]) j++;
+        else { out[k++] = A->data[i]; i++; j++; }
+    }
+    return k;
+}
+
+static int seq_andnot(const SeqList *A, const SeqList *B, int *out) {
+    int j = 0, k = 0;
+    for (int i = 0; i < A->size; i++) {
+        while (j < B->size && B->data[j] < A->data[i]) j++;
+        if (j >= B->size || B->data[j] != A->data[i]) out[k++] = A->data[i];
+    }
+    return k;
+}
+
+static int seq_or(const SeqList *A, const SeqList *B, int *out) {
+    int i = 0, j = 0, k = 0;
+    while (i < A->size && j < B->size) {
+        if (A->data[i] < B->data[j]) out[k++] = A->data[i++];
+        else if (A->data[i] > B->data[j]) out[k++] = B->data[j++];
+        else { out[k++] = A->data[i]; i++; j++; }
+    }
+    while (i < A->size) out[k++] = A->data[i++];
+    while (j < B->size) out[k++] = B->data[j++];
+    return k;
+}
+
+/*==================== 数据 ====================*/
+static unsigned rng = 2463534242u;
+static unsigned next_rand(void) { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; }
+
+/* kind 0 稀疏：间隔均匀随机，跨满 32 位；1 稠密：约 80% 的值出现；2 成簇：长游程 + 大间隔 */
+static void gen(SeqList *L, int n, int kind) {
+    L->data = (int *)malloc((size_t)n * sizeof(int));
+    L->size = n;
+    long long v = kind == 0 ? -2000000000LL : 0;
+    for (int i = 0; i < n; i++) {
+        if (kind == 0) v += 1 + next_rand() % 800;
+        else if (kind == 1) v += 1 + (next_rand() % 5 == 0);
+        else v += (next_rand() % 200 == 0) ? 1 + next_rand() % 5000 : 1;
+        L->data[i] = (int)v;
+    }
+}
+
+static bool same(const int *a, const int *b, size_t n) { return memcmp(a, b, n * sizeof(int)) == 0; }
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 5000000;
+    const char *names[] = {"稀疏", "稠密", "成簇"};
+    int *o1 = (int *)malloc(2 * (size_t)n * sizeof(int));
+    int *o2 = (int *)malloc(2 * (size_t)n * sizeof(int));
+
+    printf("n = %d\n", n);
+    printf("%-6s %10s %10s %8s | %-6s %10s %10s %8s\n", "数据", "数组 MB", "压缩 MB", "比例",
+           "运算", "数组 ms", "压缩 ms", "一致");
+    for (int kind = 0; kind < 3; kind++) {
+        SeqList A, B;
+        gen(&A, n, kind);
+        gen(&B, n, kind);
+        RSet ra, rb;
+        if (!rs_from_sorted(&ra, A.data, (size_t)A.size) || !rs_from_sorted(&rb, B.data, (size_t)B.size)) {
+            printf("内存不足\n");
+            return 1;
+        }
+        rs_run_optimize(&ra);
+        rs_run_optimize(&rb);
+
+        /* 往返与序列化检查 */
+        bool ok = rs_cardinality(&ra) == (size_t)n && rs_to_sorted(&ra, o1) == (size_t)n && same(o1, A.data, (size_t)n);
+        FILE *f = tmpfile();
+        RSet back;
+        ok = ok && f && rs_serialize(&ra, f);
+        if (f) rewind(f);
+        ok = ok && f && rs_deserialize(&back, f) && rs_to_sorted(&back, o2) == (size_t)n && same(o2, A.data, (size_t)n);
+        if (f) { fclose(f); rs_free(&back); }
+        if (!ok) printf("round-trip FAILED for %s\n", names[kind]);
+
+        double mb_arr = (double)n * sizeof(int) / 1e6, mb_rs = rs_bytes(&ra) / 1e6;
+        const char *ops[] = {"A∩B", "A\\B", "A∪B"};
+        for (int op = 0; op < 3; op++) {
+            double t0 = now_sec();
+            int k1 = op == 0 ? seq_and(&A, &B, o1) : op == 1 ? seq_andnot(&A, &B, o1) : seq_or(&A, &B, o1);
+            double t_arr = now_sec() - t0;
+            RSet r;
+            t0 = now_sec();
+            bool built = op == 0 ? rs_and(&ra, &rb, &r) : op == 1 ? rs_andnot(&ra, &rb, &r) : rs_or(&ra, &rb, &r);
+            double t_rs = now_sec() - t0;
+            size_t k2 = rs_to_sorted(&r, o2);
+            bool eq = built && k2 == (size_t)k1 && same(o1, o2, k2);
+            if (op == 0)
+                printf("%-6s %10.1f %10.1f %7.1f%% | ", names[kind], mb_arr, mb_rs, 100.0 * mb_rs / mb_arr);
+            else
+                printf("%-6s %10s %10s %8s | ", "", "", "", "");
+            printf("%-6s %10.2f %10.2f %8s\n", ops[op], t_arr * 1e3, t_rs * 1e3, eq ? "是" : "否");
+            rs_free(&r);
+        }
+        rs_free(&ra); rs_free(&rb);
+        free(A.data); free(B.data);
+    }
+    free(o1); free(o2);
+    return 0;
+}
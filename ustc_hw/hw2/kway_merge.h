@@ -0,0 +1,280 @@
+/*
+ * k 路归并（2_24.c 中 merge_and_reverse 的推广），header-only
+ *
+ * - 败者树：k 个输入各占一个叶子，耗尽的输入用哨兵（比任何元素都大）代替，
+ *   每输出一个元素只需沿一条根路径比较 log k 次；相等时下标小的输入优先（稳定）
+ * - 链表：只改 next 指针，不分配任何新结点；升序时尾插，降序时头插
+ *   （k = 2 且降序时就是 merge_and_reverse）
+ * - 数组：降序时从输出末尾往前写
+ * - 并行（数组）：按输出位置把结果均分给各线程。k = 2 时用 merge path 在对角线上二分
+ *   求分割点；k > 2 时在值域上二分做多序列划分。各线程的输出区间互不重叠，无需同步
+ *
+ * 败者树需要 O(k) 的工作区：k <= KM_STACK_K 时放在栈上，否则 malloc 一次。
+ */
+#ifndef KWAY_MERGE_H
+#define KWAY_MERGE_H
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+#define KM_STACK_K 1024
+
+/*==================== 败者树 ====================*/
+/*
+ * 树中每个位置存一个 64 位的 (值, 输入下标) 组合：高 32 位是偏移后的值，低 32 位是下标。
+ * 一次无符号比较就同时完成了"值小者胜、相等时下标小者胜"，重赛时可以写成无分支的 min/max。
+ * 耗尽的输入用 KM_INF 作哨兵，它大于任何真实组合。
+ */
+#define KM_INF UINT64_MAX
+
+static inline uint64_t km_pack(int x, int i) {
+    return ((uint64_t)((uint32_t)x ^ 0x80000000u) << 32) | (uint32_t)i;
+}
+static inline int km_value(uint64_t v) { return (int)((uint32_t)(v >> 32) ^ 0x80000000u); }
+static inline int km_source(uint64_t v) { return (int)(uint32_t)v; }
+
+typedef struct {
+    int p;                     /* 叶子数，k 向上取整到 2 的幂 */
+    uint64_t *node;            /* node[1..p) 为内部结点（败者），node[0] 为胜者；node[p..2p) 为叶子 */
+} KmTree;
+
+static inline int km_round_pow2(int k) {
+    int p = 1;
+    while (p < k) p <<= 1;
+    return p;
+}
+
+static uint64_t km_build_at(KmTree *t, int n) {
+    if (n >= t->p) return t->node[n];
+    uint64_t a = km_build_at(t, 2 * n), b = km_build_at(t, 2 * n + 1);
+    t->node[n] = a < b ? b : a;
+    return a < b ? a : b;
+}
+
+/* 调用前填好叶子 node[p + i]（i < k）；多出的叶子补哨兵 */
+static inline void km_build(KmTree *t, int k) {
+    for (int i = k; i < t->p; ++i) t->node[t->p + i] = KM_INF;
+    t->node[0] = t->p == 1 ? t->node[1] : km_build_at(t, 1);
+}
+
+/* 第 w 路的新队首为 v（耗尽为 KM_INF），沿根路径重赛 */
+static inline void km_replay(KmTree *t, int w, uint64_t v) {
+    uint64_t *node = t->node;
+    for (int n = (w + t->p) >> 1; n > 0; n >>= 1) {
+        uint64_t o = node[n];
+        node[n] = o < v ? v : o;
+        v = o < v ? o : v;
+    }
+    node[0] = v;
+}
+
+/* 工作区：k <= KM_STACK_K 时用调用者栈上的 buf，否则 malloc；失败返回 false */
+typedef struct {
+    uint64_t node[2 * KM_STACK_K];
+} KmStackBuf;
+
+static inline bool km_tree_open(KmTree *t, int k, KmStackBuf *buf) {
+    t->p = km_round_pow2(k < 1 ? 1 : k);
+    t->node = t->p <= KM_STACK_K ? buf->node : (uint64_t *)malloc(2 * (size_t)t->p * sizeof(uint64_t));
+    return t->node != NULL;
+}
+
+static inline void km_tree_close(KmTree *t, KmStackBuf *buf) {
+    if (t->node != buf->node) free(t->node);
+}
+
+/*==================== 链表 ====================*/
+/*
+ * 把 k 个递增链表合并为一个，结果存到 *out（升序或降序）。
+ * 只重连 next 指针，不分配结点；lists[] 在返回后不再有意义。工作区分配失败返回 false，链表不变。
+ */
+static inline bool km_merge_lists(struct Node **lists, int k, bool descending, struct Node **out) {
+    KmStackBuf buf;
+    KmTree t;
+    if (!km_tree_open(&t, k, &buf)) return false;
+    for (int i = 0; i < k; ++i) t.node[t.p + i] = lists[i] ? km_pack(lists[i]->data, i) : KM_INF;
+    km_build(&t, k);
+
+    struct Node *head = NULL, *tail = NULL;
+    while (t.node[0] != KM_INF) {
+        int w = km_source(t.node[0]);
+        struct Node *node = lists[w];
+        struct Node *next = node->next;
+        lists[w] = next;
+        km_replay(&t, w, next ? km_pack(next->data, w) : KM_INF);
+        if (descending) {              /* 头插，与 merge_and_reverse 相同 */
+            node->next = head;
+            head = node;
+        } else {                       /* 尾插 */
+            if (tail) tail->next = node;
+            else head = node;
+            tail = node;
+        }
+    }
+    if (tail) tail->next = NULL;
+    km_tree_close(&t, &buf);
+    *out = head;
+    return true;
+}
+
+/*==================== 数组 ====================*/
+/* 合并 k 个递增数组 a[i][0..n[i]) 到 out；降序时从 out 末尾往前写。工作区分配失败返回 false */
+static inline bool km_merge_arrays(const int *const *a, const size_t *n, int k,
+                                   int *out, bool descending) {
+    KmStackBuf buf;
+    KmTree t;
+    if (!km_tree_open(&t, k, &buf)) return false;
+    size_t stack_pos[KM_STACK_K];
+    size_t *pos = k <= KM_STACK_K ? stack_pos : (size_t *)malloc((size_t)k * sizeof(size_t));
+    if (!pos) {
+        km_tree_close(&t, &buf);
+        return false;
+    }
+    size_t total = 0;
+    for (int i = 0; i < k; ++i) {
+        pos[i] = 0;
+        total += n[i];
+        t.node[t.p + i] = n[i] ? km_pack(a[i][0], i) : KM_INF;
+    }
+    km_build(&t, k);
+
+    int *dst = descending ? out + total - 1 : out;
+    ptrdiff_t step = descending ? -1 : 1;
+    for (size_t m = 0; m < total; ++m) {
+        uint64_t v = t.node[0];
+        int w = km_source(v);
+        *dst = km_value(v);
+        dst += step;
+        size_t j = ++pos[w];
+        km_replay(&t, w, j < n[w] ? km_pack(a[w][j], w) : KM_INF);
+    }
+    if (pos != stack_pos) free(pos);
+    km_tree_close(&t, &buf);
+    return true;
+}
+
+/*==================== 并行划分 ====================*/
+static inline size_t km_lower(const int *a, size_t n, long long v) {
+    size_t l = 0, r = n;
+    while (l < r) {
+        size_t m = l + (r - l) / 2;
+        if (a[m] < v) l = m + 1; else r = m;
+    }
+    return l;
+}
+
+/*
+ * merge path：两路归并输出的前 r 个元素中，有 *i 个来自 a、r - *i 个来自 b。
+ * 在第 r 条对角线上二分，找满足 a[i-1] <= b[r-i] 且 b[r-i-1] < a[i] 的 i（相等时 a 优先）。
+ */
+static inline void km_merge_path(const int *a, size_t na, const int *b, size_t nb,
+                                 size_t r, size_t *i) {
+    size_t lo = r > nb ? r - nb : 0, hi = r < na ? r : na;
+    while (lo < hi) {
+        size_t m = lo + (hi - lo) / 2;           /* 取 a 的前 m 个，b 的前 r - m 个 */
+        if (a[m] <= b[r - m - 1]) lo = m + 1;    /* a[m] 应该排在 b[r-m-1] 前面：a 取少了 */
+        else hi = m;
+    }
+    *i = lo;
+}
+
+/*
+ * 多序列划分：求 idx[0..k)，使 Σidx = r，且前 r 个输出恰好是各数组的前 idx[i] 个。
+ * 先在值域上二分出第 r 个输出的值 v，再把等于 v 的元素按数组下标顺序补足（与败者树的平局规则一致）。
+ */
+static inline void km_split(const int *const *a, const size_t *n, int k, size_t r, size_t *idx) {
+    if (k == 2) {
+        km_merge_path(a[0], n[0], a[1], n[1], r, &idx[0]);
+        idx[1] = r - idx[0];
+        return;
+    }
+    long long lo = INT_MIN, hi = (long long)INT_MAX + 1;   /* 找最小的 v 使 count(<= v) > r */
+    while (lo < hi) {
+        long long v = lo + (hi - lo) / 2;
+        size_t c = 0;
+        for (int i = 0; i < k; ++i) c += km_lower(a[i], n[i], v + 1);
+        if (c > r) hi = v; else lo = v + 1;
+    }
+    size_t got = 0;
+    for (int i = 0; i < k; ++i) {
+        idx[i] = km_lower(a[i], n[i], lo);
+        got += idx[i];
+    }
+    for (int i = 0; i < k && got < r; ++i) {
+        size_t eq = km_lower(a[i], n[i], lo + 1) - idx[i];
+        size_t take = r - got < eq ? r - got : eq;
+        idx[i] += take;
+        got += take;
+    }
+}
+
+typedef struct {
+    const int *const *a;
+    const size_t *n;
+    int k;
+    int *out;
+    bool descending;
+    size_t total, r0, r1;
+    bool ok;
+} KmTask;
+
+static void *km_task_main(void *arg) {
+    KmTask *t = (KmTask *)arg;
+    int k = t->k;
+    size_t *lo = (size_t *)malloc(2 * (size_t)k * sizeof(size_t));
+    const int **sub = (const int **)malloc((size_t)k * sizeof(int *));
+    t->ok = lo && sub;
+    if (t->ok) {
+        size_t *hi = lo + k;
+        km_split(t->a, t->n, k, t->r0, lo);
+        km_split(t->a, t->n, k, t->r1, hi);
+        for (int i = 0; i < k; ++i) {
+            sub[i] = t->a[i] + lo[i];
+            hi[i] -= lo[i];                 /* 复用为子数组长度 */
+        }
+        int *dst = t->descending ? t->out + (t->total - t->r1) : t->out + t->r0;
+        t->ok = km_merge_arrays(sub, hi, k, dst, t->descending);
+    }
+    free(lo);
+    free(sub);
+    return NULL;
+}
+
+/* 多线程版 km_merge_arrays：输出按位置均分，nthreads <= 1 时退化为串行 */
+static inline bool km_merge_arrays_parallel(const int *const *a, const size_t *n, int k,
+                                            int *out, bool descending, int nthreads) {
+    size_t total = 0;
+    for (int i = 0; i < k; ++i) total += n[i];
+    if (nthreads > 1 && total < (size_t)nthreads * 4096) nthreads = (int)(total / 4096);
+    if (nthreads <= 1) return km_merge_arrays(a, n, k, out, descending);
+
+    pthread_t *th = (pthread_t *)calloc((size_t)nthreads, sizeof(pthread_t));
+    KmTask *task = (KmTask *)calloc((size_t)nthreads, sizeof(KmTask));
+    bool *spawned = (bool *)calloc((size_t)nthreads, sizeof(bool));
+    bool ok = th && task && spawned;
+    for (int t = 0; ok && t < nthreads; ++t) {
+        task[t] = (KmTask){a, n, k, out, descending, total,
+                           total * (size_t)t / (size_t)nthreads,
+                           total * (size_t)(t + 1) / (size_t)nthreads, false};
+        spawned[t] = pthread_create(&th[t], NULL, km_task_main, &task[t]) == 0;
+        if (!spawned[t]) km_task_main(&task[t]);   /* 创建失败就在当前线程做 */
+    }
+    for (int t = 0; spawned && t < nthreads; ++t)
+        if (spawned[t]) pthread_join(th[t], NULL);
+    for (int t = 0; ok && t < nthreads; ++t) ok = task[t].ok;
+    free(th);
+    free(task);
+    free(spawned);
+    return ok;
+}
+
+#endif /* KWAY_MERGE_H */
@@ -0,0 +1,224 @@
+// k 路归并（kway_merge.h）：正确性检查 + 与两两归并、qsort 的对比，k = 2..1024
+// 编译: gcc -O2 kway_merge_bench.c -o kway_merge_bench -lpthread
+// 用法: kway_merge_bench [总元素数，默认 10000000] [线程数，默认 4]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/bench_util.h"
+#include "kway_merge.h"
+
+/*==================== 2_24.c 原实现 ====================*/
+struct Node* create_node(int data) {
+    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+    if (!new_node) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    new_node->data = data;
+    new_node->next = NULL;
+    return new_node;
+}
+
+struct Node* merge_and_reverse(struct Node* l1, struct Node* l2) {
+    struct Node* merged = NULL;
+    while (l1 != NULL && l2 != NULL) {
+        if (l1->data < l2->data) {
+            struct Node* next = l1->next;
+            l1->next = merged;
+            merged = l1;
+            l1 = next;
+        } else {
+            struct Node* next = l2->next;
+            l2->next = merged;
+            merged = l2;
+            l2 = next;
+        }
+    }
+    while (l1 != NULL) {
+        struct Node* next = l1->next;
+        l1->next = merged;
+        merged = l1;
+        l1 = next;
+    }
+    while (l2 != NULL) {
+        struct Node* next = l2->next;
+        l2->next = merged;
+        merged = l2;
+        l2 = next;
+    }
+    return merged;
+}
+
+void print_list(struct Node* head) {
+    struct Node* curr = head;
+    while (curr != NULL) {
+        printf("%d -> ", curr->data);
+        curr = curr->next;
+    }
+    printf("NULL\n");
+}
+
+/* 对照组：两个递增链表合并为递增链表（尾插） */
+static struct Node* merge_two(struct Node* l1, struct Node* l2) {
+    struct Node dummy, *tail = &dummy;
+    while (l1 && l2) {
+        if (l1->data <= l2->data) { tail->next = l1; l1 = l1->next; }
+        else { tail->next = l2; l2 = l2->next; }
+        tail = tail->next;
+    }
+    tail->next = l1 ? l1 : l2;
+    return dummy.next;
+}
+
+/* 对照组：逐轮两两归并，共 log k 轮 */
+static struct Node* merge_pairwise(struct Node** lists, int k) {
+    for (int step = 1; step < k; step *= 2)
+        for (int i = 0; i + step < k; i += 2 * step)
+            lists[i] = merge_two(lists[i], lists[i + step]);
+    return k ? lists[0] : NULL;
+}
+
+/*==================== 工具 ====================*/
+static int cmp_int(const void *x, const void *y) {
+    int a = *(const int *)x, b = *(const int *)y;
+    return (a > b) - (a < b);
+}
+
+/* 把 total 个随机数分成 k 个递增数组（带重复，长度不均） */
+static void gen_inputs(int k, size_t total, int **a, size_t *n, unsigned seed) {
+    unsigned x = seed;
+    size_t used = 0;
+    for (int i = 0; i < k; ++i) {
+        x = x * 1664525u + 1013904223u;
+        size_t avg = (total - used) / (size_t)(k - i);
+        size_t len = i == k - 1 ? total - used : avg / 2 + (x >> 8) % (avg + 1);
+        a[i] = (int *)malloc((len ? len : 1) * sizeof(int));
+        for (size_t j = 0; j < len; ++j) {
+            x = x * 1664525u + 1013904223u;
+            a[i][j] = (int)(x >> 1) % 1000003 - 500000;
+        }
+        qsort(a[i], len, sizeof(int), cmp_int);
+        n[i] = len;
+        used += len;
+    }
+}
+
+static struct Node *array_to_list(const int *a, size_t n, struct Node *pool) {
+    for (size_t j = 0; j < n; ++j) {
+        pool[j].data = a[j];
+        pool[j].next = j + 1 < n ? &pool[j + 1] : NULL;
+    }
+    return n ? pool : NULL;
+}
+
+static int list_equals(const struct Node *h, const int *ref, size_t n, int descending) {
+    for (size_t j = 0; j < n; ++j, h = h->next)
+        if (!h || h->data != ref[descending ? n - 1 - j : j]) return 0;
+    return h == NULL;
+}
+
+static int array_equals(const int *a, const int *ref, size_t n, int descending) {
+    for (size_t j = 0; j < n; ++j)
+        if (a[j] != ref[descending ? n - 1 - j : j]) return 0;
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    size_t total = argc > 1 ? strtoull(argv[1], NULL, 10) : 10000000;
+    int nthreads = argc > 2 ? atoi(argv[2]) : 4;
+
+    /* 与 2_24.c 相同的小例子：k = 2、降序就是 merge_and_reverse */
+    int v1[] = {1, 3, 5}, v2[] = {2, 4, 6};
+    struct Node p1[3], p2[3];
+    struct Node *lists[2] = {array_to_list(v1, 3, p1), array_to_list(v2, 3, p2)};
+    printf("List 1: ");
+    print_list(lists[0]);
+    printf("List 2: ");
+    print_list(lists[1]);
+    struct Node *merged;
+    km_merge_lists(lists, 2, true, &merged);
+    printf("Merged and Reversed List: ");
+    print_list(merged);
+
+    /* 小规模正确性：各种 k、两个方向、链表/串行数组/并行数组，与 qsort 的结果比对 */
+    int ok = 1;
+    int ks[] = {1, 2, 3, 7, 64, 1000, 1024, 1500};
+    for (size_t c = 0; c < sizeof(ks) / sizeof(ks[0]); ++c) {
+        int k = ks[c];
+        size_t m = 50000;
+        int **a = (int **)malloc((size_t)k * sizeof(int *));
+        size_t *n = (size_t *)malloc((size_t)k * sizeof(size_t));
+        gen_inputs(k, m, a, n, 17u + (unsigned)k);
+        int *ref = (int *)malloc(m * sizeof(int)), *out = (int *)malloc(m * sizeof(int));
+        struct Node *pool = (struct Node *)malloc(m * sizeof(struct Node));
+        struct Node **heads = (struct Node **)malloc((size_t)k * sizeof(struct Node *));
+        size_t off = 0;
+        for (int i = 0; i < k; ++i) { memcpy(ref + off, a[i], n[i] * sizeof(int)); off += n[i]; }
+        qsort(ref, m, sizeof(int), cmp_int);
+        for (int desc = 0; desc <= 1; ++desc) {
+            off = 0;
+            for (int i = 0; i < k; ++i) { heads[i] = array_to_list(a[i], n[i], pool + off); off += n[i]; }
+            struct Node *h;
+            ok &= km_merge_lists(heads, k, desc, &h) && list_equals(h, ref, m, desc);
+            memset(out, 0, m * sizeof(int));
+            ok &= km_merge_arrays((const int *const *)a, n, k, out, desc) && array_equals(out, ref, m, desc);
+            for (int t = 2; t <= 7; t += 5) {
+                memset(out, 0, m * sizeof(int));
+                ok &= km_merge_arrays_parallel((const int *const *)a, n, k, out, desc, t)
+                      && array_equals(out, ref, m, desc);
+            }
+        }
+        for (int i = 0; i < k; ++i) free(a[i]);
+        free(a); free(n); free(ref); free(out); free(pool); free(heads);
+    }
+    printf("正确性检查: %s\n", ok ? "通过" : "失败");
+
+    /* 吞吐 */
+    printf("\n总元素 %zu, 并行线程 %d (单位 ms)\n", total, nthreads);
+    printf("    k   链表两两归并   链表败者树   数组qsort   数组败者树   数组并行\n");
+    struct Node *pool = (struct Node *)malloc(total * sizeof(struct Node));
+    int *out = (int *)malloc(total * sizeof(int));
+    for (int k = 2; k <= 1024; k *= k < 16 ? 8 : 4) {
+        int **a = (int **)malloc((size_t)k * sizeof(int *));
+        size_t *n = (size_t *)malloc((size_t)k * sizeof(size_t));
+        struct Node **heads = (struct Node **)malloc((size_t)k * sizeof(struct Node *));
+        gen_inputs(k, total, a, n, 99u + (unsigned)k);
+        double t0, t_pair, t_lt, t_qs, t_arr, t_par;
+        size_t off;
+
+        off = 0;
+        for (int i = 0; i < k; ++i) { heads[i] = array_to_list(a[i], n[i], pool + off); off += n[i]; }
+        t0 = now_sec();
+        merge_pairwise(heads, k);
+        t_pair = now_sec() - t0;
+
+        off = 0;
+        for (int i = 0; i < k; ++i) { heads[i] = array_to_list(a[i], n[i], pool + off); off += n[i]; }
+        struct Node *h;
+        t0 = now_sec();
+        km_merge_lists(heads, k, false, &h);
+        t_lt = now_sec() - t0;
+
+        off = 0;
+        for (int i = 0; i < k; ++i) { memcpy(out + off, a[i], n[i] * sizeof(int)); off += n[i]; }
+        t0 = now_sec();
+        qsort(out, total, sizeof(int), cmp_int);
+        t_qs = now_sec() - t0;
+
+        t0 = now_sec();
+        km_merge_arrays((const int *const *)a, n, k, out, false);
+        t_arr = now_sec() - t0;
+
+        t0 = now_sec();
+        km_merge_arrays_parallel((const int *const *)a, n, k, out, false, nthreads);
+        t_par = now_sec() - t0;
+
+        printf("%5d   %12.1f   %10.1f   %9.1f   %10.1f   %8.1f\n",
+               k, t_pair * 1e3, t_lt * 1e3, t_qs * 1e3, t_arr * 1e3, t_par * 1e3);
+        for (int i = 0; i < k; ++i) free(a[i]);
+        free(a); free(n); free(heads);
+    }
+    free(pool);
+    free(out);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+/*
+ * 无锁有序链表（2_19.c 中 add_node / delete_range 的并发版本），header-only，C11
+ *
+ * - Harris-Michael 标记指针：next 的最低位为 1 表示该结点已被逻辑删除，
+ *   之后任何对它 next 的 CAS 都会失败，因此不会有新结点挂到已删除结点后面
+ * - 插入、查找、区间删除都是无锁的；遍历者可以与删除者同时运行
+ * - 区间删除：先沿链逐个打标记，再用一次 CAS 把整段从前驱上摘下并整体退休；
+ *   CAS 失败（前驱被改动）时交给 lf_find 逐个清理
+ * - 内存回收用基于纪元（epoch）的方案：被摘下的结点先挂在线程本地的 limbo 表里，
+ *   全局纪元前进两次后才真正 free，保证没有线程还持有它的引用
+ *
+ * 用法：每个线程先 lf_register 得到句柄，之后所有操作都带上句柄；线程结束前 lf_unregister。
+ * 与 delete_range 语义一致：删除 mink < x < maxk 的元素。
+ */
+#ifndef LOCKFREE_LIST_H
+#define LOCKFREE_LIST_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define LF_MAX_THREADS 128
+#define LF_RETIRE_BATCH 64     /* 每退休这么多结点尝试推进一次纪元 */
+
+typedef struct LfNode {
+    int key;
+    _Atomic uintptr_t next;    /* 最低位为删除标记 */
+    struct LfNode *limbo;      /* 退休后在 limbo 表中的链接，不影响仍在遍历的线程 */
+} LfNode;
+
+#define LF_MARK ((uintptr_t)1)
+#define LF_PTR(v) ((LfNode *)((v) & ~LF_MARK))
+
+/* 每个线程一个槽位，按缓存行对齐，避免纪元扫描时的伪共享 */
+typedef struct {
+    _Alignas(64) _Atomic unsigned long state;   /* 0 = 不在临界区；否则 (纪元 << 1) | 1 */
+    _Atomic int in_use;
+    LfNode *bucket[3];             /* 按纪元 % 3 分组的待回收结点 */
+    unsigned long tag[3];          /* 对应分组退休时的全局纪元 */
+    size_t pending;
+} LfThread;
+
+typedef struct {
+    _Atomic uintptr_t head;        /* 指向第一个结点，本身不会被标记 */
+    _Atomic unsigned long epoch;
+    _Atomic int nslots;            /* 曾经用过的最大槽位数 */
+    LfThread slot[LF_MAX_THREADS];
+} LfList;
+
+/*==================== 纪元回收 ====================*/
+static inline void lf_free_chain(LfNode *p) {
+    while (p) {
+        LfNode *n = p->limbo;
+        free(p);
+        p = n;
+    }
+}
+
+/* 释放所有至少落后全局纪元两代的分组 */
+static inline void lf_reclaim(LfThread *t, unsigned long g) {
+    for (int i = 0; i < 3; ++i) {
+        if (t->bucket[i] && t->tag[i] + 2 <= g) {
+            lf_free_chain(t->bucket[i]);
+            t->bucket[i] = NULL;
+        }
+    }
+}
+
+/* 所有处于临界区的线程都已看到当前纪元时，推进一代 */
+static inline void lf_try_advance(LfList *L) {
+    unsigned long g = atomic_load(&L->epoch);
+    int n = atomic_load(&L->nslots);
+    for (int i = 0; i < n; ++i) {
+        unsigned long s = atomic_load(&L->slot[i].state);
+        if ((s & 1) && (s >> 1) != g) return;
+    }
+    atomic_compare_exchange_strong(&L->epoch, &g, g + 1);
+}
+
+static inline void lf_enter(LfList *L, LfThread *t) {
+    unsigned long g = atomic_load(&L->epoch);
+    atomic_store(&t->state, (g << 1) | 1);
+    lf_reclaim(t, g);
+}
+
+static inline void lf_exit(LfThread *t) {
+    atomic_store_explicit(&t->state, 0, memory_order_release);
+}
+
+/* 只能由把 p 从链上摘下的那个线程调用，且必须在临界区内 */
+static inline void lf_retire(LfList *L, LfThread *t, LfNode *p) {
+    unsigned long g = atomic_load(&L->epoch);
+    int b = (int)(g % 3);
+    if (t->bucket[b] && t->tag[b] != g) {     /* 该分组的纪元不晚于 g - 3，早已安全 */
+        lf_free_chain(t->bucket[b]);
+        t->bucket[b] = NULL;
+    }
+    p->limbo = t->bucket[b];
+    t->bucket[b] = p;
+    t->tag[b] = g;
+    if (++t->pending % LF_RETIRE_BATCH == 0) {
+        lf_try_advance(L);
+        lf_reclaim(t, atomic_load(&L->epoch));
+    }
+}
+
+/*==================== 初始化与线程注册 ====================*/
+static inline void lf_init(LfList *L) {
+    atomic_init(&L->head, 0);
+    atomic_init(&L->epoch, 2);
+    atomic_init(&L->nslots, 0);
+    for (int i = 0; i < LF_MAX_THREADS; ++i) {
+        LfThread *t = &L->slot[i];
+        atomic_init(&t->state, 0);
+        atomic_init(&t->in_use, 0);
+        for (int b = 0; b < 3; ++b) { t->bucket[b] = NULL; t->tag[b] = 0; }
+        t->pending = 0;
+    }
+}
+
+/* 占用一个空闲槽位；槽位用完返回 NULL。槽位里残留的 limbo 结点由新主人继续回收 */
+static inline LfThread *lf_register(LfList *L) {
+    for (int i = 0; i < LF_MAX_THREADS; ++i) {
+        int expect = 0;
+        if (atomic_compare_exchange_strong(&L->slot[i].in_use, &expect, 1)) {
+            int n = atomic_load(&L->nslots);
+            while (n < i + 1 && !atomic_compare_exchange_weak(&L->nslots, &n, i + 1)) {}
+            return &L->slot[i];
+        }
+    }
+    return NULL;
+}
+
+static inline void lf_unregister(LfList *L, LfThread *t) {
+    lf_try_advance(L);
+    lf_reclaim(t, atomic_load(&L->epoch));
+    atomic_store(&t->in_use, 0);
+}
+
+/* 只能在没有其他线程访问时调用 */
+static inline void lf_destroy(LfList *L) {
+    LfNode *p = LF_PTR(atomic_load(&L->head));
+    while (p) {
+        LfNode *n = LF_PTR(atomic_load_explicit(&p->next, memory_order_relaxed));
+        free(p);
+        p = n;
+    }
+    atomic_store(&L->head, 0);
+    for (int i = 0; i < LF_MAX_THREADS; ++i)
+        for (int b = 0; b < 3; ++b) {
+            lf_free_chain(L->slot[i].bucket[b]);
+            L->slot[i].bucket[b] = NULL;
+        }
+}
+
+/*==================== 链表操作 ====================*/
+/*
+ * 找到第一个 key >= x 且未被标记的结点 *cur，*prev 是指向它的那个链接字段。
+ * 途中遇到被标记的结点就顺手摘掉（摘成功的线程负责退休）。必须在临界区内调用。
+ */
+static inline void lf_find(LfList *L, LfThread *t, long long x,
+                           _Atomic uintptr_t **prev, LfNode **cur) {
+retry:;
+    _Atomic uintptr_t *p = &L->head;
+    LfNode *c = LF_PTR(atomic_load_explicit(p, memory_order_acquire));
+    while (c) {
+        uintptr_t nx = atomic_load_explicit(&c->next, memory_order_acquire);
+        if (nx & LF_MARK) {
+            uintptr_t expect = (uintptr_t)c;
+            if (!atomic_compare_exchange_strong_explicit(p, &expect, nx & ~LF_MARK,
+                                                         memory_order_acq_rel, memory_order_acquire))
+                goto retry;
+            lf_retire(L, t, c);
+            c = LF_PTR(nx);
+            continue;
+        }
+        if (c->key >= x) break;
+        p = &c->next;
+        c = LF_PTR(nx);
+    }
+    *prev = p;
+    *cur = c;
+}
+
+static inline bool lf_contains(LfList *L, LfThread *t, int x) {
+    lf_enter(L, t);
+    bool found = false;
+    LfNode *c = LF_PTR(atomic_load_explicit(&L->head, memory_order_acquire));
+    while (c) {                     /* 只读遍历，不帮忙摘结点 */
+        uintptr_t nx = atomic_load_explicit(&c->next, memory_order_acquire);
+        if (c->key >= x) {
+            found = c->key == x && !(nx & LF_MARK);
+            break;
+        }
+        c = LF_PTR(nx);
+    }
+    lf_exit(t);
+    return found;
+}
+
+/* 插入 x；已存在或内存不足返回 false */
+static inline bool lf_insert(LfList *L, LfThread *t, int x) {
+    LfNode *n = (LfNode *)malloc(sizeof(LfNode));
+    if (!n) return false;
+    n->key = x;
+    n->limbo = NULL;
+    lf_enter(L, t);
+    for (;;) {
+        _Atomic uintptr_t *p;
+        LfNode *c;
+        lf_find(L, t, x, &p, &c);
+        if (c && c->key == x) {
+            lf_exit(t);
+            free(n);
+            return false;
+        }
+        atomic_store_explicit(&n->next, (uintptr_t)c, memory_order_relaxed);
+        uintptr_t expect = (uintptr_t)c;
+        if (atomic_compare_exchange_strong_explicit(p, &expect, (uintptr_t)n,
+                                                    memory_order_release, memory_order_relaxed))
+            break;
+    }
+    lf_exit(t);
+    return true;
+}
+
+/* 删除 mink < x < maxk 的所有元素，返回本线程删掉的个数 */
+static inline size_t lf_delete_range(LfList *L, LfThread *t, int mink, int maxk) {
+    long long lo = (long long)mink + 1, hi = (long long)maxk - 1;
+    if (lo > hi) return 0;
+    lf_enter(L, t);
+    _Atomic uintptr_t *p;
+    LfNode *first, *c, *last = NULL;
+    size_t removed = 0;
+    lf_find(L, t, lo, &p, &first);
+
+    /* 逐个打标记：被标记的结点 next 不再变化，整段因此被冻结 */
+    for (c = first; c && c->key <= hi;) {
+        uintptr_t nx = atomic_fetch_or_explicit(&c->next, LF_MARK, memory_order_acq_rel);
+        if (!(nx & LF_MARK)) removed++;
+        last = c;
+        c = LF_PTR(nx);
+    }
+    if (last) {
+        /* 段内结点都已标记，只有前驱能指向 first，一次 CAS 摘下整段 */
+        uintptr_t expect = (uintptr_t)first;
+        if (atomic_compare_exchange_strong_explicit(p, &expect, (uintptr_t)c,
+                                                    memory_order_acq_rel, memory_order_acquire)) {
+            for (LfNode *q = first; q != c;) {
+                LfNode *n = LF_PTR(atomic_load_explicit(&q->next, memory_order_relaxed));
+                lf_retire(L, t, q);
+                q = n;
+            }
+        } else {
+            LfNode *dummy;
+            lf_find(L, t, hi + 1, &p, &dummy);     /* 逐个清理剩余的标记结点 */
+        }
+    }
+    lf_exit(t);
+    return removed;
+}
+
+/* 按升序访问所有未删除的元素；可与其他线程的修改并发（看到的是某个中间状态） */
+static inline void lf_foreach(LfList *L, LfThread *t, void (*visit)(int, void *), void *arg) {
+    lf_enter(L, t);
+    LfNode *c = LF_PTR(atomic_load_explicit(&L->head, memory_order_acquire));
+    while (c) {
+        uintptr_t nx = atomic_load_explicit(&c->next, memory_order_acquire);
+        if (!(nx & LF_MARK)) visit(c->key, arg);
+        c = LF_PTR(nx);
+    }
+    lf_exit(t);
+}
+
+#endif /* LOCKFREE_LIST_H */
@@ -0,0 +1,188 @@
+// 无锁有序链表（lockfree_list.h）：并发正确性检查 + 读/插入/区间删除混合负载吞吐
+// 编译: gcc -O2 lockfree_list_bench.c -o lockfree_list_bench -lpthread
+// 检查数据竞争: gcc -O1 -g -fsanitize=thread lockfree_list_bench.c -o lockfree_list_tsan -lpthread
+// 用法: lockfree_list_bench [最大线程数，默认 64] [每轮毫秒数，默认 300]
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../include/bench_util.h"
+#include "lockfree_list.h"
+
+static unsigned xorshift(unsigned *s) {
+    *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5;
+    return *s;
+}
+
+static void print_key(int x, void *arg) {
+    (void)arg;
+    printf("%d -> ", x);
+}
+
+/*==================== 并发正确性检查 ====================*/
+typedef struct {
+    LfList *L;
+    int id, ops, key_range;
+    size_t inserted, removed, bad_order;
+} CheckArg;
+
+static void check_order(int x, void *arg) {
+    long long *prev = (long long *)arg;
+    if (x <= *prev) prev[1]++;
+    prev[0] = x;
+}
+
+static void *check_worker(void *p) {
+    CheckArg *a = (CheckArg *)p;
+    LfThread *t = lf_register(a->L);
+    unsigned s = 0x9e3779b9u * (unsigned)(a->id + 1);
+    for (int i = 0; i < a->ops; ++i) {
+        unsigned r = xorshift(&s);
+        int x = (int)(xorshift(&s) % (unsigned)a->key_range);
+        switch (r % 8) {
+        case 0:
+            a->removed += lf_delete_range(a->L, t, x, x + 1 + (int)(r >> 8) % 32);
+            break;
+        case 1: {           /* 遍历者：并发修改下看到的序列也必须严格递增 */
+            long long st[2] = {-1, 0};
+            lf_foreach(a->L, t, check_order, st);
+            a->bad_order += (size_t)st[1];
+            break;
+        }
+        case 2: case 3:
+            lf_contains(a->L, t, x);
+            break;
+        default:
+            a->inserted += lf_insert(a->L, t, x);
+        }
+    }
+    lf_unregister(a->L, t);
+    return NULL;
+}
+
+static void count_key(int x, void *arg) {
+    (void)x;
+    ++*(size_t *)arg;
+}
+
+static int run_check(int nthreads, int ops, int key_range) {
+    static LfList L;
+    lf_init(&L);
+    pthread_t th[LF_MAX_THREADS];
+    CheckArg arg[LF_MAX_THREADS];
+    for (int i = 0; i < nthreads; ++i) {
+        arg[i] = (CheckArg){&L, i, ops, key_range, 0, 0, 0};
+        pthread_create(&th[i], NULL, check_worker, &arg[i]);
+    }
+    size_t ins = 0, del = 0, bad = 0;
+    for (int i = 0; i < nthreads; ++i) {
+        pthread_join(th[i], NULL);
+        ins += arg[i].inserted;
+        del += arg[i].removed;
+        bad += arg[i].bad_order;
+    }
+    /* 每个元素要么还在表中，要么恰好被某个线程删掉一次 */
+    LfThread *t = lf_register(&L);
+    size_t left = 0;
+    long long st[2] = {-1, 0};
+    lf_foreach(&L, t, count_key, &left);
+    lf_foreach(&L, t, check_order, st);
+    lf_unregister(&L, t);
+    lf_destroy(&L);
+    int ok = bad == 0 && st[1] == 0 && ins == left + del;
+    printf("  %2d 线程: 插入 %zu, 删除 %zu, 剩余 %zu, 乱序 %zu -> %s\n",
+           nthreads, ins, del, left, bad + (size_t)st[1], ok ? "通过" : "失败");
+    return ok;
+}
+
+/*==================== 吞吐测试 ====================*/
+typedef struct {
+    LfList *L;
+    int id, key_range;
+    int read_pct, insert_pct;          /* 其余为区间删除 */
+    _Atomic int *stop;
+    size_t ops;
+} BenchArg;
+
+static void *bench_worker(void *p) {
+    BenchArg *a = (BenchArg *)p;
+    LfThread *t = lf_register(a->L);
+    unsigned s = 0x85ebca6bu * (unsigned)(a->id + 7);
+    size_t ops = 0;
+    while (!atomic_load_explicit(a->stop, memory_order_relaxed)) {
+        for (int i = 0; i < 64; ++i) {
+            unsigned r = xorshift(&s) % 100;
+            int x = (int)(xorshift(&s) % (unsigned)a->key_range);
+            if ((int)r < a->read_pct) lf_contains(a->L, t, x);
+            else if ((int)r < a->read_pct + a->insert_pct) lf_insert(a->L, t, x);
+            else lf_delete_range(a->L, t, x, x + 17);   /* 平均删掉约 8 个元素 */
+        }
+        ops += 64;
+    }
+    a->ops = ops;
+    lf_unregister(a->L, t);
+    return NULL;
+}
+
+static double run_bench(int nthreads, int ms, int key_range, int read_pct, int insert_pct) {
+    static LfList L;
+    lf_init(&L);
+    LfThread *t = lf_register(&L);
+    for (int x = 0; x < key_range; x += 2) lf_insert(&L, t, x);   /* 预填一半 */
+    lf_unregister(&L, t);
+
+    _Atomic int stop = 0;
+    pthread_t th[LF_MAX_THREADS];
+    BenchArg arg[LF_MAX_THREADS];
+    double t0 = now_sec();
+    for (int i = 0; i < nthreads; ++i) {
+        arg[i] = (BenchArg){&L, i, key_range, read_pct, insert_pct, &stop, 0};
+        pthread_create(&th[i], NULL, bench_worker, &arg[i]);
+    }
+    struct timespec d = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&d, NULL);
+    atomic_store(&stop, 1);
+    size_t total = 0;
+    for (int i = 0; i < nthreads; ++i) {
+        pthread_join(th[i], NULL);
+        total += arg[i].ops;
+    }
+    double sec = now_sec() - t0;
+    lf_destroy(&L);
+    return total / sec / 1e6;
+}
+
+int main(int argc, char **argv) {
+    int maxt = argc > 1 ? atoi(argv[1]) : 64;
+    int ms = argc > 2 ? atoi(argv[2]) : 300;
+    if (maxt < 1) maxt = 1;
+    if (maxt > LF_MAX_THREADS) maxt = LF_MAX_THREADS;
+
+    /* 与 2_19.c 相同的小例子 */
+    static LfList demo;
+    lf_init(&demo);
+    LfThread *t = lf_register(&demo);
+    for (int x = 1; x <= 9; ++x) lf_insert(&demo, t, x);
+    printf("Original list: \n");
+    lf_foreach(&demo, t, print_key, NULL);
+    printf("NULL\n");
+    lf_delete_range(&demo, t, 4, 8);
+    printf("List after deleting nodes with values in range [%d, %d]: \n", 4, 8);
+    lf_foreach(&demo, t, print_key, NULL);
+    printf("NULL\n");
+    lf_unregister(&demo, t);
+    lf_destroy(&demo);
+
+    printf("\n并发正确性检查:\n");
+    int ok = 1;
+    for (int n = 2; n <= maxt; n *= 4) ok &= run_check(n, 20000, 512);
+
+    printf("\n混合负载吞吐 (键空间 4096, 每轮 %d ms):\n", ms);
+    printf("线程   90%%读/9%%插/1%%删   50%%读/40%%插/10%%删   (Mops/s)\n");
+    for (int n = 1; n <= maxt; n *= 2) {
+        double a = run_bench(n, ms, 4096, 90, 9);
+        double b = run_bench(n, ms, 4096, 50, 40);
+        printf("%4d   %16.2f   %18.2f\n", n, a, b);
+    }
+    return ok ? 0 : 1;
+}
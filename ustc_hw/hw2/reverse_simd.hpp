@@ -0,0 +1,277 @@
+/*
+ * 原地反转与循环移位（2_21.c 中 reverse_seq_list / reverse_array 的扩展版），header-only，C++17
+ *
+ * reverse_array 每轮交换一个 int。这里：
+ * - SIMD 反转：从两端各读一个向量（AVX2 32 字节 / SSE2 16 字节），在寄存器内按元素宽度
+ *   反转 lane，再交叉写回；元素宽度支持 1/2/4/8/16 字节，其他宽度退化为逐元素交换
+ * - 多线程反转：把 n/2 个"对称位置对"均分给各线程，每个线程处理前端一段与后端对应的一段，互不重叠
+ * - 循环左移 k 位，两种实现：
+ *     三次反转：reverse(A) reverse(B) reverse(AB)，全部走上面的 SIMD/多线程反转
+ *     块交换（Gries-Mills）：反复把较短的一块与另一端等长的一块整体交换，交换用 SIMD 拷贝
+ *   较短的一块不超过 4KB 时两者都改用"存到栈上 + 一次 memmove"
+ *
+ * 用法：
+ *   rev::reverse(T*, n, threads) / rev::rotate_left(T*, n, k, rev::Rotate::Reversal, threads)
+ *   元素宽度只在运行时知道时：rev::reverse_raw(ptr, n, width, threads) / rev::rotate_left_raw(...)
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define REV_HAVE_SSE2 1
+#endif
+
+namespace rev {
+
+using byte = unsigned char;
+
+/* ========== 寄存器内按元素反转 ========== */
+#if defined(__AVX2__)
+constexpr std::size_t kVec = 32;
+using Vec = __m256i;
+static inline Vec vload(const byte *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+static inline void vstore(byte *p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+
+template <std::size_t W> static inline Vec vrev(Vec v);
+template <> inline Vec vrev<1>(Vec v) {
+    const __m256i m = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                       15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, m), 0x4E);
+}
+template <> inline Vec vrev<2>(Vec v) {
+    const __m256i m = _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                       14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, m), 0x4E);
+}
+template <> inline Vec vrev<4>(Vec v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+template <> inline Vec vrev<8>(Vec v) { return _mm256_permute4x64_epi64(v, 0x1B); }
+template <> inline Vec vrev<16>(Vec v) { return _mm256_permute4x64_epi64(v, 0x4E); }
+
+#elif defined(REV_HAVE_SSE2)
+constexpr std::size_t kVec = 16;
+using Vec = __m128i;
+static inline Vec vload(const byte *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+static inline void vstore(byte *p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+
+template <std::size_t W> static inline Vec vrev(Vec v);
+template <> inline Vec vrev<2>(Vec v) {
+    v = _mm_shufflelo_epi16(v, 0x1B);
+    v = _mm_shufflehi_epi16(v, 0x1B);
+    return _mm_shuffle_epi32(v, 0x4E);
+}
+template <> inline Vec vrev<1>(Vec v) {     /* 先按 16 位反转，再交换每个 16 位里的两个字节 */
+    v = vrev<2>(v);
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+template <> inline Vec vrev<4>(Vec v) { return _mm_shuffle_epi32(v, 0x1B); }
+template <> inline Vec vrev<8>(Vec v) { return _mm_shuffle_epi32(v, 0x4E); }
+template <> inline Vec vrev<16>(Vec v) { return v; }
+#endif
+
+/* ========== 核心：front[i] <-> back[count-1-i]，两段不重叠 ========== */
+template <std::size_t W>
+static void swap_reversed(byte *front, byte *back, std::size_t count) {
+    byte *f = front, *b = back + count * W;      /* b 指向后段末尾，向前走 */
+#if defined(REV_HAVE_SSE2)
+    if constexpr (kVec >= W) {
+        constexpr std::size_t E = kVec / W;       /* 每个向量的元素数 */
+        std::size_t k = 0;
+        for (; count - k >= 2 * E; k += 2 * E) {
+            Vec f0 = vload(f), f1 = vload(f + kVec);
+            Vec b0 = vload(b - kVec), b1 = vload(b - 2 * kVec);
+            vstore(f, vrev<W>(b0));
+            vstore(f + kVec, vrev<W>(b1));
+            vstore(b - kVec, vrev<W>(f0));
+            vstore(b - 2 * kVec, vrev<W>(f1));
+            f += 2 * kVec;
+            b -= 2 * kVec;
+        }
+        for (; count - k >= E; k += E) {
+            Vec f0 = vload(f), b0 = vload(b - kVec);
+            vstore(f, vrev<W>(b0));
+            vstore(b - kVec, vrev<W>(f0));
+            f += kVec;
+            b -= kVec;
+        }
+        count -= k;
+    }
+#endif
+    byte tmp[W];
+    for (std::size_t i = 0; i < count; ++i) {
+        b -= W;
+        std::memcpy(tmp, f, W);
+        std::memcpy(f, b, W);
+        std::memcpy(b, tmp, W);
+        f += W;
+    }
+}
+
+/* 任意宽度的退化版本 */
+static inline void swap_reversed_any(byte *front, byte *back, std::size_t count, std::size_t w) {
+    byte *b = back + count * w;
+    for (std::size_t i = 0; i < count; ++i) {
+        b -= w;
+        for (std::size_t j = 0; j < w; ++j) {
+            byte t = front[i * w + j];
+            front[i * w + j] = b[j];
+            b[j] = t;
+        }
+    }
+}
+
+static inline void swap_reversed_dispatch(byte *front, byte *back, std::size_t count, std::size_t w) {
+    switch (w) {
+    case 1: swap_reversed<1>(front, back, count); break;
+    case 2: swap_reversed<2>(front, back, count); break;
+    case 4: swap_reversed<4>(front, back, count); break;
+    case 8: swap_reversed<8>(front, back, count); break;
+    case 16: swap_reversed<16>(front, back, count); break;
+    default: swap_reversed_any(front, back, count, w);
+    }
+}
+
+/* 每个线程至少分到这么多字节才值得开线程 */
+constexpr std::size_t kParallelMinBytes = std::size_t(1) << 20;
+
+/* 把 [0, total) 均分成 parts 份，对每份调用 fn(lo, hi)；第 0 份在当前线程做 */
+template <typename Fn>
+static void parallel_for(std::size_t total, unsigned parts, Fn fn) {
+    if (parts <= 1) {
+        fn(std::size_t(0), total);
+        return;
+    }
+    std::vector<std::thread> th;
+    th.reserve(parts - 1);
+    for (unsigned t = 1; t < parts; ++t) {
+        std::size_t lo = total * t / parts, hi = total * (t + 1) / parts;
+        th.emplace_back([=] { fn(lo, hi); });
+    }
+    fn(std::size_t(0), total / parts);
+    for (auto &x : th) x.join();
+}
+
+static inline unsigned clamp_threads(unsigned threads, std::size_t bytes) {
+    std::size_t cap = bytes / kParallelMinBytes;
+    if (cap < 1) cap = 1;
+    return threads == 0 ? 1 : (threads > cap ? static_cast<unsigned>(cap) : threads);
+}
+
+/* ========== 反转 ========== */
+inline void reverse_raw(void *base, std::size_t n, std::size_t width, unsigned threads = 1) {
+    if (n < 2 || width == 0) return;
+    byte *p = static_cast<byte *>(base);
+    std::size_t pairs = n / 2;
+    byte *back = p + (n - pairs) * width;         /* 奇数长度时正中间的元素不动 */
+    parallel_for(pairs, clamp_threads(threads, n * width), [=](std::size_t lo, std::size_t hi) {
+        swap_reversed_dispatch(p + lo * width, back + (pairs - hi) * width, hi - lo, width);
+    });
+}
+
+/* ========== 交换两段等长、不重叠的字节区间 ========== */
+static inline void swap_bytes(byte *a, byte *b, std::size_t len) {
+    std::size_t i = 0;
+#if defined(REV_HAVE_SSE2)
+    for (; i + kVec <= len; i += kVec) {
+        Vec x = vload(a + i), y = vload(b + i);
+        vstore(a + i, y);
+        vstore(b + i, x);
+    }
+#endif
+    for (; i < len; ++i) {
+        byte t = a[i];
+        a[i] = b[i];
+        b[i] = t;
+    }
+}
+
+inline void swap_ranges(void *a, void *b, std::size_t bytes, unsigned threads = 1) {
+    byte *x = static_cast<byte *>(a), *y = static_cast<byte *>(b);
+    parallel_for(bytes, clamp_threads(threads, bytes), [=](std::size_t lo, std::size_t hi) {
+        swap_bytes(x + lo, y + lo, hi - lo);
+    });
+}
+
+/* ========== 循环左移 ========== */
+enum class Rotate { Reversal, BlockSwap };
+
+/* 较短的一块不超过这么多字节时，先存到栈上，memmove 另一块，再放回去 */
+constexpr std::size_t kSmallRotateBytes = 4096;
+
+/* [0, len) 左移 k 个元素，要求 min(k, len-k) * width <= kSmallRotateBytes */
+static inline void rotate_small(byte *p, std::size_t len, std::size_t k, std::size_t width) {
+    byte tmp[kSmallRotateBytes];
+    std::size_t a = k * width, b = (len - k) * width;
+    if (a <= b) {
+        std::memcpy(tmp, p, a);
+        std::memmove(p, p + a, b);
+        std::memcpy(p + b, tmp, a);
+    } else {
+        std::memcpy(tmp, p + a, b);
+        std::memmove(p + b, p, a);
+        std::memcpy(p, tmp, b);
+    }
+}
+
+/* 把 [0, n) 循环左移 k 个元素：原来的 base[k] 成为新的 base[0] */
+inline void rotate_left_raw(void *base, std::size_t n, std::size_t width, std::size_t k,
+                            Rotate algo = Rotate::Reversal, unsigned threads = 1) {
+    if (n == 0 || width == 0) return;
+    k %= n;
+    if (k == 0) return;
+    byte *p = static_cast<byte *>(base);
+    if (std::min(k, n - k) * width <= kSmallRotateBytes) {
+        rotate_small(p, n, k, width);
+        return;
+    }
+    if (algo == Rotate::Reversal) {
+        reverse_raw(p, k, width, threads);
+        reverse_raw(p + k * width, n - k, width, threads);
+        reverse_raw(p, n, width, threads);
+        return;
+    }
+    /*
+     * Gries-Mills：A = [k-i, k)，B = [k, k+j)，每轮把短块与长块靠外的等长部分对调，
+     * 短块本身就到了最终位置。短块缩到 kSmallRotateBytes 以内后，剩下的部分一次 memmove 收尾
+     */
+    std::size_t i = k, j = n - k;
+    while (i != j) {
+        if (std::min(i, j) * width <= kSmallRotateBytes) {
+            rotate_small(p + (k - i) * width, i + j, i, width);
+            return;
+        }
+        if (i < j) {
+            swap_ranges(p + (k - i) * width, p + (k + j - i) * width, i * width, threads);
+            j -= i;
+        } else {
+            swap_ranges(p + (k - i) * width, p + k * width, j * width, threads);
+            i -= j;
+        }
+    }
+    swap_ranges(p + (k - i) * width, p + k * width, i * width, threads);
+}
+
+/* ========== 带类型的包装 ========== */
+template <typename T>
+inline void reverse(T *p, std::size_t n, unsigned threads = 1) {
+    static_assert(std::is_trivially_copyable<T>::value, "只支持可按字节拷贝的类型");
+    reverse_raw(p, n, sizeof(T), threads);
+}
+
+template <typename T>
+inline void rotate_left(T *p, std::size_t n, std::size_t k, Rotate algo = Rotate::Reversal,
+                        unsigned threads = 1) {
+    static_assert(std::is_trivially_copyable<T>::value, "只支持可按字节拷贝的类型");
+    rotate_left_raw(p, n, sizeof(T), k, algo, threads);
+}
+
+}  // namespace rev
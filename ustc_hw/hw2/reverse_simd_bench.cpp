@@ -0,0 +1,150 @@
+/*
+ * reverse_simd.hpp 的正确性检查与测速（GB/s，按数组字节数计）
+ * - 反转：reverse_array 式的逐元素交换 / std::reverse / SIMD 单线程 / SIMD 多线程，元素宽度 1~16 字节
+ * - 循环左移：std::rotate / 三次反转 / 块交换
+ *
+ * 编译: g++ -std=c++17 -O2 -mavx2 reverse_simd_bench.cpp -o reverse_simd_bench -lpthread
+ *       （不加 -mavx2 则用 SSE2）
+ * 用法: reverse_simd_bench [缓冲区 MB，默认 256] [线程数，默认硬件线程数]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../../include/bench_util.h"
+#include "reverse_simd.hpp"
+
+/* 16 字节元素 */
+struct Elem16 {
+    std::uint64_t lo, hi;
+    bool operator==(const Elem16 &o) const { return lo == o.lo && hi == o.hi; }
+};
+
+/* 与 2_21.c 的 reverse_array 相同，只是元素类型可变 */
+template <typename T>
+void reverse_array(T *arr, long size) {
+    long left = 0;
+    long right = size - 1;
+    while (left < right) {
+        T temp = arr[left];
+        arr[left] = arr[right];
+        arr[right] = temp;
+        left++;
+        right--;
+    }
+}
+
+/* 取 3 次中最快的一次 */
+template <typename Fn>
+static double best_of(Fn fn) {
+    double best = 1e30;
+    for (int r = 0; r < 3; ++r) {
+        double t0 = now_sec();
+        fn();
+        best = std::min(best, now_sec() - t0);
+    }
+    return best;
+}
+
+template <typename T>
+static void fill(T *p, std::size_t n) {
+    unsigned char *b = reinterpret_cast<unsigned char *>(p);
+    for (std::size_t i = 0; i < n * sizeof(T); ++i) b[i] = static_cast<unsigned char>(i * 131 + (i >> 9));
+}
+
+/* 小规模正确性：各种长度、线程数、移位距离都与 std::reverse / std::rotate 比对 */
+template <typename T>
+static bool check_width() {
+    bool ok = true;
+    for (std::size_t n : {0, 1, 2, 3, 7, 31, 32, 33, 63, 64, 65, 127, 1000, 4099, 300001}) {
+        std::vector<T> a(n), ref;
+        fill(a.data(), n);
+        ref = a;
+        std::reverse(ref.begin(), ref.end());
+        for (unsigned th : {1u, 3u}) {
+            std::vector<T> b = a;
+            rev::reverse(b.data(), n, th);
+            ok &= b == ref;
+        }
+        for (std::size_t k : {std::size_t(0), std::size_t(1), n / 3, n / 2, n ? n - 1 : 0, n + 5}) {
+            ref = a;
+            if (n) std::rotate(ref.begin(), ref.begin() + static_cast<long>(k % n), ref.end());
+            for (rev::Rotate algo : {rev::Rotate::Reversal, rev::Rotate::BlockSwap}) {
+                std::vector<T> b = a;
+                rev::rotate_left(b.data(), n, k, algo, 2);
+                ok &= b == ref;
+            }
+        }
+    }
+    return ok;
+}
+
+template <typename T>
+static void bench_width(void *buf, std::size_t bytes, unsigned threads) {
+    T *a = static_cast<T *>(buf);
+    std::size_t n = bytes / sizeof(T);
+    double gb = static_cast<double>(n * sizeof(T)) / 1e9;
+    double t_loop = best_of([&] { reverse_array(a, static_cast<long>(n)); });
+    double t_std = best_of([&] { std::reverse(a, a + n); });
+    double t_simd = best_of([&] { rev::reverse(a, n, 1); });
+    double t_par = best_of([&] { rev::reverse(a, n, threads); });
+    std::printf("%4zu B  %10.2f %12.2f %10.2f %10.2f\n", sizeof(T), gb / t_loop, gb / t_std,
+                gb / t_simd, gb / t_par);
+}
+
+int main(int argc, char **argv) {
+    std::size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    /* 与 2_21.c 相同的小例子 */
+    int arr[] = {1, 2, 3, 4, 5, 6, 7};
+    rev::reverse(arr, 7);
+    for (int x : arr) std::printf("%d ", x);
+    std::printf("\n");
+    rev::rotate_left(arr, 7, 2);
+    for (int x : arr) std::printf("%d ", x);
+    std::printf("\n");
+
+    bool ok = check_width<std::uint8_t>() && check_width<std::uint16_t>() && check_width<std::uint32_t>()
+              && check_width<std::uint64_t>() && check_width<Elem16>();
+    struct Odd { unsigned char b[3]; bool operator==(const Odd &o) const { return !std::memcmp(b, o.b, 3); } };
+    ok = ok && check_width<Odd>();
+    std::printf("正确性检查: %s\n\n", ok ? "通过" : "失败");
+
+    std::size_t bytes = mb << 20;
+    void *buf = std::aligned_alloc(64, bytes);
+    if (!buf) return 1;
+    fill(static_cast<unsigned char *>(buf), bytes);
+
+#if defined(__AVX2__)
+    const char *isa = "AVX2";
+#elif defined(REV_HAVE_SSE2)
+    const char *isa = "SSE2";
+#else
+    const char *isa = "标量";
+#endif
+    std::printf("反转 %zu MB（%s，%u 线程），GB/s\n", mb, isa, threads);
+    std::printf("宽度   逐元素循环  std::reverse   SIMD单线程   SIMD多线程\n");
+    bench_width<std::uint8_t>(buf, bytes, threads);
+    bench_width<std::uint16_t>(buf, bytes, threads);
+    bench_width<std::uint32_t>(buf, bytes, threads);
+    bench_width<std::uint64_t>(buf, bytes, threads);
+    bench_width<Elem16>(buf, bytes, threads);
+
+    std::printf("\n循环左移（int，%zu MB），GB/s\n", mb);
+    std::printf("  k          std::rotate   三次反转    块交换\n");
+    int *a = static_cast<int *>(buf);
+    std::size_t n = bytes / sizeof(int);
+    double gb = static_cast<double>(bytes) / 1e9;
+    for (std::size_t k : {std::size_t(1), std::size_t(5000), n / 3, n / 2 - 1, n - 10000}) {
+        double t_std = best_of([&] { std::rotate(a, a + k, a + n); });
+        double t_rev = best_of([&] { rev::rotate_left(a, n, k, rev::Rotate::Reversal, threads); });
+        double t_blk = best_of([&] { rev::rotate_left(a, n, k, rev::Rotate::BlockSwap, threads); });
+        std::printf("  %-10zu %11.2f %10.2f %10.2f\n", k, gb / t_std, gb / t_rev, gb / t_blk);
+    }
+    std::free(buf);
+    return ok ? 0 : 1;
+}
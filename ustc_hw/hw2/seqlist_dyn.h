@@ -0,0 +1,174 @@
+/*
+ * 可增长顺序表（2_21.c / 2_29.c 的 SeqList、intersection.c 的 SqList 的替代），header-only
+ *
+ * 原来的顺序表是栈上的定长数组（MAX_SIZE 100 / MAXSIZE 20），ListInsert / ListDelete
+ * 每次循环挪一个元素，CreateList 调 n 次 ListInsert。这里：
+ * - 数据按 64 字节对齐，容量按 2 倍增长
+ * - dsl_insert_range / dsl_erase_range：一次 memmove 挪动整段
+ * - dsl_erase_if：单遍读写双指针原地压缩（与 delete_common_elements_optimized 同一思路），稳定
+ * - 视图：SeqListView { int *data; int size; } 与 2_29.c 注释里假设的动态 SeqList 布局相同，
+ *   SqListView { int *data; int length; } 对应 intersection.c 的字段名。
+ *   原来的算法把 SeqList 换成视图类型即可原样运行，不拷贝数据；算法改了长度的话用 dsl_commit 写回
+ *
+ * 下标均从 0 开始；内存不足时返回 false，表内容不变。
+ */
+#ifndef SEQLIST_DYN_H
+#define SEQLIST_DYN_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#define DSL_ALIGN 64
+
+typedef int ElemType;
+
+typedef struct {
+    ElemType *data;
+    size_t size, cap;
+} DSeqList;
+
+/* 与原算法字段同名的零拷贝视图 */
+typedef struct {
+    ElemType *data;
+    int size;
+} SeqListView;
+
+typedef struct {
+    ElemType *data;
+    int length;
+} SqListView;
+
+static inline void *dsl_aligned_alloc(size_t bytes) {
+    if (bytes == 0) bytes = DSL_ALIGN;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, DSL_ALIGN);
+#else
+    void *p = NULL;
+    return posix_memalign(&p, DSL_ALIGN, bytes) == 0 ? p : NULL;
+#endif
+}
+
+static inline void dsl_aligned_free(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+static inline void dsl_init(DSeqList *L) { L->data = NULL; L->size = L->cap = 0; }
+
+static inline void dsl_free(DSeqList *L) {
+    dsl_aligned_free(L->data);
+    dsl_init(L);
+}
+
+/* 保证容量至少为 n */
+static inline bool dsl_reserve(DSeqList *L, size_t n) {
+    if (n <= L->cap) return true;
+    size_t cap = L->cap ? L->cap : 16;
+    while (cap < n) cap *= 2;
+    if (cap > SIZE_MAX / sizeof(ElemType)) return false;
+    ElemType *p = (ElemType *)dsl_aligned_alloc(cap * sizeof(ElemType));
+    if (!p) return false;
+    if (L->size) memcpy(p, L->data, L->size * sizeof(ElemType));
+    dsl_aligned_free(L->data);
+    L->data = p;
+    L->cap = cap;
+    return true;
+}
+
+static inline bool dsl_push(DSeqList *L, ElemType e) {
+    if (L->size == L->cap && !dsl_reserve(L, L->size + 1)) return false;
+    L->data[L->size++] = e;
+    return true;
+}
+
+/* 在 pos 处插入 src[0..n)；pos 可以等于 size（追加）。src 不能指向表内 */
+static inline bool dsl_insert_range(DSeqList *L, size_t pos, const ElemType *src, size_t n) {
+    if (pos > L->size || n > SIZE_MAX - L->size) return false;
+    if (n == 0) return true;
+    if (L->size + n > L->cap) {
+        /* 需要扩容时直接在新缓冲区里拼好三段，省掉一次 memmove */
+        size_t cap = L->cap ? L->cap : 16;
+        while (cap < L->size + n) cap *= 2;
+        ElemType *p = (ElemType *)dsl_aligned_alloc(cap * sizeof(ElemType));
+        if (!p) return false;
+        if (pos) memcpy(p, L->data, pos * sizeof(ElemType));
+        memcpy(p + pos, src, n * sizeof(ElemType));
+        memcpy(p + pos + n, L->data + pos, (L->size - pos) * sizeof(ElemType));
+        dsl_aligned_free(L->data);
+        L->data = p;
+        L->cap = cap;
+    } else {
+        memmove(L->data + pos + n, L->data + pos, (L->size - pos) * sizeof(ElemType));
+        memcpy(L->data + pos, src, n * sizeof(ElemType));
+    }
+    L->size += n;
+    return true;
+}
+
+static inline bool dsl_insert(DSeqList *L, size_t pos, ElemType e) {
+    return dsl_insert_range(L, pos, &e, 1);
+}
+
+/* 删除 [pos, pos + n)，越界部分截断；返回删除个数 */
+static inline size_t dsl_erase_range(DSeqList *L, size_t pos, size_t n) {
+    if (pos >= L->size) return 0;
+    if (n > L->size - pos) n = L->size - pos;
+    memmove(L->data + pos, L->data + pos + n, (L->size - pos - n) * sizeof(ElemType));
+    L->size -= n;
+    return n;
+}
+
+/* 删除所有满足 pred 的元素，保持其余元素的相对次序；返回删除个数 */
+static inline size_t dsl_erase_if(DSeqList *L, bool (*pred)(ElemType, void *), void *arg) {
+    size_t i = 0, n = L->size;
+    while (i < n && !pred(L->data[i], arg)) ++i;      /* 第一个要删的位置之前不用写 */
+    if (i == n) return 0;
+    size_t w = i;
+    for (++i; i < n; ++i) {                            /* data[w] 已判定要删，从下一个开始 */
+        ElemType x = L->data[i];
+        L->data[w] = x;
+        w += !pred(x, arg);
+    }
+    L->size = w;
+    return n - w;
+}
+
+/* 用 src[0..n) 整体替换表内容（CreateList 的批量版本） */
+static inline bool dsl_assign(DSeqList *L, const ElemType *src, size_t n) {
+    if (!dsl_reserve(L, n)) return false;
+    if (n) memcpy(L->data, src, n * sizeof(ElemType));
+    L->size = n;
+    return true;
+}
+
+/*==================== 视图 ====================*/
+/* 视图的长度字段是 int，表长超过 INT_MAX 时返回 data 为 NULL 的空视图 */
+static inline SeqListView dsl_view(DSeqList *L) {
+    SeqListView v = {NULL, 0};
+    if (L->size <= INT_MAX) { v.data = L->data; v.size = (int)L->size; }
+    return v;
+}
+
+static inline SqListView dsl_sqview(DSeqList *L) {
+    SqListView v = {NULL, 0};
+    if (L->size <= INT_MAX) { v.data = L->data; v.length = (int)L->size; }
+    return v;
+}
+
+/* 算法通过视图缩短了表（只能缩短，不能超过原长）后，把新长度写回 */
+static inline void dsl_commit(DSeqList *L, int size) {
+    if (size >= 0 && (size_t)size <= L->size) L->size = (size_t)size;
+}
+
+#endif /* SEQLIST_DYN_H */
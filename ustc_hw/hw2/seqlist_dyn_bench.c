@@ -0,0 +1,197 @@
+// 可增长顺序表（seqlist_dyn.h）：批量插入/删除与逐元素版本的对比，并通过视图原样运行 2_21.c / 2_29.c 的算法
+// 编译: gcc -O2 seqlist_dyn_bench.c -o seqlist_dyn_bench
+// 用法: seqlist_dyn_bench [元素数，默认 100000000]
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/bench_util.h"
+#include "seqlist_dyn.h"
+
+/*==================== 原算法，只把 SeqList 换成视图类型，函数体不变 ====================*/
+typedef SeqListView SeqList;
+
+// 2_21.c：链表逆转
+void reverse_seq_list(SeqList* list) {
+    int left = 0;
+    int right = list->size - 1;
+    while (left < right) {
+        int temp = list->data[left];
+        list->data[left] = list->data[right];
+        list->data[right] = temp;
+        left++;
+        right--;
+    }
+}
+
+// 2_29.c：假设 SeqList { int *data; int size; } 且 data 已按升序
+void delete_common_elements_optimized(SeqList* A, SeqList* B, SeqList* C) {
+    int i = 0, j = 0, k = 0;   // 读指针：A、B、C
+    int w = 0;                 // 写指针：A 的新末尾
+
+    while (i < A->size) {
+        int x = A->data[i];
+
+        // 将 j、k 前推到 >= x 的位置（利用有序性）
+        while (j < B->size && B->data[j] < x) j++;
+        while (k < C->size && C->data[k] < x) k++;
+
+        // 检查 x 是否同时出现在 B 和 C
+        int inB = (j < B->size && B->data[j] == x);
+        int inC = (k < C->size && C->data[k] == x);
+
+        if (inB && inC) {
+            // 跳过：相当于删除 x
+            i++;
+        } else {
+            // 保留：覆写到 A[w]
+            if (w != i) A->data[w] = x;
+            w++; i++;
+        }
+    }
+    A->size = w;
+}
+
+// intersection.c：PrintList，字段名 length
+void PrintList(SqListView L)
+{
+    for (int i = 0; i < L.length; i++)
+        printf("%d ", L.data[i]);
+    printf("\n");
+}
+
+/*==================== 逐元素挪动的对照组（同 intersection.c 的 ListInsert / ListDelete） ====================*/
+static bool ListInsert(DSeqList *L, int i, ElemType e)
+{
+    if (i < 1 || (size_t)i > L->size + 1)
+        return false;
+    if (!dsl_reserve(L, L->size + 1))
+        return false;
+    for (int j = (int)L->size; j >= i; j--)
+        L->data[j] = L->data[j - 1];
+    L->data[i - 1] = e;
+    L->size++;
+    return true;
+}
+
+static bool ListDelete(DSeqList *L, int i, ElemType *e)
+{
+    if (i < 1 || (size_t)i > L->size)
+        return false;
+    *e = L->data[i - 1];
+    for (int j = i; j < (int)L->size; j++)
+        L->data[j - 1] = L->data[j];
+    L->size--;
+    return true;
+}
+
+static bool is_mul3(ElemType x, void *arg) {
+    (void)arg;
+    return x % 3 == 0;
+}
+
+static void fill_iota(DSeqList *L, size_t n, int step) {
+    dsl_reserve(L, n);
+    for (size_t i = 0; i < n; ++i) L->data[i] = (int)(i * (size_t)step);
+    L->size = n;
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 100000000;
+    if (n > INT_MAX) n = INT_MAX;
+
+    /* 小例子：intersection.c 的 CreateList + PrintList */
+    int a[] = {1, 2, 4, 5, 6};
+    DSeqList A, B, C;
+    dsl_init(&A); dsl_init(&B); dsl_init(&C);
+    dsl_assign(&A, a, 5);
+    int b[] = {3, 9, 10};
+    dsl_insert_range(&A, 2, b, 3);
+    printf("insert_range(2, {3, 9, 10}): ");
+    PrintList(dsl_sqview(&A));
+    dsl_erase_range(&A, 3, 2);
+    printf("erase_range(3, 2):           ");
+    PrintList(dsl_sqview(&A));
+    dsl_erase_if(&A, is_mul3, NULL);
+    printf("erase_if(x %% 3 == 0):        ");
+    PrintList(dsl_sqview(&A));
+
+    printf("\n元素数 %zu\n", n);
+    double t0;
+
+    /* 1. 建表：逐个追加 vs 一次 memcpy */
+    int *src = (int *)malloc(n * sizeof(int));
+    for (size_t i = 0; i < n; ++i) src[i] = (int)i;
+    dsl_free(&A);
+    t0 = now_sec();
+    for (size_t i = 0; i < n; ++i) dsl_push(&A, src[i]);
+    printf("  逐个 dsl_push 建表         %9.1f ms\n", (now_sec() - t0) * 1e3);
+    t0 = now_sec();
+    dsl_assign(&B, src, n);
+    printf("  dsl_assign 建表            %9.1f ms\n", (now_sec() - t0) * 1e3);
+    free(src);
+    dsl_free(&B);
+
+    /* 2. 表头插入：ListInsert 逐个挪 vs memmove；每次都要挪动整张表 */
+    int reps = 3;
+    t0 = now_sec();
+    for (int r = 0; r < reps; ++r) ListInsert(&A, 1, -r);
+    double t_li = (now_sec() - t0) / reps;
+    t0 = now_sec();
+    for (int r = 0; r < reps; ++r) dsl_insert(&A, 0, -r);
+    double t_mm = (now_sec() - t0) / reps;
+    printf("  表头插入 1 个: ListInsert  %9.1f ms, dsl_insert %9.1f ms\n", t_li * 1e3, t_mm * 1e3);
+    int block[1000];
+    for (int i = 0; i < 1000; ++i) block[i] = i;
+    t0 = now_sec();
+    dsl_insert_range(&A, A.size / 2, block, 1000);
+    printf("  表中插入 1000 个 (insert_range)  %9.1f ms  (ListInsert 需挪 1000 遍)\n", (now_sec() - t0) * 1e3);
+    t0 = now_sec();
+    dsl_erase_range(&A, A.size / 2, 1000);
+    printf("  表中删除 1000 个 (erase_range)   %9.1f ms\n", (now_sec() - t0) * 1e3);
+    dsl_erase_range(&A, 0, 2 * (size_t)reps);
+
+    /* 3. 按条件删除：ListDelete 逐个删是 O(n^2)，只在前 20000 个元素上测 */
+    size_t small = n < 20000 ? n : 20000;
+    fill_iota(&B, small, 1);
+    t0 = now_sec();
+    for (int i = (int)B.size; i >= 1; --i) {
+        ElemType e;
+        if (B.data[i - 1] % 3 == 0) ListDelete(&B, i, &e);
+    }
+    double t_ld = now_sec() - t0;
+    size_t left_ld = B.size;
+    fill_iota(&B, small, 1);
+    t0 = now_sec();
+    dsl_erase_if(&B, is_mul3, NULL);
+    double t_ei_small = now_sec() - t0;
+    printf("  删 3 的倍数 (%zu 个): ListDelete %9.3f ms, erase_if %9.3f ms%s\n", small,
+           t_ld * 1e3, t_ei_small * 1e3, left_ld == B.size ? "" : "  MISMATCH");
+    t0 = now_sec();
+    size_t removed = dsl_erase_if(&A, is_mul3, NULL);
+    printf("  删 3 的倍数 (%zu 个): erase_if %9.1f ms, 删除 %zu 个\n", n, (now_sec() - t0) * 1e3, removed);
+
+    /* 4. 原算法在视图上运行 */
+    fill_iota(&A, n, 1);
+    SeqListView va = dsl_view(&A);
+    t0 = now_sec();
+    reverse_seq_list(&va);
+    printf("  reverse_seq_list (视图)    %9.1f ms  %s\n", (now_sec() - t0) * 1e3,
+           A.data[0] == (int)n - 1 && A.data[n - 1] == 0 ? "" : "MISMATCH");
+
+    fill_iota(&A, n, 1);
+    fill_iota(&B, n / 2, 2);     /* 偶数 */
+    fill_iota(&C, n / 3, 3);     /* 3 的倍数 */
+    va = dsl_view(&A);
+    SeqListView vb = dsl_view(&B), vc = dsl_view(&C);
+    t0 = now_sec();
+    delete_common_elements_optimized(&va, &vb, &vc);
+    dsl_commit(&A, va.size);
+    double t_dc = now_sec() - t0;
+    /* B ∩ C 为 [0, n) 内的 6 的倍数（受 B、C 长度限制取较小范围） */
+    size_t lim = (n / 2) * 2 < (n / 3) * 3 ? (n / 2) * 2 : (n / 3) * 3;
+    size_t expect = n - (lim + 5) / 6;
+    printf("  delete_common_elements_optimized (视图) %9.1f ms, 剩余 %zu %s\n", t_dc * 1e3, A.size,
+           A.size == expect ? "" : "MISMATCH");
+
+    dsl_free(&A); dsl_free(&B); dsl_free(&C);
+    return 0;
+}
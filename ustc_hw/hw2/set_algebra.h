@@ -0,0 +1,333 @@
+/*
+ * 多路有序集合运算（2_29.c 中 delete_common_elements_optimized 的推广），header-only
+ *
+ * delete_common_elements_optimized 用三个读指针一趟算出 A \ (B ∩ C)。这里推广到 k 个
+ * 递增集合（k <= 64）上的任意表达式：并、交、差以及“k 个中至少出现 t 次”。
+ * - k 路游标用败者树合并，每个不同的值只出队一次，同时得到它在哪些集合中出现
+ *   （一个 64 位掩码），再对掩码求表达式的值，一趟流式完成
+ * - 表达式先裁剪出根可达的结点，再按编号从小到大求值（子结点编号总小于父结点），
+ *   每个值 O(表达式大小)
+ * - 若结果必为第 0 个集合的子集（如 A \ ...、A ∩ ...），可直接写回第 0 个集合
+ * - sa_eval_parallel 按值域切成互不相交的若干段，每段一个线程
+ *
+ * 约定：输入严格递增（无重复），输出同样严格递增。
+ */
+#ifndef SET_ALGEBRA_H
+#define SET_ALGEBRA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define SA_MAX_SETS 64
+#define SA_MAX_NODES 1024
+
+/*==================== 表达式 ====================*/
+typedef enum { SA_SET, SA_UNION, SA_INTER, SA_DIFF, SA_ATLEAST } SaOp;
+
+typedef struct {
+    SaOp op;
+    int a, b;          /* 子结点编号（SA_UNION/SA_INTER/SA_DIFF） */
+    int set;           /* SA_SET: 集合编号 */
+    int t;             /* SA_ATLEAST: 阈值 */
+    uint64_t sets;     /* SA_ATLEAST: 参与计数的集合掩码 */
+} SaNode;
+
+typedef struct {
+    SaNode node[SA_MAX_NODES];
+    int n;
+} SaProgram;
+
+static inline void sa_init(SaProgram *p) { p->n = 0; }
+
+static inline int sa_push_node(SaProgram *p, SaNode nd) {
+    if (p->n >= SA_MAX_NODES) return -1;
+    p->node[p->n] = nd;
+    return p->n++;
+}
+
+static inline int sa_set(SaProgram *p, int i) {
+    SaNode nd = {SA_SET, -1, -1, i, 0, 0};
+    return sa_push_node(p, nd);
+}
+static inline int sa_binary(SaProgram *p, SaOp op, int a, int b) {
+    if (a < 0 || b < 0) return -1;
+    SaNode nd = {op, a, b, -1, 0, 0};
+    return sa_push_node(p, nd);
+}
+static inline int sa_union(SaProgram *p, int a, int b) { return sa_binary(p, SA_UNION, a, b); }
+static inline int sa_inter(SaProgram *p, int a, int b) { return sa_binary(p, SA_INTER, a, b); }
+static inline int sa_diff(SaProgram *p, int a, int b) { return sa_binary(p, SA_DIFF, a, b); }
+/* sets 中至少 t 个集合含该值 */
+static inline int sa_atleast(SaProgram *p, int t, uint64_t sets) {
+    SaNode nd = {SA_ATLEAST, -1, -1, -1, t, sets};
+    return sa_push_node(p, nd);
+}
+
+/* 只保留 root 可达的结点并重新编号，求值时不必遍历无关结点 */
+typedef struct {
+    SaNode node[SA_MAX_NODES];
+    int n;                             /* 最后一个结点即根 */
+} SaCompiled;
+
+static inline void sa_compile(const SaProgram *p, int root, SaCompiled *c) {
+    int remap[SA_MAX_NODES];
+    bool reach[SA_MAX_NODES] = {false};
+    reach[root] = true;
+    for (int i = root; i >= 0; --i) {
+        if (!reach[i]) continue;
+        const SaNode *nd = &p->node[i];
+        if (nd->a >= 0) reach[nd->a] = true;
+        if (nd->b >= 0) reach[nd->b] = true;
+    }
+    c->n = 0;
+    for (int i = 0; i <= root; ++i) {
+        if (!reach[i]) continue;
+        SaNode nd = p->node[i];
+        if (nd.a >= 0) nd.a = remap[nd.a];
+        if (nd.b >= 0) nd.b = remap[nd.b];
+        remap[i] = c->n;
+        c->node[c->n++] = nd;
+    }
+}
+
+/* 对出现掩码 mask 求表达式的值 */
+static inline bool sa_test(const SaCompiled *c, uint64_t mask) {
+    bool r[SA_MAX_NODES];
+    for (int i = 0; i < c->n; ++i) {
+        const SaNode *nd = &c->node[i];
+        switch (nd->op) {
+        case SA_SET:     r[i] = (mask >> nd->set) & 1; break;
+        case SA_UNION:   r[i] = r[nd->a] || r[nd->b]; break;
+        case SA_INTER:   r[i] = r[nd->a] && r[nd->b]; break;
+        case SA_DIFF:    r[i] = r[nd->a] && !r[nd->b]; break;
+        case SA_ATLEAST: r[i] = __builtin_popcountll(mask & nd->sets) >= nd->t; break;
+        }
+    }
+    return r[c->n - 1];
+}
+
+/* 结构上能否断定结果 ⊆ 第 s 个集合（可写回该集合） */
+static inline bool sa_subset_of(const SaProgram *p, int root, int s) {
+    const SaNode *nd = &p->node[root];
+    switch (nd->op) {
+    case SA_SET:   return nd->set == s;
+    case SA_UNION: return sa_subset_of(p, nd->a, s) && sa_subset_of(p, nd->b, s);
+    case SA_INTER: return sa_subset_of(p, nd->a, s) || sa_subset_of(p, nd->b, s);
+    case SA_DIFF:  return sa_subset_of(p, nd->a, s);
+    case SA_ATLEAST:
+        /* 参与集合中除 s 外只有 t-1 个时，达到 t 就必须含 s */
+        return ((nd->sets >> s) & 1) && __builtin_popcountll(nd->sets) - 1 < nd->t;
+    }
+    return false;
+}
+
+/* 表达式用到的集合掩码：未被引用的集合不必进入败者树 */
+static inline uint64_t sa_used_sets(const SaProgram *p, int root) {
+    const SaNode *nd = &p->node[root];
+    switch (nd->op) {
+    case SA_SET:     return 1ULL << nd->set;
+    case SA_ATLEAST: return nd->sets;
+    default:         return sa_used_sets(p, nd->a) | sa_used_sets(p, nd->b);
+    }
+}
+
+/*==================== 败者树 ====================*/
+typedef struct {
+    const int *data[SA_MAX_SETS];
+    size_t pos[SA_MAX_SETS], end[SA_MAX_SETS];
+    int id[SA_MAX_SETS];               /* 叶子 -> 原集合编号 */
+    int tree[SA_MAX_SETS + 1];         /* tree[0] 为胜者，其余为败者 */
+    int k;
+} SaLoserTree;
+
+#define SA_KEY_MIN INT64_MIN           /* 建树用的虚拟叶子 */
+#define SA_KEY_END INT64_MAX           /* 哨兵：该路已耗尽 */
+
+static inline int64_t sa_key(const SaLoserTree *lt, int leaf) {
+    if (leaf == lt->k) return SA_KEY_MIN;
+    return lt->pos[leaf] < lt->end[leaf] ? (int64_t)lt->data[leaf][lt->pos[leaf]] : SA_KEY_END;
+}
+
+static inline void sa_adjust(SaLoserTree *lt, int s) {
+    for (int t = (s + lt->k) >> 1; t > 0; t >>= 1) {
+        if (sa_key(lt, s) > sa_key(lt, lt->tree[t])) {
+            int tmp = s; s = lt->tree[t]; lt->tree[t] = tmp;
+        }
+    }
+    lt->tree[0] = s;
+}
+
+static inline void sa_build(SaLoserTree *lt) {
+    for (int i = 0; i <= lt->k; ++i) lt->tree[i] = lt->k;
+    for (int i = lt->k - 1; i >= 0; --i) sa_adjust(lt, i);
+}
+
+/*==================== 求值 ====================*/
+/* 各集合在 [lo[i], hi[i]) 内的部分参与运算，结果写到 out，返回个数；内存不足时返回 (size_t)-1 */
+static inline size_t sa_eval_range(const SaProgram *p, int root, const int *const *sets,
+                                   const size_t *lo, const size_t *hi, int k, int *out) {
+    if (root < 0) return 0;
+    SaLoserTree lt;
+    memset(&lt, 0, sizeof(lt));
+    SaCompiled *expr = (SaCompiled *)malloc(sizeof(SaCompiled));
+    if (!expr) return (size_t)-1;
+    sa_compile(p, root, expr);
+    uint64_t used = sa_used_sets(p, root);
+    for (int i = 0; i < k; ++i) {
+        if (!((used >> i) & 1) || lo[i] >= hi[i]) continue;
+        lt.data[lt.k] = sets[i];
+        lt.pos[lt.k] = lo[i];
+        lt.end[lt.k] = hi[i];
+        lt.id[lt.k] = i;
+        lt.k++;
+    }
+    if (lt.k == 0) { free(expr); return 0; }
+    sa_build(&lt);
+
+    size_t w = 0;
+    for (;;) {
+        int win = lt.tree[0];
+        int64_t v = sa_key(&lt, win);
+        if (v == SA_KEY_END) break;
+        uint64_t mask = 0;
+        do {                                   /* 收集所有等于 v 的路 */
+            mask |= 1ULL << lt.id[win];
+            lt.pos[win]++;
+            sa_adjust(&lt, win);
+            win = lt.tree[0];
+        } while (sa_key(&lt, win) == v);
+        if (sa_test(expr, mask)) out[w++] = (int)v;
+    }
+    free(expr);
+    return w;
+}
+
+/* 结果个数上界（用于给 out 分配空间） */
+static inline size_t sa_output_bound(const SaProgram *p, int root, const size_t *sizes, int k) {
+    uint64_t used = sa_used_sets(p, root);
+    size_t s = 0;
+    for (int i = 0; i < k; ++i)
+        if ((used >> i) & 1) s += sizes[i];
+    return s;
+}
+
+/* 单线程求值；若 sa_subset_of(p, root, 0)，out 可以就是 sets[0]（原地写回）。内存不足时返回 (size_t)-1 */
+static inline size_t sa_eval(const SaProgram *p, int root, const int *const *sets,
+                             const size_t *sizes, int k, int *out) {
+    size_t lo[SA_MAX_SETS] = {0};
+    return sa_eval_range(p, root, sets, lo, sizes, k, out);
+}
+
+/*==================== 按值域并行 ====================*/
+typedef struct {
+    const SaProgram *p;
+    int root, k;
+    const int *const *sets;
+    size_t lo[SA_MAX_SETS], hi[SA_MAX_SETS];
+    int *out;
+    size_t count;
+} SaTask;
+
+static void *sa_task_main(void *arg) {
+    SaTask *t = (SaTask *)arg;
+    t->count = sa_eval_range(t->p, t->root, t->sets, t->lo, t->hi, t->k, t->out);
+    return NULL;
+}
+
+static inline size_t sa_lower_bound(const int *a, size_t n, int64_t x) {
+    size_t l = 0, r = n;
+    while (l < r) {
+        size_t m = l + (r - l) / 2;
+        if ((int64_t)a[m] < x) l = m + 1;
+        else r = m;
+    }
+    return l;
+}
+
+/*
+ * 按值域切成 nthreads 段并行求值。分段点取自最长集合的等分位置，因此各段工作量大致相当。
+ * 结果 ⊆ sets[0] 时各段直接写回 sets[0] 自己的那一段，最后依次 memmove 压紧，不需额外内存；
+ * 否则每段先写到临时缓冲，再按顺序拷入 out。out 为 NULL 时按原地模式处理。
+ * 返回结果个数；原地模式下表达式不能保证 ⊆ sets[0]，或内存不足时返回 (size_t)-1。
+ */
+static inline size_t sa_eval_parallel(const SaProgram *p, int root, int *const *sets,
+                                      const size_t *sizes, int k, int *out, int nthreads) {
+    bool inplace = (out == NULL || out == sets[0]);
+    if (inplace && !sa_subset_of(p, root, 0)) return (size_t)-1;
+    if (nthreads <= 1) return sa_eval(p, root, (const int *const *)sets, sizes, k, inplace ? sets[0] : out);
+
+    int big = 0;
+    for (int i = 1; i < k; ++i)
+        if (sizes[i] > sizes[big]) big = i;
+    /* 元素比线程少（含全部为空）时等分位置无意义，直接单线程做 */
+    if (sizes[big] < (size_t)nthreads)
+        return sa_eval(p, root, (const int *const *)sets, sizes, k, inplace ? sets[0] : out);
+
+    SaTask *task = (SaTask *)calloc((size_t)nthreads, sizeof(SaTask));
+    pthread_t *th = (pthread_t *)calloc((size_t)nthreads, sizeof(pthread_t));
+    if (!task || !th) { free(task); free(th); return (size_t)-1; }
+
+    int64_t prev = INT64_MIN;
+    for (int t = 0; t < nthreads; ++t) {
+        int64_t next = (t == nthreads - 1) ? INT64_MAX
+                       : (int64_t)sets[big][sizes[big] * (size_t)(t + 1) / (size_t)nthreads];
+        SaTask *tk = &task[t];
+        tk->p = p; tk->root = root; tk->k = k;
+        tk->sets = (const int *const *)sets;
+        for (int i = 0; i < k; ++i) {
+            tk->lo[i] = (t == 0) ? 0 : sa_lower_bound(sets[i], sizes[i], prev);
+            tk->hi[i] = (t == nthreads - 1) ? sizes[i] : sa_lower_bound(sets[i], sizes[i], next);
+        }
+        if (inplace) {
+            tk->out = sets[0] + tk->lo[0];
+        } else {
+            size_t bound = 0;
+            for (int i = 0; i < k; ++i) bound += tk->hi[i] - tk->lo[i];
+            tk->out = (int *)malloc((bound ? bound : 1) * sizeof(int));
+        }
+        prev = next;
+    }
+
+    for (int t = 0; t < nthreads; ++t)
+        if (!task[t].out) {                /* 临时缓冲分配失败 */
+            if (!inplace)
+                for (int u = 0; u < nthreads; ++u) free(task[u].out);
+            free(task); free(th);
+            return (size_t)-1;
+        }
+
+    /* 标记数组分配失败时不建线程，全部在当前线程依次做 */
+    bool *spawned = (bool *)calloc((size_t)nthreads, sizeof(bool));
+    if (!spawned) {
+        for (int t = 0; t < nthreads; ++t) sa_task_main(&task[t]);
+    } else {
+        for (int t = 0; t < nthreads; ++t) {
+            spawned[t] = pthread_create(&th[t], NULL, sa_task_main, &task[t]) == 0;
+            if (!spawned[t]) sa_task_main(&task[t]);   /* 建线程失败就在当前线程做 */
+        }
+    }
+
+    size_t total = 0;
+    bool failed = false;
+    int *dst = inplace ? sets[0] : out;
+    for (int t = 0; t < nthreads; ++t) {
+        if (spawned && spawned[t]) pthread_join(th[t], NULL);
+        if (task[t].count == (size_t)-1) failed = true;   /* 某段内存不足：其余段照常回收 */
+        if (!failed) {
+            if (task[t].out != dst + total)
+                memmove(dst + total, task[t].out, task[t].count * sizeof(int));
+            total += task[t].count;
+        }
+        if (!inplace) free(task[t].out);
+    }
+    free(spawned);
+    free(task);
+    free(th);
+    return failed ? (size_t)-1 : total;
+}
+
+#endif /* SET_ALGEBRA_H */
@@ -0,0 +1,122 @@
+// k 个递增集合上的多路集合运算：正确性检查 + k = 2..64 的吞吐测试
+// 编译: gcc -O2 set_algebra_bench.c -o set_algebra_bench -lpthread
+// 用法: set_algebra_bench [每个集合的元素数，默认 1000000；文档中的数据用 10000000] [线程数]
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/bench_util.h"
+#include "set_algebra.h"
+
+/* 与 2_29.c 相同的三指针算法，只是数组改为动态长度 */
+typedef struct {
+    int *data;
+    int size;
+} SeqList;
+
+void delete_common_elements_optimized(SeqList* A, SeqList* B, SeqList* C) {
+    int i = 0, j = 0, k = 0;
+    int w = 0;
+    while (i < A->size) {
+        int x = A->data[i];
+        while (j < B->size && B->data[j] < x) j++;
+        while (k < C->size && C->data[k] < x) k++;
+        int inB = (j < B->size && B->data[j] == x);
+        int inC = (k < C->size && C->data[k] == x);
+        if (inB && inC) {
+            i++;
+        } else {
+            if (w != i) A->data[w] = x;
+            w++; i++;
+        }
+    }
+    A->size = w;
+}
+
+/* n 个严格递增随机数，取值约在 [0, 2n)：不同集合之间大约一半重叠 */
+static void gen_sorted(int *a, size_t n, unsigned seed) {
+    unsigned x = seed * 2654435761u + 1;
+    int v = -1;
+    for (size_t i = 0; i < n; i++) {
+        x = x * 1664525u + 1013904223u;
+        v += 1 + (int)((x >> 16) % 3);
+        a[i] = v;
+    }
+}
+
+static void print_list(const int *a, size_t n) {
+    for (size_t i = 0; i < n; i++) printf("%d -> ", a[i]);
+    printf("NULL\n");
+}
+
+int main(int argc, char **argv) {
+    /* 与 2_29.c 相同的小例子：A \ (B ∩ C) */
+    int a[] = {1, 2, 3, 4}, b[] = {2, 3}, c[] = {3, 4};
+    int *sets3[] = {a, b, c};
+    size_t sz3[] = {4, 2, 2};
+    SaProgram p;
+    sa_init(&p);
+    int root = sa_diff(&p, sa_set(&p, 0), sa_inter(&p, sa_set(&p, 1), sa_set(&p, 2)));
+    size_t n3 = sa_eval(&p, root, (const int *const *)sets3, sz3, 3, a);   /* 原地写回 A */
+    printf("Modified A: ");
+    print_list(a, n3);
+
+    size_t n = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+    int nthreads = argc > 2 ? atoi(argv[2]) : 4;
+    const int K = 64;
+    int **sets = (int **)malloc(K * sizeof(int *));
+    size_t *sizes = (size_t *)malloc(K * sizeof(size_t));
+    for (int i = 0; i < K; i++) {
+        sets[i] = (int *)malloc(n * sizeof(int));
+        sizes[i] = n;
+        gen_sorted(sets[i], n, (unsigned)i + 1);
+    }
+    int *out = (int *)malloc(n * (size_t)K * sizeof(int));
+    int *work = (int *)malloc(n * sizeof(int));
+
+    /* k = 3 时与三指针版本比较 A \ (B ∩ C) */
+    {
+        memcpy(work, sets[0], n * sizeof(int));
+        SeqList A = {work, (int)n}, B = {sets[1], (int)n}, C = {sets[2], (int)n};
+        double t0 = now_sec();
+        delete_common_elements_optimized(&A, &B, &C);
+        double t_ref = now_sec() - t0;
+
+        t0 = now_sec();
+        size_t r = sa_eval(&p, root, (const int *const *)sets, sizes, 3, out);
+        double t_sa = now_sec() - t0;
+        printf("\nA \\ (B ∩ C), n=%zu: 三指针 %.1f ms, 败者树 %.1f ms, %s\n", n, t_ref * 1e3, t_sa * 1e3,
+               (size_t)A.size == r && memcmp(work, out, r * sizeof(int)) == 0 ? "结果一致" : "结果不一致");
+    }
+
+    printf("\n%3s %-26s %10s %12s %12s\n", "k", "表达式", "结果个数", "单线程 M/s", "并行 M/s");
+    for (int k = 2; k <= K; k *= 2) {
+        SaProgram q;
+        sa_init(&q);
+        uint64_t all = (k == 64) ? ~0ULL : ((1ULL << k) - 1);
+        int inter = sa_set(&q, 0), uni = inter;
+        for (int i = 1; i < k; i++) inter = sa_inter(&q, inter, sa_set(&q, i));
+        for (int i = 1; i < k; i++) uni = sa_union(&q, uni, sa_set(&q, i));
+        int rest = sa_set(&q, 1);
+        for (int i = 2; i < k; i++) rest = sa_inter(&q, rest, sa_set(&q, i));
+        int diff = sa_diff(&q, sa_set(&q, 0), rest);
+        int half = sa_atleast(&q, k / 2, all);
+
+        struct { const char *name; int root; } ex[] = {
+            {"S0 ∩ ... ∩ Sk-1", inter}, {"S0 ∪ ... ∪ Sk-1", uni},
+            {"S0 \\ (S1 ∩ ... ∩ Sk-1)", diff}, {"至少 k/2 个", half}};
+        double in_elems = (double)n * k;
+        for (int e = 0; e < 4; e++) {
+            double t0 = now_sec();
+            size_t r1 = sa_eval(&q, ex[e].root, (const int *const *)sets, sizes, k, out);
+            double t1 = now_sec() - t0;
+            t0 = now_sec();
+            size_t r2 = sa_eval_parallel(&q, ex[e].root, sets, sizes, k, out, nthreads);
+            double t2 = now_sec() - t0;
+            printf("%3d %-26s %10zu %12.1f %12.1f%s\n", k, ex[e].name, r1, in_elems / t1 / 1e6,
+                   in_elems / t2 / 1e6, r1 == r2 ? "" : "  MISMATCH");
+        }
+    }
+
+    for (int i = 0; i < K; i++) free(sets[i]);
+    free(sets); free(sizes); free(out); free(work);
+    return 0;
+}
@@ -0,0 +1,160 @@
+// 分块跳表（skiplist_set.h）与 2_19.c 链表的对比：尾部追加与区间删除
+// 编译: gcc -O2 skiplist_bench.c -o skiplist_bench
+// 用法: skiplist_bench [元素数，默认 10000000]
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/bench_util.h"
+#include "skiplist_set.h"
+
+/*==================== 2_19.c 原实现 ====================*/
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+struct Node* create_node(int data) {
+    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+    if (!new_node) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    new_node->data = data;
+    new_node->next = NULL;
+    return new_node;
+}
+
+struct Node* add_node(struct Node* head, int data) {
+    struct Node* new_node = create_node(data);
+    if (!head) {
+        return new_node;
+    }
+    struct Node* curr = head;
+    while (curr->next != NULL) {
+        curr = curr->next;
+    }
+    curr->next = new_node;
+    return head;
+}
+
+struct Node* delete_range(struct Node* head, int mink, int maxk) {
+    while (head != NULL && head->data > mink && head->data < maxk) {
+        struct Node* temp = head;
+        head = head->next;
+        free(temp);
+    }
+    if (head == NULL) return NULL;
+    struct Node* curr = head;
+    while (curr != NULL && curr->next != NULL) {
+        if (curr->next->data > mink && curr->next->data < maxk) {
+            struct Node* temp = curr->next;
+            curr->next = curr->next->next;
+            free(temp);
+        } else {
+            curr = curr->next;
+        }
+    }
+    return head;
+}
+
+int main(int argc, char **argv) {
+    /* 与 2_19.c 相同的小例子 */
+    SkipSet s;
+    sl_init(&s);
+    for (int i = 1; i <= 9; i++) sl_append(&s, i);
+    printf("Original list: \n");
+    sl_print(&s);
+    sl_delete_range(&s, 4, 8);
+    printf("List after deleting nodes with values in range (4, 8): \n");
+    sl_print(&s);
+    sl_destroy(&s);
+
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    printf("\nn = %d（值为 0, 2, 4, ...）\n", n);
+
+    /* add_node 每次走到表尾，只在小规模上演示其 O(n^2) */
+    int small = 20000;
+    double t0 = now_sec();
+    struct Node* tmp = NULL;
+    for (int i = 0; i < small; i++) tmp = add_node(tmp, 2 * i);
+    printf("add_node      x %d: %8.1f ms\n", small, (now_sec() - t0) * 1e3);
+    delete_range(tmp, -1, 2 * small);
+
+    /* 原链表：为了能建起 10^7 个结点，这里改用尾指针追加 */
+    t0 = now_sec();
+    struct Node *head = create_node(0), *tail = head;
+    for (int i = 1; i < n; i++) { tail->next = create_node(2 * i); tail = tail->next; }
+    double t_list_build = now_sec() - t0;
+
+    t0 = now_sec();
+    sl_init(&s);
+    for (int i = 0; i < n; i++) sl_append(&s, 2 * i);
+    double t_sl_build = now_sec() - t0;
+    printf("链表尾指针追加 x %d: %8.1f ms\n", n, t_list_build * 1e3);
+    printf("sl_append      x %d: %8.1f ms\n", n, t_sl_build * 1e3);
+
+    /* 区间删除：原实现每次走完整张表；跳表只碰两端 */
+    const int LIST_OPS = 5, SL_OPS = 100000;
+    unsigned r = 12345;
+    t0 = now_sec();
+    for (int k = 0; k < LIST_OPS; k++) {
+        r = r * 1103515245u + 12345u;
+        int lo = (int)(r % (unsigned)(2 * n));
+        head = delete_range(head, lo, lo + 200);
+    }
+    double t_list_del = (now_sec() - t0) / LIST_OPS;
+
+    r = 12345;
+    size_t removed = 0;
+    t0 = now_sec();
+    for (int k = 0; k < SL_OPS; k++) {
+        r = r * 1103515245u + 12345u;
+        int lo = (int)(r % (unsigned)(2 * n));
+        removed += sl_delete_range(&s, lo, lo + 200);
+    }
+    double t_sl_del = (now_sec() - t0) / SL_OPS;
+    printf("delete_range   (宽度 200): %10.1f us/次\n", t_list_del * 1e6);
+    printf("sl_delete_range(宽度 200): %10.3f us/次（共删 %zu 个）\n", t_sl_del * 1e6, removed);
+
+    /* 大区间：一次删掉一半 */
+    t0 = now_sec();
+    size_t big = sl_delete_range(&s, n / 2, n + n / 2);
+    printf("sl_delete_range 删除 %zu 个: %.3f ms\n", big, (now_sec() - t0) * 1e3);
+
+    bool ok = true;
+    /* 以标记数组作参照：交替插入与区间删除 */
+    {
+        SkipSet t;
+        sl_init(&t);
+        static char present[30000];
+        memset(present, 0, sizeof(present));
+        r = 7;
+        for (int k = 0; k < 200000 && ok; k++) {
+            r = r * 1103515245u + 12345u;
+            int x = (int)((r >> 4) % 30000u);
+            if (k % 5 != 0) {
+                bool ins = sl_insert(&t, x);
+                if (ins == (bool)present[x]) ok = false;
+                present[x] = 1;
+            } else {
+                int w = (int)((r >> 20) % 400u);
+                sl_delete_range(&t, x, x + w);
+                for (int y = x + 1; y < x + w && y < 30000; y++) present[y] = 0;
+            }
+        }
+        size_t cnt = 0;
+        for (int y = 0; y < 30000; y++) {
+            cnt += present[y];
+            if ((bool)present[y] != sl_contains(&t, y)) ok = false;
+        }
+        if (cnt != t.size) ok = false;
+        int prev = -1;
+        for (SlBlock *b = t.head->next[0]; b; b = b->next[0])
+            for (int i = 0; i < b->count; i++) { if (b->keys[i] <= prev) ok = false; prev = b->keys[i]; }
+        sl_destroy(&t);
+    }
+    printf("随机插入/区间删除交叉验证: %s\n", ok ? "通过" : "失败");
+
+    sl_destroy(&s);
+    while (head) { struct Node *t = head->next; free(head); head = t; }
+    return 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * 分块跳表：有序整数集合（2_19.c 中链表 + delete_range 的替代），header-only
+ *
+ * 2_19.c 的 delete_range 从表头逐个结点走到表尾，add_node 每次都重新走到表尾。这里：
+ * - 每个块存 SL_BLOCK 个有序 int，1 层的块恰好占一个 64 字节缓存行；
+ *   块之间按首元素有序，用跳表索引（高度随机，p = 1/4）
+ * - 查找 O(log n)
+ * - 尾部追加 O(1)：记住每层最后一个块，直接挂到尾部
+ * - 区间删除 O(log n + k/SL_BLOCK)：两次查找定位两端，两端块就地裁剪，
+ *   中间整段块在每层各改一次指针即摘下，然后整段归还到按层分类的空闲链表
+ *
+ * 与 delete_range 语义一致：删除 mink < x < maxk 的元素。
+ */
+#ifndef SKIPLIST_SET_H
+#define SKIPLIST_SET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SL_BLOCK 12          /* 4 字节头 + 48 字节数据 + 8 字节 next[0] => 64 字节 */
+#define SL_MAX_LEVEL 16
+
+typedef struct SlBlock {
+    uint16_t count;
+    uint8_t level;
+    uint8_t pad;
+    int keys[SL_BLOCK];
+    struct SlBlock *next[];  /* 长度为 level */
+} SlBlock;
+
+typedef struct SlChunk {
+    struct SlChunk *next;
+} SlChunk;
+
+typedef struct {
+    SlBlock *head;                     /* 哨兵，高度为 SL_MAX_LEVEL，不存数据 */
+    SlBlock *last[SL_MAX_LEVEL];       /* 每层最后一个块（尾部追加用） */
+    int level;                         /* 当前最高层数 */
+    size_t size;
+    unsigned rng;
+    SlBlock *freelist[SL_MAX_LEVEL + 1];  /* 按层数分类的空闲块 */
+    SlChunk *chunks;                   /* 所有内存块，销毁时一并释放 */
+    char *bump[SL_MAX_LEVEL + 1], *bump_end[SL_MAX_LEVEL + 1];
+} SkipSet;
+
+static inline size_t sl_block_bytes(int level) {
+    size_t b = offsetof(SlBlock, next) + (size_t)level * sizeof(SlBlock *);
+    return (b + 63) & ~(size_t)63;     /* 按缓存行取整 */
+}
+
+/*==================== 块分配 ====================*/
+#define SL_CHUNK_BYTES (64 * 1024)
+
+static inline SlBlock *sl_alloc(SkipSet *s, int level) {
+    SlBlock *b = s->freelist[level];
+    if (b) {
+        s->freelist[level] = b->next[0];
+    } else {
+        size_t need = sl_block_bytes(level);
+        if (s->bump[level] == NULL || s->bump[level] + need > s->bump_end[level]) {
+            SlChunk *c = (SlChunk *)malloc(SL_CHUNK_BYTES + 64);
+            if (!c) return NULL;
+            c->next = s->chunks;
+            s->chunks = c;
+            char *p = (char *)c + sizeof(SlChunk);
+            p = (char *)(((uintptr_t)p + 63) & ~(uintptr_t)63);
+            s->bump[level] = p;
+            s->bump_end[level] = (char *)c + SL_CHUNK_BYTES + 64;
+        }
+        b = (SlBlock *)s->bump[level];
+        s->bump[level] += need;
+    }
+    b->count = 0;
+    b->level = (uint8_t)level;
+    for (int l = 0; l < level; ++l) b->next[l] = NULL;
+    return b;
+}
+
+static inline void sl_release(SkipSet *s, SlBlock *b) {
+    b->next[0] = s->freelist[b->level];
+    s->freelist[b->level] = b;
+}
+
+static inline int sl_random_level(SkipSet *s) {
+    int l = 1;
+    for (;;) {
+        s->rng ^= s->rng << 13; s->rng ^= s->rng >> 17; s->rng ^= s->rng << 5;
+        if ((s->rng & 3) != 0 || l >= SL_MAX_LEVEL) break;   /* p = 1/4 */
+        ++l;
+    }
+    return l;
+}
+
+/*==================== 基本操作 ====================*/
+static inline bool sl_init(SkipSet *s) {
+    memset(s, 0, sizeof(*s));
+    s->rng = 2463534242u;
+    s->level = 1;
+    s->head = sl_alloc(s, SL_MAX_LEVEL);
+    if (!s->head) return false;
+    for (int l = 0; l < SL_MAX_LEVEL; ++l) s->last[l] = s->head;
+    return true;
+}
+
+static inline void sl_destroy(SkipSet *s) {
+    SlChunk *c = s->chunks;
+    while (c) {
+        SlChunk *n = c->next;
+        free(c);
+        c = n;
+    }
+    memset(s, 0, sizeof(*s));
+}
+
+/* pred[l] = 第 l 层最后一个首元素 < x 的块（或哨兵） */
+static inline void sl_find_preds(const SkipSet *s, long long x, SlBlock **pred) {
+    SlBlock *p = s->head;
+    for (int l = SL_MAX_LEVEL - 1; l >= 0; --l) {
+        if (l < s->level)
+            while (p->next[l] && p->next[l]->keys[0] < x) p = p->next[l];
+        pred[l] = p;
+    }
+}
+
+/* 块内第一个 >= x 的下标 */
+static inline int sl_block_lower(const SlBlock *b, long long x) {
+    int i = 0;
+    while (i < b->count && b->keys[i] < x) ++i;
+    return i;
+}
+
+static inline bool sl_contains(const SkipSet *s, int x) {
+    SlBlock *pred[SL_MAX_LEVEL];
+    sl_find_preds(s, (long long)x + 1, pred);     /* 最后一个首元素 <= x 的块 */
+    SlBlock *b = pred[0];
+    if (b == s->head) return false;
+    int i = sl_block_lower(b, x);
+    return i < b->count && b->keys[i] == x;
+}
+
+/* 第一个 >= x 的元素；不存在返回 false */
+static inline bool sl_seek(const SkipSet *s, int x, SlBlock **blk, int *idx) {
+    SlBlock *pred[SL_MAX_LEVEL];
+    sl_find_preds(s, x, pred);
+    SlBlock *b = pred[0] == s->head ? s->head->next[0] : pred[0];
+    while (b) {
+        int i = sl_block_lower(b, x);
+        if (i < b->count) { *blk = b; *idx = i; return true; }
+        b = b->next[0];
+    }
+    return false;
+}
+
+/* 把新块 n 挂到 pred[] 之后，并维护层数与各层尾指针 */
+static inline void sl_link_after(SkipSet *s, SlBlock **pred, SlBlock *n) {
+    if (n->level > s->level) s->level = n->level;
+    for (int l = 0; l < n->level; ++l) {
+        n->next[l] = pred[l]->next[l];
+        pred[l]->next[l] = n;
+        if (n->next[l] == NULL) s->last[l] = n;
+    }
+}
+
+/* 尾部追加：x 大于当前最大值时 O(1)，否则退化为一般插入 */
+static inline bool sl_insert(SkipSet *s, int x);
+
+static inline bool sl_append(SkipSet *s, int x) {
+    SlBlock *t = s->last[0];
+    if (t != s->head && t->keys[t->count - 1] >= x) return sl_insert(s, x);
+    if (t != s->head && t->count < SL_BLOCK) {
+        t->keys[t->count++] = x;
+        s->size++;
+        return true;
+    }
+    SlBlock *n = sl_alloc(s, sl_random_level(s));
+    if (!n) return false;
+    n->keys[0] = x;
+    n->count = 1;
+    sl_link_after(s, s->last, n);
+    s->size++;
+    return true;
+}
+
+static inline bool sl_insert(SkipSet *s, int x) {
+    SlBlock *pred[SL_MAX_LEVEL];
+    sl_find_preds(s, (long long)x + 1, pred);     /* 首元素 <= x 的最后一块 */
+    SlBlock *b = pred[0];
+    if (b == s->head) {                       /* x 比所有首元素都小：放进第一个块 */
+        b = s->head->next[0];
+        if (!b) return sl_append(s, x);
+        for (int l = 0; l < b->level; ++l) pred[l] = b;
+    }
+    int i = sl_block_lower(b, x);
+    if (i < b->count && b->keys[i] == x) return false;   /* 已存在 */
+
+    if (b->count == SL_BLOCK) {               /* 满了：对半分裂 */
+        SlBlock *n = sl_alloc(s, sl_random_level(s));
+        if (!n) return false;
+        int half = SL_BLOCK / 2;
+        memcpy(n->keys, b->keys + half, (SL_BLOCK - half) * sizeof(int));
+        n->count = SL_BLOCK - half;
+        b->count = (uint16_t)half;
+        for (int l = 0; l < b->level && l < n->level; ++l) pred[l] = b;
+        sl_link_after(s, pred, n);
+        if (i > half) { b = n; i -= half; }
+    }
+    memmove(b->keys + i + 1, b->keys + i, (size_t)(b->count - i) * sizeof(int));
+    b->keys[i] = x;
+    b->count++;
+    s->size++;
+    return true;
+}
+
+/* 删除 mink < x < maxk 的所有元素，返回删除个数 */
+static inline size_t sl_delete_range(SkipSet *s, int mink, int maxk) {
+    long long a = (long long)mink + 1, bnd = (long long)maxk - 1;   /* 闭区间 [a, bnd] */
+    if (a > bnd || s->size == 0) return 0;
+
+    SlBlock *pa[SL_MAX_LEVEL], *pb[SL_MAX_LEVEL];
+    sl_find_preds(s, a, pa);          /* 首元素 < a 的最后一块 */
+    sl_find_preds(s, bnd + 1, pb);    /* 首元素 <= bnd 的最后一块 */
+    SlBlock *A = pa[0], *Z = pb[0];
+    size_t removed = 0;
+
+    if (A == Z) {                     /* 区间落在同一块内（或为空） */
+        if (A == s->head) return 0;
+        int i = sl_block_lower(A, a), j = sl_block_lower(A, bnd + 1);
+        memmove(A->keys + i, A->keys + j, (size_t)(A->count - j) * sizeof(int));
+        A->count = (uint16_t)(A->count - (j - i));
+        s->size -= (size_t)(j - i);
+        return (size_t)(j - i);
+    }
+
+    /* 裁掉 A 中 >= a 的尾部（A 的首元素 < a，裁后不会为空） */
+    if (A != s->head) {
+        int i = sl_block_lower(A, a);
+        removed += (size_t)(A->count - i);
+        A->count = (uint16_t)i;
+    }
+    /* 裁掉 Z 中 <= bnd 的前缀 */
+    int j = sl_block_lower(Z, bnd + 1);
+    removed += (size_t)j;
+    memmove(Z->keys, Z->keys + j, (size_t)(Z->count - j) * sizeof(int));
+    Z->count = (uint16_t)(Z->count - j);
+    bool keepZ = Z->count > 0;
+
+    /* A 与 Z 之间（以及变空的 Z）整段摘下：每层只改一个指针 */
+    SlBlock *first_dead = A->next[0];
+    SlBlock *after = keepZ ? Z : Z->next[0];
+    for (int l = 0; l < s->level; ++l) {
+        if (pb[l] == pa[l]) continue;     /* 这一层在区间内没有块 */
+        pa[l]->next[l] = (keepZ && pb[l] == Z) ? Z : pb[l]->next[l];
+        if (pa[l]->next[l] == NULL) s->last[l] = pa[l];
+    }
+
+    /* 统计并归还整块删除的块 */
+    for (SlBlock *p = first_dead; p != after;) {
+        SlBlock *n = p->next[0];
+        if (p != Z) removed += p->count;
+        sl_release(s, p);
+        p = n;
+    }
+    s->size -= removed;
+    return removed;
+}
+
+static inline void sl_print(const SkipSet *s) {
+    for (SlBlock *b = s->head->next[0]; b; b = b->next[0])
+        for (int i = 0; i < b->count; ++i) printf("%d -> ", b->keys[i]);
+    printf("NULL\n");
+}
+
+#endif /* SKIPLIST_SET_H */
@@ -0,0 +1,249 @@
+/*
+ * 展开链表（unrolled linked list）：hw2 中 struct Node 单链表的替代，header-only
+ *
+ * struct Node 每个 int 要带一个 8 字节指针外加 malloc 的头部开销，遍历时几乎每一跳都是一次缓存缺失。
+ * 这里每个结点是一条 64 字节缓存行：next 指针 + 元素个数 + UL_CAP 个 int（默认 13 个），
+ * 结点按 64 字节对齐（从整块里切分），遍历时一次缺失换来 13 个元素。
+ *
+ * 保留原来那几种操作：
+ * - ul_push_back：尾部追加 O(1)（2_19.c / 2_24.c 的 add_node 每次从头走到尾）
+ * - ul_delete_range：有序表删除 mink < x < maxk，整块落在区间里的结点直接释放，
+ *   块外的结点只看最后一个元素就跳过
+ * - ul_merge：两个递增表合并（升序或降序，降序即 merge_and_reverse），边读边释放输入结点，
+ *   任意时刻额外占用不超过两个结点
+ * - ul_reverse：结点链反转 + 结点内反转
+ * - 迭代：ULIter / ul_next，或直接按结点两重循环
+ */
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef UL_NODE_BYTES
+#define UL_NODE_BYTES 64
+#endif
+#define UL_CAP ((UL_NODE_BYTES - sizeof(void *) - sizeof(int)) / sizeof(int))
+
+typedef struct ULNode {
+    struct ULNode *next;
+    int count;
+    int data[UL_CAP];
+} ULNode;
+
+typedef struct {
+    ULNode *head, *tail;
+    size_t size;
+} UList;
+
+/*
+ * 结点分配：逐个 posix_memalign 在 glibc 上很慢（每次都要切出对齐的块），
+ * 这里按 1MB 整块切分（走 mmap，不受堆碎片影响），释放的结点进空闲链表。池是全局的（每个翻译单元一份），不加锁，
+ * 所以结点可以在表之间自由移动（合并时就是这样），但不能多线程同时使用。
+ */
+#define UL_CHUNK_BYTES (1024 * 1024)
+
+typedef struct {
+    ULNode *free_nodes;
+    char *bump, *bump_end;
+    void **chunks;                  /* 每个整块开头存下一个整块的地址 */
+} ULPool;
+
+static ULPool ul_pool;
+
+/* 与 create_node 相同：内存不足直接退出 */
+static inline ULNode *ul_node_new(void) {
+    ULNode *n = ul_pool.free_nodes;
+    if (n) {
+        ul_pool.free_nodes = n->next;
+    } else {
+        if (ul_pool.bump == ul_pool.bump_end) {
+            void *c = NULL;
+            if (posix_memalign(&c, UL_NODE_BYTES, UL_CHUNK_BYTES) != 0) {
+                perror("posix_memalign");
+                exit(EXIT_FAILURE);
+            }
+            *(void **)c = ul_pool.chunks;
+            ul_pool.chunks = (void **)c;
+            ul_pool.bump = (char *)c + UL_NODE_BYTES;     /* 第一个位置留给链接 */
+            ul_pool.bump_end = (char *)c + UL_CHUNK_BYTES / UL_NODE_BYTES * UL_NODE_BYTES;
+        }
+        n = (ULNode *)ul_pool.bump;
+        ul_pool.bump += UL_NODE_BYTES;
+    }
+    n->next = NULL;
+    n->count = 0;
+    return n;
+}
+
+static inline void ul_node_free(ULNode *n) {
+    n->next = ul_pool.free_nodes;
+    ul_pool.free_nodes = n;
+}
+
+/* 把池中所有内存还给系统；调用时不能再有存活的 UList */
+static inline void ul_pool_release(void) {
+    void **c = ul_pool.chunks;
+    while (c) {
+        void **next = (void **)*c;
+        free(c);
+        c = next;
+    }
+    memset(&ul_pool, 0, sizeof(ul_pool));
+}
+
+static inline void ul_init(UList *L) { L->head = L->tail = NULL; L->size = 0; }
+
+static inline void ul_free(UList *L) {
+    ULNode *p = L->head;
+    while (p) {
+        ULNode *n = p->next;
+        ul_node_free(p);
+        p = n;
+    }
+    ul_init(L);
+}
+
+/* 尾部追加 */
+static inline void ul_push_back(UList *L, int x) {
+    ULNode *t = L->tail;
+    if (!t || t->count == (int)UL_CAP) {
+        ULNode *n = ul_node_new();
+        if (t) t->next = n;
+        else L->head = n;
+        L->tail = t = n;
+    }
+    t->data[t->count++] = x;
+    L->size++;
+}
+
+/* 已知递增，删除 mink < x < maxk 的元素，返回删除个数 */
+static inline size_t ul_delete_range(UList *L, int mink, int maxk) {
+    size_t removed = 0;
+    ULNode *prev = NULL, *p = L->head;
+    /* 整个结点都 <= mink：只看最后一个元素就跳过 */
+    while (p && p->data[p->count - 1] <= mink) { prev = p; p = p->next; }
+    ULNode *left = prev;            /* 区间左侧保持不动的最后一个结点 */
+    while (p) {
+        int c = p->count, i = 0;
+        while (i < c && p->data[i] <= mink) ++i;
+        int j = i;
+        while (j < c && p->data[j] < maxk) ++j;
+        removed += (size_t)(j - i);
+        if (i == 0 && j == c) {     /* 整块都在区间内：摘下释放 */
+            ULNode *n = p->next;
+            if (prev) prev->next = n;
+            else L->head = n;
+            if (L->tail == p) L->tail = prev;
+            ul_node_free(p);
+            p = n;
+            continue;
+        }
+        memmove(p->data + i, p->data + j, (size_t)(c - j) * sizeof(int));
+        p->count = c - (j - i);
+        if (i > 0) left = p;        /* 左端结点被裁掉了尾部 */
+        if (j < c) break;           /* 碰到 >= maxk 的元素，后面不用再看 */
+        prev = p;
+        p = p->next;
+    }
+    /* 中间的结点都已释放，左端与右端相邻：两者能放进一个结点就并起来 */
+    ULNode *n = left ? left->next : NULL;
+    if (n && left->count + n->count <= (int)UL_CAP) {
+        memcpy(left->data + left->count, n->data, (size_t)n->count * sizeof(int));
+        left->count += n->count;
+        left->next = n->next;
+        if (L->tail == n) L->tail = left;
+        ul_node_free(n);
+    }
+    L->size -= removed;
+    return removed;
+}
+
+/* 结点链反转，每个结点内部也反转 */
+static inline void ul_reverse(UList *L) {
+    ULNode *prev = NULL, *p = L->head;
+    L->tail = p;
+    while (p) {
+        for (int i = 0, j = p->count - 1; i < j; ++i, --j) {
+            int t = p->data[i]; p->data[i] = p->data[j]; p->data[j] = t;
+        }
+        ULNode *n = p->next;
+        p->next = prev;
+        prev = p;
+        p = n;
+    }
+    L->head = prev;
+}
+
+/*
+ * 两个递增表合并为 *out（升序；descending 时再整体反转，即 merge_and_reverse）。
+ * 输入结点读完即释放，一方读完后另一方剩下的整结点直接挂到 out 尾部；a、b 合并后为空。
+ */
+static inline void ul_merge(UList *out, UList *a, UList *b, bool descending) {
+    ul_init(out);
+    ULNode *pa = a->head, *pb = b->head;
+    int ia = 0, ib = 0;
+    while (pa && pb) {
+        if (pa->data[ia] <= pb->data[ib]) {
+            ul_push_back(out, pa->data[ia]);
+            if (++ia == pa->count) {
+                ULNode *n = pa->next;
+                ul_node_free(pa);
+                pa = n;
+                ia = 0;
+            }
+        } else {
+            ul_push_back(out, pb->data[ib]);
+            if (++ib == pb->count) {
+                ULNode *n = pb->next;
+                ul_node_free(pb);
+                pb = n;
+                ib = 0;
+            }
+        }
+    }
+    ULNode *rest = pa ? pa : pb;
+    int ir = pa ? ia : ib;
+    if (rest) {
+        for (; ir < rest->count; ++ir) ul_push_back(out, rest->data[ir]);
+        ULNode *n = rest->next;
+        ul_node_free(rest);
+        if (n) {
+            if (out->tail) out->tail->next = n;
+            else out->head = n;
+            for (; n; n = n->next) {
+                out->size += (size_t)n->count;
+                out->tail = n;
+            }
+        }
+    }
+    ul_init(a);
+    ul_init(b);
+    if (descending) ul_reverse(out);
+}
+
+/*==================== 迭代 ====================*/
+typedef struct {
+    const ULNode *node;
+    int i;
+} ULIter;
+
+static inline ULIter ul_begin(const UList *L) { ULIter it = {L->head, 0}; return it; }
+
+static inline bool ul_next(ULIter *it, int *x) {
+    while (it->node && it->i == it->node->count) { it->node = it->node->next; it->i = 0; }
+    if (!it->node) return false;
+    *x = it->node->data[it->i++];
+    return true;
+}
+
+static inline void ul_print(const UList *L) {
+    for (const ULNode *p = L->head; p; p = p->next)
+        for (int i = 0; i < p->count; ++i) printf("%d -> ", p->data[i]);
+    printf("NULL\n");
+}
+
+#endif /* UNROLLED_LIST_H */
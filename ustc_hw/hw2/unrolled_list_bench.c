@@ -0,0 +1,300 @@
+// 展开链表（unrolled_list.h）与 struct Node 单链表的对比：追加、遍历、区间删除、合并、反转
+// 编译: gcc -O2 unrolled_list_bench.c -o unrolled_list_bench
+// 用法: unrolled_list_bench [元素数，默认 10000000]
+// Linux 下用 perf_event_open 读取 cycles / instructions / L1D 读缺失 / LLC 缺失；
+// 没有权限（perf_event_paranoid）或非 Linux 时只报时间。
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unrolled_list.h"
+#include "../../include/bench_util.h"
+
+/* Linux 下读 cycles / instructions / L1D 读缺失 / LLC 缺失 */
+static const HwEvent hw_events[] = {HW_CYCLES, HW_INSTR, HW_L1D_MISS, HW_LLC_MISS};
+
+/* 计时 + 计数，按每元素打印 */
+static HwCounters hw;
+static double t_begin;
+
+static void measure_begin(void) {
+    hw_start(&hw);
+    t_begin = now_sec();
+}
+
+static void measure_end(const char *what, size_t n) {
+    double t = now_sec() - t_begin;
+    hw_stop(&hw);
+    printf("  %8.1f ms", t * 1e3);
+    for (int i = 0; i < hw.n; ++i) {
+        if (hw.val[i] >= 0) printf("  %s/elem %6.2f", hw_name(hw.ev[i]), (double)hw.val[i] / (double)n);
+    }
+    printf("  %s\n", what);
+}
+
+/*==================== struct Node 对照组（同 2_19.c / 2_24.c） ====================*/
+struct Node {
+    int data;
+    struct Node* next;
+};
+
+struct Node* create_node(int data) {
+    struct Node* new_node = (struct Node*)malloc(sizeof(struct Node));
+    if (!new_node) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    new_node->data = data;
+    new_node->next = NULL;
+    return new_node;
+}
+
+struct Node* delete_range(struct Node* head, int mink, int maxk) {
+    while (head != NULL && head->data > mink && head->data < maxk) {
+        struct Node* temp = head;
+        head = head->next;
+        free(temp);
+    }
+
+    if (head == NULL) return NULL;
+
+    struct Node* curr = head;
+    while (curr != NULL && curr->next != NULL) {
+        if (curr->next->data > mink && curr->next->data < maxk) {
+            struct Node* temp = curr->next;
+            curr->next = curr->next->next;
+            free(temp);
+        } else {
+            curr = curr->next;
+        }
+    }
+    return head;
+}
+
+struct Node* merge_and_reverse(struct Node* l1, struct Node* l2) {
+    struct Node* merged = NULL;
+    while (l1 != NULL && l2 != NULL) {
+        if (l1->data < l2->data) {
+            struct Node* next = l1->next;
+            l1->next = merged;
+            merged = l1;
+            l1 = next;
+        } else {
+            struct Node* next = l2->next;
+            l2->next = merged;
+            merged = l2;
+            l2 = next;
+        }
+    }
+    while (l1 != NULL) {
+        struct Node* next = l1->next;
+        l1->next = merged;
+        merged = l1;
+        l1 = next;
+    }
+    while (l2 != NULL) {
+        struct Node* next = l2->next;
+        l2->next = merged;
+        merged = l2;
+        l2 = next;
+    }
+    return merged;
+}
+
+static struct Node* reverse_list(struct Node* head) {
+    struct Node* prev = NULL;
+    while (head) {
+        struct Node* next = head->next;
+        head->next = prev;
+        prev = head;
+        head = next;
+    }
+    return prev;
+}
+
+static void free_list(struct Node* head) {
+    while (head) {
+        struct Node* next = head->next;
+        free(head);
+        head = next;
+    }
+}
+
+/*
+ * 建一个值为 v[0..n) 的链表。原来的 add_node 每次从头走到尾是 O(n^2)，这里带尾指针。
+ * shuffle 为真时先把结点按随机顺序分配好再链起来，模拟长时间运行后堆里结点分散的情况。
+ */
+static struct Node* build_list(const int *v, size_t n, int shuffle, unsigned seed) {
+    struct Node **nodes = (struct Node **)malloc(n * sizeof(*nodes));
+    for (size_t i = 0; i < n; ++i) nodes[i] = create_node(0);
+    if (shuffle) {
+        unsigned x = seed;
+        for (size_t i = n; i > 1; --i) {
+            x = x * 1664525u + 1013904223u;
+            size_t j = ((size_t)x << 16 ^ (x >> 8)) % i;
+            struct Node *t = nodes[i - 1]; nodes[i - 1] = nodes[j]; nodes[j] = t;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        nodes[i]->data = v[i];
+        nodes[i]->next = i + 1 < n ? nodes[i + 1] : NULL;
+    }
+    struct Node *head = n ? nodes[0] : NULL;
+    free(nodes);
+    return head;
+}
+
+/*==================== 测试 ====================*/
+static volatile long long sink;
+
+static void bench_node_list(const int *va, const int *vb, size_t n, int shuffle) {
+    printf("struct Node 链表（%s）:\n", shuffle ? "结点地址打乱" : "按分配顺序");
+    struct Node *a = build_list(va, n, shuffle, 1), *b = build_list(vb, n, shuffle, 2);
+
+    measure_begin();
+    long long s = 0;
+    for (struct Node *p = a; p; p = p->next) s += p->data;
+    sink = s;
+    measure_end("遍历求和", n);
+
+    measure_begin();
+    a = reverse_list(a);
+    measure_end("反转", n);
+    a = reverse_list(a);
+
+    measure_begin();
+    struct Node *m = merge_and_reverse(a, b);
+    measure_end("merge_and_reverse", 2 * n);
+    m = reverse_list(m);            /* 恢复升序 */
+
+    measure_begin();
+    m = delete_range(m, (int)(n / 2), (int)(n / 2 + n / 4));
+    measure_end("delete_range (删 1/8)", 2 * n);
+    free_list(m);
+}
+
+static void bench_unrolled(const int *va, const int *vb, size_t n) {
+    printf("展开链表（每结点 %zu 个 int）:\n", (size_t)UL_CAP);
+    UList a, b, m;
+    ul_init(&a);
+    ul_init(&b);
+    measure_begin();
+    for (size_t i = 0; i < n; ++i) ul_push_back(&a, va[i]);
+    measure_end("ul_push_back", n);
+    for (size_t i = 0; i < n; ++i) ul_push_back(&b, vb[i]);
+
+    measure_begin();
+    long long s = 0;
+    for (const ULNode *p = a.head; p; p = p->next)
+        for (int i = 0; i < p->count; ++i) s += p->data[i];
+    sink = s;
+    measure_end("遍历求和", n);
+
+    measure_begin();
+    ULIter it = ul_begin(&a);
+    int x;
+    s = 0;
+    while (ul_next(&it, &x)) s += x;
+    sink = s;
+    measure_end("遍历求和 (ULIter)", n);
+
+    measure_begin();
+    ul_reverse(&a);
+    measure_end("ul_reverse", n);
+    ul_reverse(&a);
+
+    measure_begin();
+    ul_merge(&m, &a, &b, true);
+    measure_end("ul_merge (降序)", 2 * n);
+    ul_reverse(&m);
+
+    measure_begin();
+    ul_delete_range(&m, (int)(n / 2), (int)(n / 2 + n / 4));
+    measure_end("ul_delete_range (删 1/8)", 2 * n);
+    ul_free(&m);
+}
+
+/* 小规模随机操作，与 struct Node 版本逐个比对 */
+static int cross_check(void) {
+    unsigned x = 12345;
+    for (int round = 0; round < 200; ++round) {
+        int na = (int)(x % 300), nb;
+        x = x * 1664525u + 1013904223u;
+        nb = (int)(x >> 8) % 300;
+        int *va = (int *)malloc((size_t)(na + 1) * sizeof(int)), *vb = (int *)malloc((size_t)(nb + 1) * sizeof(int));
+        int v = 0;
+        for (int i = 0; i < na; ++i) { x = x * 1664525u + 1013904223u; v += (int)(x >> 28); va[i] = v; }
+        v = 0;
+        for (int i = 0; i < nb; ++i) { x = x * 1664525u + 1013904223u; v += (int)(x >> 28); vb[i] = v; }
+
+        struct Node *la = build_list(va, (size_t)na, 0, 0), *lb = build_list(vb, (size_t)nb, 0, 0);
+        UList ua, ub, um;
+        ul_init(&ua); ul_init(&ub);
+        for (int i = 0; i < na; ++i) ul_push_back(&ua, va[i]);
+        for (int i = 0; i < nb; ++i) ul_push_back(&ub, vb[i]);
+
+        struct Node *lm = merge_and_reverse(la, lb);
+        ul_merge(&um, &ua, &ub, true);
+        lm = reverse_list(lm);
+        ul_reverse(&um);
+        for (int d = 0; d < 5; ++d) {
+            x = x * 1664525u + 1013904223u;
+            int lo = (int)(x >> 8) % (v + 10) - 5, hi = lo + (int)(x >> 20) % 200;
+            lm = delete_range(lm, lo, hi);
+            ul_delete_range(&um, lo, hi);
+        }
+        ULIter it = ul_begin(&um);
+        struct Node *p = lm;
+        int y = 0, bad = 0;
+        size_t cnt = 0;
+        while (ul_next(&it, &y)) {
+            bad |= !p || p->data != y;
+            if (p) p = p->next;
+            cnt++;
+        }
+        bad |= p != NULL || cnt != um.size;
+        ul_push_back(&um, 1 << 30);     /* 删除后 tail 必须仍指向最后一个结点 */
+        it = ul_begin(&um);
+        cnt = 0;
+        while (ul_next(&it, &y)) cnt++;
+        bad |= cnt != um.size || y != (1 << 30);
+        free_list(lm);
+        ul_free(&um);
+        free(va); free(vb);
+        if (bad) return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 10000000;
+
+    /* 与 2_19.c 相同的小例子 */
+    UList L;
+    ul_init(&L);
+    for (int x = 1; x <= 9; ++x) ul_push_back(&L, x);
+    printf("Original list: \n");
+    ul_print(&L);
+    ul_delete_range(&L, 4, 8);
+    printf("List after deleting nodes with values in range [%d, %d]: \n", 4, 8);
+    ul_print(&L);
+    ul_free(&L);
+
+    printf("交叉验证: %s\n\n", cross_check() ? "通过" : "失败");
+
+    hw_open(&hw, hw_events, (int)(sizeof(hw_events) / sizeof(hw_events[0])));
+    if (hw.fd[0] < 0) printf("（无法打开硬件计数器，只报时间）\n");
+
+    /* 两个递增序列：偶数和奇数，合并后交错 */
+    int *va = (int *)calloc(n, sizeof(int)), *vb = (int *)calloc(n, sizeof(int));
+    for (size_t i = 0; i < n; ++i) { va[i] = (int)(2 * i); vb[i] = (int)(2 * i + 1); }
+    printf("元素数 %zu\n", n);
+    /* 展开链表放在最前：释放上千万个小结点之后，glibc 下一次大块分配要先合并 fastbin，会被算到它头上 */
+    bench_unrolled(va, vb, n);
+    bench_node_list(va, vb, n, 0);
+    bench_node_list(va, vb, n, 1);
+    free(va);
+    free(vb);
+    ul_pool_release();
+    hw_close(&hw);
+    return 0;
+}
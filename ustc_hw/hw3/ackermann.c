@@ -4,11 +4,14 @@
  * - 非递归算法: akm_iter
  * - 非递归算法带轨迹打印: akm_iter_trace
  * - 递归算法带轨迹打印: akm_rec_trace
+ * - 闭式 + 记忆化 + 溢出检测: akm_fast
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
 
 /*==================== 递归版本 ====================*/
 unsigned long long akm_rec(unsigned int m, unsigned int n) {
@@ -125,6 +128,233 @@ unsigned long long akm_rec_trace(unsigned m, unsigned n, int depth){
     return r;
 }
 
+/*==================== 闭式 + 记忆化版本 ====================*/
+/*
+ * m <= 3 直接用闭式:
+ *   A(0,n) = n+1, A(1,n) = n+2, A(2,n) = 2n+3, A(3,n) = 2^(n+3)-3
+ * m >= 4 按 A(m,n) = A(m-1, A(m,n-1)) 逐个 n 向上迭代，中间结果 (m,n) 存入哈希表。
+ * 结果超出 64 位时返回 false，不会像 unsigned 那样静默回绕。
+ */
+static bool akm_closed(unsigned m, uint64_t n, uint64_t *out) {
+    switch (m) {
+    case 0:
+        if (n == UINT64_MAX) return false;
+        *out = n + 1; return true;
+    case 1:
+        if (n > UINT64_MAX - 2) return false;
+        *out = n + 2; return true;
+    case 2:
+        if (n > (UINT64_MAX - 3) / 2) return false;
+        *out = 2 * n + 3; return true;
+    default: /* m == 3 */
+        if (n > 61) return false;           /* 2^(n+3)-3 需要 n+3 <= 64 */
+        *out = (n == 61) ? UINT64_MAX - 2 : (1ULL << (n + 3)) - 3;
+        return true;
+    }
+}
+
+/* 开放定址哈希表：key=(m,n)，value=结果或溢出标记 */
+typedef struct {
+    uint64_t n;
+    uint64_t val;
+    unsigned m;       /* 0 表示空槽（表中只存 m>=4 的项） */
+    bool ok;
+} MemoSlot;
+
+/* 每个 m 的概况：A(m,0..top) 都已入表；A(m,·) 严格递增，n >= ovf_n 时必然溢出 */
+typedef struct {
+    bool any;
+    uint64_t top, top_val;
+    bool ovf;
+    uint64_t ovf_n;
+} MemoRow;
+
+typedef struct {
+    MemoSlot *slot;
+    size_t cap, size;   /* cap 为 2 的幂 */
+    MemoRow *row;       /* row[m]，按需增长 */
+    unsigned nrow;
+    bool nomem;         /* 分配失败过：不再扩容，表满（或没有表）时不再入表，结果照算 */
+} AkmMemo;
+
+static void memo_init(AkmMemo *h) {
+    h->size = 0;
+    h->slot = (MemoSlot*)calloc(64, sizeof(MemoSlot));
+    h->cap = h->slot ? 64 : 0;
+    h->nomem = !h->slot;
+    if (h->nomem) fprintf(stderr, "ackermann: memo table allocation failed, running uncached\n");
+    h->row = NULL;
+    h->nrow = 0;
+}
+static void memo_free(AkmMemo *h) {
+    free(h->slot); h->slot = NULL; h->cap = h->size = 0;
+    free(h->row); h->row = NULL; h->nrow = 0;
+}
+
+/* 内存不足时返回 NULL */
+static MemoRow *memo_row(AkmMemo *h, unsigned m) {
+    if (m >= h->nrow) {
+        unsigned n = h->nrow ? h->nrow : 8;
+        while (n <= m) n *= 2;
+        MemoRow *r = (MemoRow*)realloc(h->row, n * sizeof(MemoRow));
+        if (!r) return NULL;
+        for (unsigned i = h->nrow; i < n; ++i) r[i].any = r[i].ovf = false;
+        h->row = r;
+        h->nrow = n;
+    }
+    return &h->row[m];
+}
+
+static size_t memo_hash(unsigned m, uint64_t n) {
+    uint64_t x = n * 0x9E3779B97F4A7C15ULL ^ (uint64_t)m * 0xC2B2AE3D27D4EB4FULL;
+    return (size_t)(x ^ (x >> 29));
+}
+
+static MemoSlot *memo_find(const AkmMemo *h, unsigned m, uint64_t n) {
+    if (!h->slot) return NULL;
+    size_t i = memo_hash(m, n) & (h->cap - 1);
+    while (h->slot[i].m != 0) {
+        if (h->slot[i].m == m && h->slot[i].n == n) return &h->slot[i];
+        i = (i + 1) & (h->cap - 1);
+    }
+    return NULL;
+}
+
+static void memo_put(AkmMemo *h, unsigned m, uint64_t n, bool ok, uint64_t val);
+
+/* 容量翻倍；内存不足时保留原表并返回 false */
+static bool memo_grow(AkmMemo *h) {
+    MemoSlot *slot = (MemoSlot*)calloc(h->cap * 2, sizeof(MemoSlot));
+    if (!slot) {
+        fprintf(stderr, "ackermann: memo table growth failed, keeping %zu slots\n", h->cap);
+        h->nomem = true;
+        return false;
+    }
+    MemoSlot *old = h->slot;
+    size_t oldcap = h->cap;
+    h->slot = slot;
+    h->cap *= 2;
+    h->size = 0;
+    for (size_t i = 0; i < oldcap; ++i)
+        if (old[i].m != 0) memo_put(h, old[i].m, old[i].n, old[i].ok, old[i].val);
+    free(old);
+    return true;
+}
+
+static void memo_put(AkmMemo *h, unsigned m, uint64_t n, bool ok, uint64_t val) {
+    if ((h->size + 1) * 2 > h->cap && (h->nomem || !memo_grow(h))) {   /* 装载因子 <= 1/2 */
+        if (h->size + 1 >= h->cap) return;        /* 至少留一个空槽，memo_find 才能停下 */
+    }
+    size_t i = memo_hash(m, n) & (h->cap - 1);
+    while (h->slot[i].m != 0) {
+        if (h->slot[i].m == m && h->slot[i].n == n) break;
+        i = (i + 1) & (h->cap - 1);
+    }
+    if (h->slot[i].m == 0) h->size++;
+    h->slot[i].m = m; h->slot[i].n = n; h->slot[i].ok = ok; h->slot[i].val = val;
+}
+
+static bool akm_memo(AkmMemo *h, unsigned m, uint64_t n, uint64_t *out) {
+    if (m <= 3) return akm_closed(m, n, out);
+
+    MemoRow *row = memo_row(h, m);
+    if (!row) return false;
+    if (row->ovf && n >= row->ovf_n) return false;
+
+    MemoSlot *s = memo_find(h, m, n);
+    if (s) { *out = s->val; return s->ok; }
+
+    /* 从已入表的最大 top（< n，否则上面已命中）逐个向上推；A(m,·) 严格递增，
+       一旦溢出就记下阈值，更大的 n 直接返回 */
+    uint64_t j, r;
+    bool ok;
+    if (row->any) {
+        j = row->top;
+        r = row->top_val;
+    } else {
+        j = 0;
+        ok = akm_memo(h, m - 1, 1, &r);
+        row = &h->row[m];                     /* 递归可能扩容 row 数组 */
+        if (!ok) { row->ovf = true; row->ovf_n = 0; return false; }
+        memo_put(h, m, 0, true, r);
+        row->any = true; row->top = 0; row->top_val = r;
+    }
+    while (j < n) {
+        ok = akm_memo(h, m - 1, r, &r);
+        row = &h->row[m];
+        ++j;
+        if (!ok) { row->ovf = true; row->ovf_n = j; return false; }
+        memo_put(h, m, j, true, r);
+        row->top = j; row->top_val = r;
+    }
+    *out = r;
+    return true;
+}
+
+/* 返回 false 表示 A(m,n) 超出 64 位；memo 可为 NULL（此时内部临时建表） */
+bool akm_fast(unsigned m, uint64_t n, uint64_t *out, AkmMemo *memo) {
+    if (m <= 3) return akm_closed(m, n, out);
+    if (memo) return akm_memo(memo, m, n, out);
+    AkmMemo tmp; memo_init(&tmp);
+    bool ok = akm_memo(&tmp, m, n, out);
+    memo_free(&tmp);
+    return ok;
+}
+
+/*==================== 对比测试 ====================*/
+/* 在 akm_iter 能在可接受时间内算完的 (m,n) 网格上比较两者的结果与耗时 */
+static void bench_grid(void) {
+    static const unsigned nmax[] = {4000, 4000, 1000, 12}; /* m=0..3 的 n 上限 */
+    uint64_t sink = 0;
+    int cells = 0, mismatch = 0;
+
+    clock_t t0 = clock();
+    for (unsigned m = 0; m <= 3; ++m)
+        for (unsigned n = 0; n <= nmax[m]; ++n) { sink += akm_iter(m, n); cells++; }
+    sink += akm_iter(4, 0); cells++;
+    double t_iter = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    AkmMemo memo; memo_init(&memo);
+    t0 = clock();
+    const int rounds = 1000;                  /* 闭式太快，重复多轮才能计时 */
+    for (int k = 0; k < rounds; ++k) {
+        for (unsigned m = 0; m <= 3; ++m)
+            for (unsigned n = 0; n <= nmax[m]; ++n) { uint64_t r; akm_fast(m, n, &r, &memo); sink += r; }
+        uint64_t r; akm_fast(4, 0, &r, &memo); sink += r;
+    }
+    double t_fast = (double)(clock() - t0) / CLOCKS_PER_SEC / rounds;
+
+    for (unsigned m = 0; m <= 3; ++m)
+        for (unsigned n = 0; n <= nmax[m]; ++n) {
+            uint64_t r;
+            if (!akm_fast(m, n, &r, &memo) || r != akm_iter(m, n)) mismatch++;
+        }
+
+    printf("网格 %d 个点: akm_iter %.3f s, akm_fast %.3f us, 不一致 %d (sink=%llu)\n",
+           cells, t_iter, t_fast * 1e6, mismatch, (unsigned long long)(sink & 1));
+
+    /* akm_iter 无法触及的点 */
+    static const unsigned far[][2] = {{3, 60}, {3, 61}, {3, 62}, {4, 1}, {4, 2}, {5, 0}, {5, 1}, {6, 0}};
+    for (size_t i = 0; i < sizeof(far) / sizeof(far[0]); ++i) {
+        uint64_t r;
+        if (akm_fast(far[i][0], far[i][1], &r, &memo))
+            printf("akm_fast(%u,%u) = %llu\n", far[i][0], far[i][1], (unsigned long long)r);
+        else
+            printf("akm_fast(%u,%u) 溢出 64 位\n", far[i][0], far[i][1]);
+    }
+    /* 很大的 n：溢出阈值记在表里，不需要逐个往回找 */
+    static const uint64_t huge[] = {3000000000ULL, UINT64_MAX};
+    for (size_t i = 0; i < sizeof(huge) / sizeof(huge[0]); ++i) {
+        uint64_t r;
+        clock_t t1 = clock();
+        bool ok = akm_fast(4, huge[i], &r, &memo);
+        double ms = (double)(clock() - t1) * 1e3 / CLOCKS_PER_SEC;
+        if (ok) printf("akm_fast(4,%llu) = %llu (%.3f ms)\n", (unsigned long long)huge[i], (unsigned long long)r, ms);
+        else printf("akm_fast(4,%llu) 溢出 64 位 (%.3f ms)\n", (unsigned long long)huge[i], ms);
+    }
+    memo_free(&memo);
+}
+
 /*==================== 测试 ====================*/
 int main(void){
     unsigned int m = 2, n = 1;
@@ -142,5 +372,9 @@ int main(void){
     unsigned long long r3 = akm_rec_trace(m, n, 0);
     printf("\nResult from akm_rec_trace: akm(%u,%u) = %llu\n", m, n, r3);
 
+    /* 闭式 + 记忆化 与 akm_iter 对比 */
+    printf("\n");
+    bench_grid();
+
     return 0;
 }
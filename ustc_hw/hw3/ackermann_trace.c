@@ -0,0 +1,436 @@
+/*
+ * Ackermann 求值轨迹的低开销记录（对应 ackermann.c 中的 akm_iter_trace / akm_rec_trace）
+ *
+ * 原版每一步都 printf（缩进还是逐个 putchar），追踪 akm(3,n) 时时间几乎全花在 stdio 上。
+ * 这里改为二进制环形缓冲：
+ * - 热路径只写一条定长事件记录（32 字节），不做任何格式化
+ * - 每个线程一块环形缓冲（_Thread_local），写满一个块就交给该线程的后台刷写线程 fwrite
+ * - 离线解码器读回事件，输出与原 printf 版本逐字节相同的文本
+ *
+ * 用法:
+ *   ackermann_trace              对比 printf 版与二进制版的 ns/event，并校验解码结果
+ *   ackermann_trace decode FILE  把二进制轨迹还原为文本
+ *
+ * 编译: gcc -O2 ackermann_trace.c -o ackermann_trace -lpthread
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../../include/bench_util.h"
+
+/*==================== 事件格式 ====================*/
+enum {
+    EV_ITER_BEGIN = 1,  /* m, a=n                     */
+    EV_ITER_STATE,      /* m, a=n        每步开头打印的状态行 */
+    EV_ITER_INC,        /* a=n           m==0 -> n=n+1 */
+    EV_ITER_RESULT,     /* a=n           栈空，得到结果 */
+    EV_ITER_POP,        /* m             弹栈恢复外层  */
+    EV_ITER_REDUCE,     /* m, a=n        n==0 -> (m-1,1) */
+    EV_ITER_PUSH,       /* m, a=n        push(m-1) & n-- */
+    EV_REC_BEGIN,       /* m, a=n        */
+    EV_REC_CALL,        /* m, a=n, depth */
+    EV_REC_RET0,        /* m, a=n, b=r, depth （m==0 分支） */
+    EV_REC_RET,         /* m, a=n, b=r, depth */
+    EV_REC_REDUCE,      /* m, a=n, depth  -> reduce to akm(m,n) */
+    EV_REC_INNER,       /* m, a=n, depth  -> compute inner t = akm(m,n) */
+    EV_REC_THEN,        /* m, a=t, depth  -> then compute akm(m,t) */
+    EV_REC_END          /* m, a=n, b=r   */
+};
+
+typedef struct {
+    uint16_t kind;
+    uint16_t reserved;
+    uint32_t m;
+    uint32_t depth;         /* 递归版的缩进量 */
+    uint32_t reserved2;
+    uint64_t a, b;
+} TraceEvent;               /* 32 字节 */
+
+static const char TRACE_MAGIC[8] = {'A', 'K', 'M', 'T', 'R', 'C', '1', 0};
+
+/*==================== 每线程环形缓冲 ====================*/
+#define TR_BLOCK_EVENTS 4096    /* 每块事件数（128KB） */
+#define TR_NBLOCKS 16           /* 环中块数 */
+
+typedef struct {
+    TraceEvent blocks[TR_NBLOCKS][TR_BLOCK_EVENTS];
+    uint32_t fill[TR_NBLOCKS];  /* 已提交块中的事件数 */
+    atomic_ulong head;          /* 已提交块数（生产者） */
+    atomic_ulong tail;          /* 已写盘块数（刷写线程） */
+    atomic_bool stop;
+    unsigned pos;               /* 当前块中的写入位置 */
+    unsigned long long events;
+    FILE *out;
+    pthread_t flusher;
+} TraceRing;
+
+static _Thread_local TraceRing *tls_ring = NULL;
+
+static void *tr_flush_main(void *arg) {
+    TraceRing *r = (TraceRing *)arg;
+    for (;;) {
+        unsigned long t = atomic_load_explicit(&r->tail, memory_order_relaxed);
+        unsigned long h = atomic_load_explicit(&r->head, memory_order_acquire);
+        if (t < h) {
+            unsigned idx = (unsigned)(t % TR_NBLOCKS);
+            fwrite(r->blocks[idx], sizeof(TraceEvent), r->fill[idx], r->out);
+            atomic_store_explicit(&r->tail, t + 1, memory_order_release);
+        } else if (atomic_load_explicit(&r->stop, memory_order_acquire)) {
+            /* stop 之前提交的最后一块可能在上面读 head 之后才到：重读 head，写完再退出 */
+            if (atomic_load_explicit(&r->head, memory_order_acquire) == t) break;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* 为当前线程打开轨迹文件；返回 false 表示失败 */
+bool tr_open(const char *path) {
+    TraceRing *r = (TraceRing *)calloc(1, sizeof(TraceRing));
+    if (!r) return false;
+    r->out = fopen(path, "wb");
+    if (!r->out) { free(r); return false; }
+    fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), r->out);
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    atomic_init(&r->stop, false);
+    if (pthread_create(&r->flusher, NULL, tr_flush_main, r) != 0) {
+        fclose(r->out); free(r); return false;
+    }
+    tls_ring = r;
+    return true;
+}
+
+/* 提交当前块；若环已满则等待刷写线程腾出空间（不丢事件） */
+static void tr_submit(TraceRing *r) {
+    unsigned long h = atomic_load_explicit(&r->head, memory_order_relaxed);
+    r->fill[h % TR_NBLOCKS] = r->pos;
+    atomic_store_explicit(&r->head, h + 1, memory_order_release);
+    r->pos = 0;
+    while (h + 1 - atomic_load_explicit(&r->tail, memory_order_acquire) >= TR_NBLOCKS)
+        sched_yield();
+}
+
+/* 热路径：只做一次定长写入 */
+static inline void tr_emit(uint16_t kind, uint32_t depth, uint32_t m, uint64_t a, uint64_t b) {
+    TraceRing *r = tls_ring;
+    if (!r) return;
+    unsigned long h = atomic_load_explicit(&r->head, memory_order_relaxed);
+    TraceEvent *e = &r->blocks[h % TR_NBLOCKS][r->pos];
+    e->kind = kind; e->reserved = 0; e->depth = depth; e->reserved2 = 0; e->m = m; e->a = a; e->b = b;
+    r->events++;
+    if (++r->pos == TR_BLOCK_EVENTS) tr_submit(r);
+}
+
+/* 刷出剩余事件并关闭；返回本线程记录的事件数 */
+unsigned long long tr_close(void) {
+    TraceRing *r = tls_ring;
+    if (!r) return 0;
+    if (r->pos > 0) tr_submit(r);
+    atomic_store_explicit(&r->stop, true, memory_order_release);
+    pthread_join(r->flusher, NULL);
+    fclose(r->out);
+    unsigned long long n = r->events;
+    free(r);
+    tls_ring = NULL;
+    return n;
+}
+
+/*==================== 简易整型栈（同 ackermann.c） ====================*/
+typedef struct {
+    int *a;
+    int top, cap;
+} IntStack;
+
+static void st_init(IntStack *s, int cap) {
+    if (cap <= 0) cap = 4;
+    s->a = (int*)malloc(sizeof(int)*cap);
+    s->cap = cap;
+    s->top = -1;
+}
+static bool st_empty(const IntStack *s){ return s->top < 0; }
+static void st_push(IntStack *s, int x){
+    if (s->top + 1 >= s->cap){
+        s->cap *= 2;
+        s->a = (int*)realloc(s->a, sizeof(int)*s->cap);
+    }
+    s->a[++s->top] = x;
+}
+static int st_pop(IntStack *s){ return s->a[s->top--]; }
+static void st_free(IntStack *s){ free(s->a); s->a=NULL; s->cap=s->top=0; }
+
+/*==================== printf 版本（与 ackermann.c 相同，只是输出到 fp） ====================*/
+void akm_iter_trace_fp(FILE *fp, unsigned int m, unsigned int n) {
+    IntStack s; st_init(&s, 16);
+    unsigned step = 0;
+
+    fprintf(fp, "Trace for akm_iter(%u,%u):\n", m, n);
+    for(;;){
+        fprintf(fp, "step %2u: m=%u, n=%u, stack=[", step++, m, n);
+        for (int i = 0; i <= s.top; ++i){
+            fprintf(fp, "%d", s.a[i]);
+            if (i < s.top) fprintf(fp, ", ");
+        }
+        fprintf(fp, "]\n");
+
+        if (m == 0){
+            n = n + 1;
+            fprintf(fp, "m==0 -> n=n+1 => n=%u\n", n);
+            if (st_empty(&s)){
+                fprintf(fp, "stack empty -> result = %u\n", n);
+                break;
+            }
+            m = (unsigned)st_pop(&s);
+            fprintf(fp, "pop -> resume outer with m=%u\n", m);
+        } else if (n == 0){
+            m = m - 1;
+            n = 1;
+            fprintf(fp, "n==0 -> (m,n)=(%u,%u)\n", m, n);
+        } else {
+            st_push(&s, (int)(m - 1));
+            n = n - 1;
+            fprintf(fp, "push(m-1) & n-- -> push %u, now n=%u\n", m-1, n);
+        }
+    }
+    st_free(&s);
+}
+
+static void indent_fp(FILE *fp, int d){ while(d--) fputc(' ', fp); }
+static unsigned long long step_id = 0;
+
+unsigned long long akm_rec_trace_fp(FILE *fp, unsigned m, unsigned n, int depth){
+    indent_fp(fp, depth); fprintf(fp, "step %llu: call  akm(%u,%u)\n", ++step_id, m, n);
+
+    if(m == 0){
+        unsigned long long r = n + 1ULL;
+        indent_fp(fp, depth); fprintf(fp, "ret   akm(%u,%u) = %llu  (m==0)\n", m, n, r);
+        return r;
+    }
+    if(n == 0){
+        indent_fp(fp, depth); fprintf(fp, "-> reduce to akm(%u,%u)\n", m-1, 1);
+        unsigned long long r = akm_rec_trace_fp(fp, m-1, 1, depth+2);
+        indent_fp(fp, depth); fprintf(fp, "ret   akm(%u,%u) = %llu\n", m, n, r);
+        return r;
+    }
+
+    indent_fp(fp, depth); fprintf(fp, "-> compute inner t = akm(%u,%u)\n", m, n-1);
+    unsigned long long t = akm_rec_trace_fp(fp, m, n-1, depth+2);
+    indent_fp(fp, depth); fprintf(fp, "-> then compute akm(%u,%llu)\n", m-1, t);
+    unsigned long long r = akm_rec_trace_fp(fp, m-1, (unsigned)t, depth+2);
+
+    indent_fp(fp, depth); fprintf(fp, "ret   akm(%u,%u) = %llu\n", m, n, r);
+    return r;
+}
+
+/*==================== 二进制轨迹版本 ====================*/
+/* 栈内容不记录：解码器根据 PUSH/POP 事件自行重建 */
+unsigned long long akm_iter_traced(unsigned int m, unsigned int n) {
+    IntStack s; st_init(&s, 16);
+    tr_emit(EV_ITER_BEGIN, 0, m, n, 0);
+    for(;;){
+        tr_emit(EV_ITER_STATE, 0, m, n, 0);
+        if (m == 0){
+            n = n + 1;
+            tr_emit(EV_ITER_INC, 0, 0, n, 0);
+            if (st_empty(&s)){
+                tr_emit(EV_ITER_RESULT, 0, 0, n, 0);
+                break;
+            }
+            m = (unsigned)st_pop(&s);
+            tr_emit(EV_ITER_POP, 0, m, 0, 0);
+        } else if (n == 0){
+            m = m - 1;
+            n = 1;
+            tr_emit(EV_ITER_REDUCE, 0, m, n, 0);
+        } else {
+            st_push(&s, (int)(m - 1));
+            n = n - 1;
+            tr_emit(EV_ITER_PUSH, 0, m - 1, n, 0);
+        }
+    }
+    st_free(&s);
+    return n;
+}
+
+static unsigned long long akm_rec_traced_(unsigned m, unsigned n, int depth){
+    tr_emit(EV_REC_CALL, (uint32_t)depth, m, n, 0);
+    if(m == 0){
+        unsigned long long r = n + 1ULL;
+        tr_emit(EV_REC_RET0, (uint32_t)depth, m, n, r);
+        return r;
+    }
+    if(n == 0){
+        tr_emit(EV_REC_REDUCE, (uint32_t)depth, m - 1, 1, 0);
+        unsigned long long r = akm_rec_traced_(m-1, 1, depth+2);
+        tr_emit(EV_REC_RET, (uint32_t)depth, m, n, r);
+        return r;
+    }
+    tr_emit(EV_REC_INNER, (uint32_t)depth, m, n - 1, 0);
+    unsigned long long t = akm_rec_traced_(m, n-1, depth+2);
+    tr_emit(EV_REC_THEN, (uint32_t)depth, m - 1, t, 0);
+    unsigned long long r = akm_rec_traced_(m-1, (unsigned)t, depth+2);
+    tr_emit(EV_REC_RET, (uint32_t)depth, m, n, r);
+    return r;
+}
+
+unsigned long long akm_rec_traced(unsigned m, unsigned n) {
+    tr_emit(EV_REC_BEGIN, 0, m, n, 0);
+    unsigned long long r = akm_rec_traced_(m, n, 0);
+    tr_emit(EV_REC_END, 0, m, n, r);
+    return r;
+}
+
+/*==================== 离线解码 ====================*/
+/* 输出与 *_trace_fp 完全一致的文本（REC_BEGIN/END 只用于分隔，不产生输出） */
+bool tr_decode(const char *path, FILE *out) {
+    FILE *in = fopen(path, "rb");
+    if (!in) { perror(path); return false; }
+    char magic[8];
+    if (fread(magic, 1, 8, in) != 8 || memcmp(magic, TRACE_MAGIC, 8) != 0) {
+        fprintf(stderr, "%s: not an akm trace\n", path);
+        fclose(in);
+        return false;
+    }
+
+    IntStack s; st_init(&s, 16);
+    unsigned step = 0;
+    unsigned long long rec_step = 0;
+    TraceEvent buf[1024];
+    size_t got;
+    while ((got = fread(buf, sizeof(TraceEvent), 1024, in)) > 0) {
+        for (size_t i = 0; i < got; ++i) {
+            const TraceEvent *e = &buf[i];
+            unsigned m = e->m;
+            switch (e->kind) {
+            case EV_ITER_BEGIN:
+                fprintf(out, "Trace for akm_iter(%u,%u):\n", m, (unsigned)e->a);
+                s.top = -1; step = 0;
+                break;
+            case EV_ITER_STATE:
+                fprintf(out, "step %2u: m=%u, n=%u, stack=[", step++, m, (unsigned)e->a);
+                for (int k = 0; k <= s.top; ++k) {
+                    fprintf(out, "%d", s.a[k]);
+                    if (k < s.top) fprintf(out, ", ");
+                }
+                fprintf(out, "]\n");
+                break;
+            case EV_ITER_INC:
+                fprintf(out, "m==0 -> n=n+1 => n=%u\n", (unsigned)e->a);
+                break;
+            case EV_ITER_RESULT:
+                fprintf(out, "stack empty -> result = %u\n", (unsigned)e->a);
+                break;
+            case EV_ITER_POP:
+                (void)st_pop(&s);
+                fprintf(out, "pop -> resume outer with m=%u\n", m);
+                break;
+            case EV_ITER_REDUCE:
+                fprintf(out, "n==0 -> (m,n)=(%u,%u)\n", m, (unsigned)e->a);
+                break;
+            case EV_ITER_PUSH:
+                st_push(&s, (int)m);
+                fprintf(out, "push(m-1) & n-- -> push %u, now n=%u\n", m, (unsigned)e->a);
+                break;
+            case EV_REC_BEGIN:
+                rec_step = 0;
+                break;
+            case EV_REC_CALL:
+                indent_fp(out, (int)e->depth);
+                fprintf(out, "step %llu: call  akm(%u,%u)\n", ++rec_step, m, (unsigned)e->a);
+                break;
+            case EV_REC_RET0:
+                indent_fp(out, (int)e->depth);
+                fprintf(out, "ret   akm(%u,%u) = %llu  (m==0)\n", m, (unsigned)e->a, (unsigned long long)e->b);
+                break;
+            case EV_REC_RET:
+                indent_fp(out, (int)e->depth);
+                fprintf(out, "ret   akm(%u,%u) = %llu\n", m, (unsigned)e->a, (unsigned long long)e->b);
+                break;
+            case EV_REC_REDUCE:
+                indent_fp(out, (int)e->depth);
+                fprintf(out, "-> reduce to akm(%u,%u)\n", m, (unsigned)e->a);
+                break;
+            case EV_REC_INNER:
+                indent_fp(out, (int)e->depth);
+                fprintf(out, "-> compute inner t = akm(%u,%u)\n", m, (unsigned)e->a);
+                break;
+            case EV_REC_THEN:
+                indent_fp(out, (int)e->depth);
+                fprintf(out, "-> then compute akm(%u,%llu)\n", m, (unsigned long long)e->a);
+                break;
+            case EV_REC_END:
+                break;
+            default:
+                fprintf(stderr, "unknown event kind %u\n", e->kind);
+                st_free(&s); fclose(in);
+                return false;
+            }
+        }
+    }
+    st_free(&s);
+    fclose(in);
+    return true;
+}
+
+/*==================== 测试与计时 ====================*/
+static bool same_file(const char *a, const char *b) {
+    FILE *fa = fopen(a, "rb"), *fb = fopen(b, "rb");
+    bool same = fa && fb;
+    while (same) {
+        int ca = fgetc(fa), cb = fgetc(fb);
+        if (ca != cb) same = false;
+        if (ca == EOF || cb == EOF) break;
+    }
+    if (fa) fclose(fa);
+    if (fb) fclose(fb);
+    return same;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "decode") == 0)
+        return tr_decode(argv[2], stdout) ? 0 : 1;
+
+    unsigned m = 3, n = 4;      /* 文本轨迹随 n 指数增长，n=6 时已有数百 MB */
+    if (argc == 3) { m = (unsigned)atoi(argv[1]); n = (unsigned)atoi(argv[2]); }
+
+    /* printf 版本：输出写入文本文件 */
+    FILE *fp = fopen("akm_printf.txt", "w");
+    if (!fp) { perror("akm_printf.txt"); return 1; }
+    double t0 = now_sec();
+    akm_iter_trace_fp(fp, m, n);
+    step_id = 0;
+    akm_rec_trace_fp(fp, m, n, 0);
+    fclose(fp);
+    double t_printf = now_sec() - t0;
+
+    /* 二进制版本 */
+    if (!tr_open("akm_trace.bin")) { fprintf(stderr, "tr_open failed\n"); return 1; }
+    t0 = now_sec();
+    akm_iter_traced(m, n);
+    akm_rec_traced(m, n);
+    unsigned long long events = tr_close();
+    double t_bin = now_sec() - t0;
+
+    /* 离线解码并与 printf 版本逐字节比较 */
+    FILE *dec = fopen("akm_decoded.txt", "w");
+    if (!dec) { perror("akm_decoded.txt"); return 1; }
+    t0 = now_sec();
+    bool ok = tr_decode("akm_trace.bin", dec);
+    fclose(dec);
+    double t_dec = now_sec() - t0;
+
+    printf("akm(%u,%u): %llu events\n", m, n, events);
+    printf("  printf      : %7.1f ns/event\n", t_printf / events * 1e9);
+    printf("  binary ring : %7.1f ns/event\n", t_bin / events * 1e9);
+    printf("  decode      : %7.1f ns/event (offline)\n", t_dec / events * 1e9);
+    printf("  decoded output %s printf output\n",
+           ok && same_file("akm_printf.txt", "akm_decoded.txt") ? "matches" : "DIFFERS FROM");
+    return 0;
+}
@@ -0,0 +1,409 @@
+/*
+ * 括号匹配的增量判定（bracket_matching.c 中 BracketsMatched 的可编辑版本），header-only，C++17
+ *
+ * 缓冲区切成约 kChunk 字节的块，块是一棵隐式线段树的叶子。每个结点缓存自己这一段的摘要：
+ * 段内按"只看个数"配对后剩下的 c 个未匹配右括号和 o 个未匹配左括号（形如 ")]...([{"），
+ * 以及段内是否有配对的两端类型不同（bad）。合并左右两段时，左段的 o 个左括号（从栈顶起）
+ * 与右段的 c 个右括号（从左起）两两配对，配对个数 kk = min(L.o, R.c)。
+ *
+ * 判断这 kk 对的类型是否一致不能逐个比较，因此类型序列只以多项式哈希的形式保存：
+ * - S_close(v)：v 的未匹配右括号，从左到右；S_close(v) = S_close(L) ++ S_close(R)[kk..)
+ * - S_open(v)：v 的未匹配左括号，从栈顶（最右）起；S_open(v) = S_open(R) ++ S_open(L)[kk..)
+ * 两者都是 "A ++ B[kk..)" 的形式：长度 k 的前缀哈希只需沿一条路径往下走（结点里缓存了
+ * B 的长度 kk 的前缀哈希），O(log n)。叶子保存前缀哈希数组。
+ * 哈希模 2^61-1，基数随机；两个不同的类型序列被误判为相同的概率约为 长度 / 2^61。
+ *
+ * 代价（n 为块数，一次编辑只改一个块时）：
+ * - replace / insert / erase：重扫该块 O(kChunk)，再更新 O(log n) 个祖先，每个 O(log n)
+ * - valid()：O(1)，只看根
+ * - firstError()：第一处出错的位置，与 BracketsMatched 逐字符扫描时失败的位置相同，O(log^3 n)
+ * - partner(pos)：按个数配对时与 pos 处括号配对的位置，O(kChunk + log n)
+ *
+ * 某个块插入后超过 2 kChunk 时，找包含它的、平均长度不超过 1.5 kChunk 的最小对齐块组，
+ * 在组内均分（packed memory array 的做法）；整棵树都放不下时叶子数翻倍后重建。
+ * 与 bracket_matching.c 一样只识别 () [] {}，其他字符忽略；位置都从 0 开始。
+ */
+#ifndef BRACKET_INDEX_HPP
+#define BRACKET_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+class BracketIndex {
+public:
+    enum class Status { Ok, UnmatchedCloser, Mismatched, UnclosedOpener };
+
+    struct Error {
+        Status status;
+        long long pos;      // 出错的括号位置；Ok 时为 -1
+        long long partner;  // Mismatched 时与之配对（类型不同）的左括号位置，其余为 -1
+    };
+
+    static constexpr std::size_t kChunk = 1024;
+
+    BracketIndex(const char* s, std::size_t n, std::uint64_t seed = 0) {
+        if (!seed) seed = std::random_device{}() * 0x9E3779B97F4A7C15ULL + 1;
+        std::mt19937_64 rng(seed);
+        base_ = rng() % (kMod - 1000) + 500;
+        powLo_.resize(1 << 16);
+        powHi_.resize(1 << 16);
+        powLo_[0] = powHi_[0] = 1;
+        for (int i = 1; i < (1 << 16); ++i) powLo_[i] = mul(powLo_[i - 1], base_);
+        const u64 b16 = mul(powLo_[(1 << 16) - 1], base_);
+        for (int i = 1; i < (1 << 16); ++i) powHi_[i] = mul(powHi_[i - 1], b16);
+        build(s, n, 1);
+    }
+
+    std::size_t size() const { return (std::size_t)t_[1].len; }
+
+    char at(std::size_t pos) const {
+        int li = findLeaf(pos);
+        return leaf_[li].text[pos];
+    }
+
+    std::string str() const {
+        std::string s;
+        s.reserve(size());
+        for (const Leaf& f : leaf_) s += f.text;
+        return s;
+    }
+
+    // pos 处的字节改为 c
+    void replace(std::size_t pos, char c) {
+        int li = findLeaf(pos);
+        leaf_[li].text[pos] = c;
+        updateLeaf(li);
+    }
+
+    // 在 pos 之前插入 s[0..n)，pos 可以等于 size()
+    void insert(std::size_t pos, const char* s, std::size_t n) {
+        if (!n) return;
+        int li = findLeaf(pos);
+        leaf_[li].text.insert(pos, s, n);
+        if (leaf_[li].text.size() > 2 * kChunk) rebalance(li);
+        else updateLeaf(li);
+    }
+
+    // 删除 [pos, pos + n)，超出末尾的部分忽略
+    void erase(std::size_t pos, std::size_t n) {
+        n = std::min(n, size() - std::min(pos, size()));
+        while (n) {
+            std::size_t local = pos;
+            int li = findLeaf(local);
+            std::size_t take = std::min(n, leaf_[li].text.size() - local);
+            leaf_[li].text.erase(local, take);
+            updateLeaf(li);
+            n -= take;
+        }
+    }
+
+    bool valid() const { return !t_[1].bad && t_[1].c == 0 && t_[1].o == 0; }
+
+    Error firstError() const {
+        long long under = t_[1].c ? closerPos(1, 0) : -1;
+        long long mis = t_[1].bad ? firstMismatch(1, 0) : -1;
+        if (mis >= 0 && (under < 0 || mis < under)) return {Status::Mismatched, mis, partner((std::size_t)mis)};
+        if (under >= 0) return {Status::UnmatchedCloser, under, -1};
+        if (t_[1].o) return {Status::UnclosedOpener, openerPos(1, t_[1].o - 1), -1};
+        return {Status::Ok, -1, -1};
+    }
+
+    // 按嵌套层数（不看类型）与 pos 处括号配对的位置；pos 不是括号或没有配对时返回 -1
+    long long partner(std::size_t pos) const {
+        const std::size_t global = pos;
+        int li = findLeaf(pos);
+        const Leaf& f = leaf_[li];
+        const int k = kind(f.text[pos]);
+        if (!k) return -1;
+        const long long start = (long long)(global - pos);
+        const int m = (int)f.text.size(), at = (int)pos;
+
+        // 先在块内找：左括号向右、右括号向左数层数
+        int d = 0;
+        if (k > 0) {
+            for (int i = at; i < m; ++i) {
+                const int t = kind(f.text[i]);
+                d += t > 0 ? 1 : t < 0 ? -1 : 0;
+                if (d == 0) return start + i;
+            }
+        } else {
+            for (int i = at; i >= 0; --i) {
+                const int t = kind(f.text[i]);
+                d += t < 0 ? 1 : t > 0 ? -1 : 0;
+                if (d == 0) return start + i;
+            }
+        }
+
+        // 块内未匹配：取它在 S_open / S_close 中的下标，往上找到与之配对的那一层
+        int v = slots_ + li;
+        if (k > 0) {
+            int j = (int)(std::lower_bound(f.opos.begin(), f.opos.end(), at, std::greater<int>()) - f.opos.begin());
+            for (; v > 1; v /= 2) {
+                const Sum& s = t_[v / 2];
+                if (v & 1) continue;
+                if (j < s.kk) return nodeStart(v + 1) + closerPos(v + 1, j);
+                j = t_[v + 1].o + (j - s.kk);
+            }
+        } else {
+            int j = (int)(std::lower_bound(f.cpos.begin(), f.cpos.end(), at) - f.cpos.begin());
+            for (; v > 1; v /= 2) {
+                const Sum& s = t_[v / 2];
+                if (!(v & 1)) continue;
+                if (j < s.kk) return nodeStart(v - 1) + openerPos(v - 1, j);
+                j = t_[v - 1].c + (j - s.kk);
+            }
+        }
+        return -1;
+    }
+
+private:
+    typedef std::uint64_t u64;
+    static constexpr u64 kMod = (1ULL << 61) - 1;
+
+    struct Leaf {
+        std::string text;
+        std::vector<int> cpos, opos;   // 未匹配右括号（从左起）/ 左括号（从栈顶起）在块内的位置
+        std::vector<u64> hcPre, hoPre; // 对应类型序列的前缀哈希，长度 c+1 / o+1
+        int firstBad = -1;             // 块内第一个与配对左括号类型不同的右括号
+    };
+
+    struct Sum {
+        long long len = 0;
+        int c = 0, o = 0, kk = 0;
+        bool bad = false;
+        u64 hc = 0, ho = 0;          // S_close / S_open 的哈希
+        u64 hcDrop = 0, hoDrop = 0;  // 右子 S_close、左子 S_open 长度 kk 的前缀哈希
+    };
+
+    int slots_ = 1;
+    std::vector<Leaf> leaf_;
+    std::vector<Sum> t_;
+    u64 base_ = 0;
+    std::vector<u64> powLo_, powHi_;
+    std::vector<int> stack_;
+
+    // 左括号 1..3，右括号 -1..-3，其余 0；查表，重扫块时大部分字节一次比较就跳过
+    struct KindTable {
+        signed char k[256];
+        constexpr KindTable() : k() {
+            k['('] = 1; k['['] = 2; k['{'] = 3;
+            k[')'] = -1; k[']'] = -2; k['}'] = -3;
+        }
+    };
+    static int kind(char c) {
+        static constexpr KindTable table;
+        return table.k[(unsigned char)c];
+    }
+
+    static u64 mul(u64 a, u64 b) {
+        unsigned __int128 p = (unsigned __int128)a * b;
+        u64 r = (u64)(p & kMod) + (u64)(p >> 61);
+        if (r >= kMod) r -= kMod;
+        return r;
+    }
+    static u64 add(u64 a, u64 b) { a += b; return a >= kMod ? a - kMod : a; }
+    static u64 sub(u64 a, u64 b) { return a >= b ? a - b : a + kMod - b; }
+    u64 pw(int e) const { return mul(powLo_[e & 0xffff], powHi_[e >> 16]); }
+
+    void build(const char* s, std::size_t n, int minSlots) {
+        slots_ = minSlots;
+        while ((std::size_t)slots_ * kChunk < n) slots_ *= 2;
+        leaf_.assign(slots_, Leaf());
+        t_.assign(2 * (std::size_t)slots_, Sum());
+        std::size_t off = 0;
+        for (int i = 0; i < slots_; ++i) {
+            std::size_t len = n / slots_ + ((std::size_t)i < n % slots_ ? 1 : 0);
+            leaf_[i].text.assign(s + off, len);
+            off += len;
+            scanLeaf(i);
+        }
+        for (int v = slots_ - 1; v >= 1; --v) pull(v);
+    }
+
+    void scanLeaf(int li) {
+        Leaf& f = leaf_[li];
+        f.cpos.clear();
+        f.opos.clear();
+        f.firstBad = -1;
+        stack_.clear();
+        const int m = (int)f.text.size();
+        for (int i = 0; i < m; ++i) {
+            const int k = kind(f.text[i]);
+            if (k > 0) {
+                stack_.push_back(i);
+            } else if (k < 0) {
+                if (stack_.empty()) {
+                    f.cpos.push_back(i);
+                } else {
+                    if (kind(f.text[stack_.back()]) != -k && f.firstBad < 0) f.firstBad = i;
+                    stack_.pop_back();
+                }
+            }
+        }
+        f.opos.assign(stack_.rbegin(), stack_.rend());
+        f.hcPre.resize(f.cpos.size() + 1);
+        f.hoPre.resize(f.opos.size() + 1);
+        f.hcPre[0] = f.hoPre[0] = 0;
+        for (std::size_t k = 0; k < f.cpos.size(); ++k) f.hcPre[k + 1] = add(mul(f.hcPre[k], base_), (u64)-kind(f.text[f.cpos[k]]));
+        for (std::size_t k = 0; k < f.opos.size(); ++k) f.hoPre[k + 1] = add(mul(f.hoPre[k], base_), (u64)kind(f.text[f.opos[k]]));
+
+        Sum& s = t_[slots_ + li];
+        s.len = m;
+        s.c = (int)f.cpos.size();
+        s.o = (int)f.opos.size();
+        s.kk = 0;
+        s.bad = f.firstBad >= 0;
+        s.hc = f.hcPre.back();
+        s.ho = f.hoPre.back();
+    }
+
+    // S_close(v) 长度 k 的前缀哈希
+    u64 prefixClose(int v, int k) const {
+        if (v >= slots_) return leaf_[v - slots_].hcPre[k];
+        const Sum &s = t_[v], &L = t_[2 * v];
+        if (k <= L.c) return prefixClose(2 * v, k);
+        const int t = k - L.c;
+        const u64 p = pw(t);
+        return add(mul(L.hc, p), sub(prefixClose(2 * v + 1, s.kk + t), mul(s.hcDrop, p)));
+    }
+
+    // S_open(v) 长度 k 的前缀哈希
+    u64 prefixOpen(int v, int k) const {
+        if (v >= slots_) return leaf_[v - slots_].hoPre[k];
+        const Sum &s = t_[v], &R = t_[2 * v + 1];
+        if (k <= R.o) return prefixOpen(2 * v + 1, k);
+        const int t = k - R.o;
+        const u64 p = pw(t);
+        return add(mul(R.ho, p), sub(prefixOpen(2 * v, s.kk + t), mul(s.hoDrop, p)));
+    }
+
+    void pull(int v) {
+        const Sum &L = t_[2 * v], &R = t_[2 * v + 1];
+        Sum& s = t_[v];
+        s.len = L.len + R.len;
+        s.kk = std::min(L.o, R.c);
+        s.hoDrop = prefixOpen(2 * v, s.kk);
+        s.hcDrop = prefixClose(2 * v + 1, s.kk);
+        s.bad = L.bad || R.bad || s.hoDrop != s.hcDrop;
+        s.c = L.c + R.c - s.kk;
+        s.o = R.o + L.o - s.kk;
+        const u64 pc = pw(R.c - s.kk), po = pw(L.o - s.kk);
+        s.hc = add(mul(L.hc, pc), sub(R.hc, mul(s.hcDrop, pc)));
+        s.ho = add(mul(R.ho, po), sub(L.ho, mul(s.hoDrop, po)));
+    }
+
+    void updateLeaf(int li) {
+        scanLeaf(li);
+        for (int v = (slots_ + li) / 2; v >= 1; v /= 2) pull(v);
+    }
+
+    // pos 所在的叶子；pos 改为块内位置。pos == size() 时落在最后一个叶子的末尾
+    int findLeaf(std::size_t& pos) const {
+        int v = 1;
+        while (v < slots_) {
+            if ((long long)pos < t_[2 * v].len) {
+                v = 2 * v;
+            } else {
+                pos -= (std::size_t)t_[2 * v].len;
+                v = 2 * v + 1;
+            }
+        }
+        return v - slots_;
+    }
+
+    long long nodeStart(int v) const {
+        long long off = 0;
+        for (; v > 1; v /= 2)
+            if (v & 1) off += t_[v - 1].len;
+        return off;
+    }
+
+    // S_close(v)[j] / S_open(v)[j] 在 v 这一段内的位置
+    long long closerPos(int v, int j) const {
+        long long off = 0;
+        while (v < slots_) {
+            const Sum &s = t_[v], &L = t_[2 * v];
+            if (j < L.c) {
+                v = 2 * v;
+            } else {
+                j = j - L.c + s.kk;
+                off += L.len;
+                v = 2 * v + 1;
+            }
+        }
+        return off + leaf_[v - slots_].cpos[j];
+    }
+
+    long long openerPos(int v, int j) const {
+        long long off = 0;
+        while (v < slots_) {
+            const Sum &s = t_[v], &R = t_[2 * v + 1];
+            if (j < R.o) {
+                off += t_[2 * v].len;
+                v = 2 * v + 1;
+            } else {
+                j = j - R.o + s.kk;
+                v = 2 * v;
+            }
+        }
+        return off + leaf_[v - slots_].opos[j];
+    }
+
+    // v 这一段里第一个与配对左括号类型不同的右括号（配对只在段内进行），off 为段起点
+    long long firstMismatch(int v, long long off) const {
+        if (!t_[v].bad) return -1;
+        if (v >= slots_) return off + leaf_[v - slots_].firstBad;
+        const int l = 2 * v, r = 2 * v + 1;
+        if (t_[l].bad) return firstMismatch(l, off);   // 左段的右括号都在右段之前
+        const Sum& s = t_[v];
+        long long best = -1;
+        if (s.hoDrop != s.hcDrop) {
+            // 二分找跨越两段的第一对类型不同的配对：前 lo 对相同，前 hi 对不同
+            int lo = 0, hi = s.kk;
+            while (hi - lo > 1) {
+                const int mid = (lo + hi) / 2;
+                if (prefixOpen(l, mid) == prefixClose(r, mid)) lo = mid;
+                else hi = mid;
+            }
+            best = off + t_[l].len + closerPos(r, lo);
+        }
+        const long long inR = firstMismatch(r, off + t_[l].len);
+        if (inR >= 0 && (best < 0 || inR < best)) best = inR;
+        return best;
+    }
+
+    void rebalance(int li) {
+        const long long cur = (long long)leaf_[li].text.size();
+        for (int w = 2;; w *= 2) {
+            if (w > slots_) {
+                const std::string all = str();
+                build(all.data(), all.size(), slots_ * 2);
+                return;
+            }
+            const int b = li & ~(w - 1);
+            const long long total = t_[(slots_ + b) / w].len - t_[slots_ + li].len + cur;
+            if (total > (long long)(w * kChunk * 3 / 2)) continue;
+
+            std::string all;
+            all.reserve((std::size_t)total);
+            for (int i = b; i < b + w; ++i) all += leaf_[i].text;
+            std::size_t off = 0;
+            for (int i = 0; i < w; ++i) {
+                const std::size_t len = all.size() / w + ((std::size_t)i < all.size() % w ? 1 : 0);
+                leaf_[b + i].text.assign(all, off, len);
+                off += len;
+                scanLeaf(b + i);
+            }
+            for (int lo = (slots_ + b) / 2, hi = (slots_ + b + w - 1) / 2; lo >= 1; lo /= 2, hi /= 2)
+                for (int v = lo; v <= hi; ++v) pull(v);
+            return;
+        }
+    }
+};
+
+#endif  // BRACKET_INDEX_HPP
@@ -0,0 +1,261 @@
+/*
+ * BracketIndex（bracket_index.hpp）的正确性检查与测速
+ * - 正确性：小缓冲区上随机编辑（改字节、插入、删除、插入成对括号、同一处连续插入触发重新分块），
+ *   每次编辑后把 valid / firstError 与逐字符扫描的结果比对，定期抽查 partner
+ * - 测速：大缓冲区（默认 100 MB，合法的括号结构）上 10^5 次编辑，每次编辑后查询 valid，
+ *   不合法时再查 firstError；对照组是每次编辑后用 BracketsMatched 整体重扫。两种负载：
+ *   打字（只增删改字母，缓冲区一直合法，重扫每次都要扫完）与随机（也会改到括号，
+ *   很快变得不合法，重扫在第一处错误就停下）
+ * - 整体重扫太慢，只对前若干次编辑（约 5 秒）计时并按平均值折算；这些编辑上两边的
+ *   valid 结果逐次比对
+ *
+ * 编译: g++ -std=c++17 -O2 bracket_index_bench.cpp -o bracket_index_bench
+ * 用法: bracket_index_bench [缓冲区 MB，默认 100] [编辑次数，默认 100000]
+ */
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../include/bench_util.h"
+#include "bracket_index.hpp"
+
+/* ========== 对照组：bracket_matching.c 的 BracketsMatched（顺序栈） ========== */
+static bool isLeft(char c) { return c == '(' || c == '[' || c == '{'; }
+static bool isRight(char c) { return c == ')' || c == ']' || c == '}'; }
+static bool match(char L, char R) { return (L == '(' && R == ')') || (L == '[' && R == ']') || (L == '{' && R == '}'); }
+
+static bool BracketsMatched(const char* s, long long n) {
+    std::vector<char> st;
+    for (long long i = 0; i < n; ++i) {
+        char c = s[i];
+        if (isLeft(c)) {
+            st.push_back(c);
+        } else if (isRight(c)) {
+            if (st.empty() || !match(st.back(), c)) return false;
+            st.pop_back();
+        }
+    }
+    return st.empty();
+}
+
+/* 与 BracketsMatched 相同的扫描，但给出失败的位置 */
+static BracketIndex::Error scanError(const std::string& s) {
+    std::vector<long long> st;
+    for (long long i = 0; i < (long long)s.size(); ++i) {
+        char c = s[i];
+        if (isLeft(c)) {
+            st.push_back(i);
+        } else if (isRight(c)) {
+            if (st.empty()) return {BracketIndex::Status::UnmatchedCloser, i, -1};
+            if (!match(s[st.back()], c)) return {BracketIndex::Status::Mismatched, i, st.back()};
+            st.pop_back();
+        }
+    }
+    if (!st.empty()) return {BracketIndex::Status::UnclosedOpener, st.front(), -1};
+    return {BracketIndex::Status::Ok, -1, -1};
+}
+
+/* 按层数（不看类型）配对 */
+static std::vector<long long> partners(const std::string& s) {
+    std::vector<long long> p(s.size(), -1), st;
+    for (long long i = 0; i < (long long)s.size(); ++i) {
+        if (isLeft(s[i])) {
+            st.push_back(i);
+        } else if (isRight(s[i]) && !st.empty()) {
+            p[i] = st.back();
+            p[st.back()] = i;
+            st.pop_back();
+        }
+    }
+    return p;
+}
+
+/* 随机文本，约 1/8 的字节是括号，结构合法 */
+static std::string genValid(std::size_t n, std::mt19937_64& rng) {
+    static const char open[] = "([{", close[] = ")]}";
+    std::string s;
+    s.reserve(n);
+    std::vector<int> st;
+    while (s.size() + st.size() < n) {
+        unsigned r = (unsigned)(rng() % 16);
+        if (r == 0) {
+            int t = (int)(rng() % 3);
+            st.push_back(t);
+            s += open[t];
+        } else if (r == 1 && !st.empty()) {
+            s += close[st.back()];
+            st.pop_back();
+        } else {
+            s += (char)('a' + rng() % 26);
+        }
+    }
+    while (!st.empty()) {
+        s += close[st.back()];
+        st.pop_back();
+    }
+    return s;
+}
+
+static char randomByte(std::mt19937_64& rng) {
+    static const char pool[] = "()[]{}abcdefghijklmnopqrstuvwxyz";
+    return rng() % 4 == 0 ? pool[rng() % 6] : pool[6 + rng() % 26];
+}
+
+static bool sameError(const BracketIndex::Error& a, const BracketIndex::Error& b) {
+    return a.status == b.status && a.pos == b.pos && a.partner == b.partner;
+}
+
+static int correctness() {
+    std::mt19937_64 rng(7);
+    int fails = 0;
+    for (int round = 0; round < 4; ++round) {
+        std::string ref = genValid(round == 0 ? 100 : 200000, rng);
+        BracketIndex idx(ref.data(), ref.size(), 12345 + round);
+        for (int e = 0; e < 4000 && fails < 10; ++e) {
+            unsigned op = (unsigned)(rng() % 10);
+            std::size_t pos = ref.empty() ? 0 : rng() % ref.size();
+            if (op < 3 && !ref.empty()) {
+                char c = randomByte(rng);
+                ref[pos] = c;
+                idx.replace(pos, c);
+            } else if (op < 5) {
+                char c = randomByte(rng);
+                ref.insert(pos, 1, c);
+                idx.insert(pos, &c, 1);
+            } else if (op < 7) {
+                std::size_t n = 1 + rng() % (rng() % 8 == 0 ? 10000 : 3);
+                ref.erase(pos, n);
+                idx.erase(pos, n);
+            } else if (op < 9) {
+                const char* pairs[] = {"()", "[]", "{}", "(x[y]{z})"};
+                const char* p = pairs[rng() % 4];
+                ref.insert(pos, p);
+                idx.insert(pos, p, std::strlen(p));
+            } else {
+                /* 同一位置连续插入，让这个块超过 2 kChunk 触发重新分块 */
+                std::string burst(3000, 'q');
+                burst[1000] = '(';
+                burst[2000] = ')';
+                ref.insert(pos, burst);
+                idx.insert(pos, burst.data(), burst.size());
+            }
+
+            BracketIndex::Error want = scanError(ref), got = idx.firstError();
+            bool ok = idx.size() == ref.size() && idx.valid() == BracketsMatched(ref.data(), (long long)ref.size()) &&
+                      sameError(want, got);
+            if (ok && e % 200 == 0) {
+                ok = idx.str() == ref;
+                std::vector<long long> p = partners(ref);
+                for (int q = 0; q < 300 && ok && !ref.empty(); ++q) {
+                    std::size_t i = rng() % ref.size();
+                    ok = idx.partner(i) == p[i];
+                }
+            }
+            if (!ok) {
+                std::printf("FAIL round %d edit %d: want (%d, %lld, %lld) got (%d, %lld, %lld)\n", round, e,
+                            (int)want.status, want.pos, want.partner, (int)got.status, got.pos, got.partner);
+                ++fails;
+            }
+        }
+    }
+    std::printf("correctness: %s\n", fails ? "FAILED" : "ok");
+    return fails;
+}
+
+/* 一次编辑：op 0 改字节，1 插入，2 删除；位置取 raw 对当前长度的余数 */
+struct Edit {
+    int op;
+    unsigned long long raw;
+    char c;
+};
+
+/* 打字负载只动字母：要改/删的位置上是括号时改为在该处插入字母 */
+template <typename At>
+static int effectiveOp(const Edit& e, bool typing, std::size_t pos, At at) {
+    if (!typing || e.op == 1) return e.op;
+    return std::isalpha((unsigned char)at(pos)) ? e.op : 1;
+}
+
+static void runWorkload(const char* name, const std::string& init, const std::vector<Edit>& ops, bool typing) {
+    const long long edits = (long long)ops.size();
+
+    /* 对照组：在 std::string 上编辑（不计时），每次后整体重扫（计时） */
+    std::string buf = init;
+    std::vector<char> want;
+    double tScan = 0;
+    for (const Edit& e : ops) {
+        if (tScan >= 5.0) break;
+        std::size_t pos = (std::size_t)(e.raw % (buf.size() + (e.op == 1)));
+        char c = typing ? (char)('a' + e.raw % 26) : e.c;
+        switch (effectiveOp(e, typing, pos, [&](std::size_t i) { return buf[i]; })) {
+        case 0: buf[pos] = c; break;
+        case 1: buf.insert(pos, 1, c); break;
+        default: buf.erase(pos, 1); break;
+        }
+        double t = now_sec();
+        want.push_back(BracketsMatched(buf.data(), (long long)buf.size()));
+        tScan += now_sec() - t;
+    }
+
+    BracketIndex idx(init.data(), init.size());
+    long long invalid = 0, mismatches = 0, i = 0;
+    double t0 = now_sec();
+    for (const Edit& e : ops) {
+        std::size_t pos = (std::size_t)(e.raw % (idx.size() + (e.op == 1)));
+        char c = typing ? (char)('a' + e.raw % 26) : e.c;
+        switch (effectiveOp(e, typing, pos, [&](std::size_t k) { return idx.at(k); })) {
+        case 0: idx.replace(pos, c); break;
+        case 1: idx.insert(pos, &c, 1); break;
+        default: idx.erase(pos, 1); break;
+        }
+        bool ok = idx.valid();
+        if (!ok) {
+            ++invalid;
+            if (idx.firstError().pos < 0) ++mismatches;
+        }
+        if (i < (long long)want.size() && ok != (bool)want[i]) ++mismatches;
+        ++i;
+    }
+    double tIdx = now_sec() - t0;
+
+    double perIdx = tIdx / edits, perScan = tScan / want.size();
+    std::printf("%s：\n", name);
+    std::printf("  增量（编辑+查询）   %10.2f us/次   共 %.1f ms，%lld 次编辑后不合法\n", perIdx * 1e6, tIdx * 1e3, invalid);
+    std::printf("  整体重扫            %10.2f us/次   计时 %zu 次，折算 %lld 次共 %.1f s\n", perScan * 1e6, want.size(), edits,
+                perScan * edits);
+    std::printf("  加速比              %10.0fx   %s\n", perScan / perIdx, mismatches ? "与重扫结果不一致！" : "与重扫结果一致");
+}
+
+int main(int argc, char** argv) {
+    /* 原来的测试用例 */
+    const char* tests[] = {"([{}])", "([]{})", "([}{])", "([)]", "([]", "abc{[()]}123", "", "{[()]}[]{}", "{[(])}",
+                           "(((([[]]))){})"};
+    for (const char* t : tests) {
+        BracketIndex idx(t, std::strlen(t));
+        std::printf("%-16s -> %s\n", t, idx.valid() ? "匹配正确" : "不匹配");
+    }
+    if (correctness()) return 1;
+
+    std::size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100;
+    long long edits = argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 100000;
+    std::mt19937_64 rng(2024);
+    std::string buf = genValid(mb << 20, rng);
+    std::printf("\n缓冲区 %.1f MB，每种负载 %lld 次编辑（改字节 / 插入 / 删除各 1 字节）\n", buf.size() / 1048576.0, edits);
+
+    double t0 = now_sec();
+    { BracketIndex idx(buf.data(), buf.size()); }
+    std::printf("建树 %.1f ms\n", (now_sec() - t0) * 1e3);
+
+    std::vector<Edit> ops((std::size_t)edits);
+    for (Edit& e : ops) {
+        e.op = (int)(rng() % 3);
+        e.raw = rng();
+        e.c = randomByte(rng);
+    }
+    runWorkload("打字（只动字母）", buf, ops, true);
+    runWorkload("随机（含括号）", buf, ops, false);
+    return 0;
+}
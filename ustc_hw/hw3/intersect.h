@@ -0,0 +1,224 @@
+/*
+ * 有序整数序列求交（intersection.c 中 Intersection 的扩展版），header-only
+ *
+ * - IntArray：可增长、按 64 字节对齐的 int 数组，容量按 2 倍增长
+ * - intersect_scalar：两指针归并（与 Intersection 相同，但直接写输出，不逐个 ListInsert）
+ * - intersect_gallop：两表长度悬殊时，对短表的每个元素在长表中做指数搜索 + 二分，
+ *                     复杂度 O(m log(n/m))
+ * - intersect_simd：长度相近时，每次比较 A、B 各一块（SSE2 4 路 / AVX2 8 路），
+ *                   通过轮换 B 的 lane 做全对全比较，命中的 lane 直接写出
+ * - intersect_auto：按长度比例在以上几种之间自动选择
+ *
+ * 约定：输入严格递增（无重复），输出同样严格递增。
+ */
+#ifndef INTERSECT_H
+#define INTERSECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define INTERSECT_HAVE_SSE2 1
+#endif
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+/*==================== 对齐的可增长数组 ====================*/
+#define IA_ALIGN 64
+
+typedef struct {
+    int *data;
+    size_t size, cap;
+} IntArray;
+
+static inline void *ia_aligned_alloc(size_t bytes) {
+    if (bytes == 0) bytes = IA_ALIGN;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, IA_ALIGN);
+#else
+    void *p = NULL;
+    return posix_memalign(&p, IA_ALIGN, bytes) == 0 ? p : NULL;
+#endif
+}
+
+static inline void ia_aligned_free(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+static inline void ia_init(IntArray *a) { a->data = NULL; a->size = a->cap = 0; }
+
+static inline void ia_free(IntArray *a) {
+    ia_aligned_free(a->data);
+    ia_init(a);
+}
+
+/* 保证容量至少为 n；失败返回 false，原内容不变 */
+static inline bool ia_reserve(IntArray *a, size_t n) {
+    if (n <= a->cap) return true;
+    size_t cap = a->cap ? a->cap : 16;
+    while (cap < n) cap *= 2;
+    int *p = (int *)ia_aligned_alloc(cap * sizeof(int));
+    if (!p) return false;
+    if (a->size) memcpy(p, a->data, a->size * sizeof(int));
+    ia_aligned_free(a->data);
+    a->data = p;
+    a->cap = cap;
+    return true;
+}
+
+static inline bool ia_push(IntArray *a, int x) {
+    if (a->size == a->cap && !ia_reserve(a, a->size + 1)) return false;
+    a->data[a->size++] = x;
+    return true;
+}
+
+static inline bool ia_assign(IntArray *a, const int *src, size_t n) {
+    if (!ia_reserve(a, n)) return false;
+    if (n) memcpy(a->data, src, n * sizeof(int));
+    a->size = n;
+    return true;
+}
+
+/*==================== 求交内核 ====================*/
+/* 各内核都要求 out 至少能容纳 min(na, nb) 个元素，返回写入的个数 */
+
+static inline size_t intersect_scalar(const int *a, size_t na, const int *b, size_t nb, int *out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) i++;
+        else if (a[i] > b[j]) j++;
+        else { out[k++] = a[i]; i++; j++; }
+    }
+    return k;
+}
+
+/* 在 b[lo..nb) 中找第一个 >= x 的下标：先按 1,2,4,... 跳，再在最后一段内二分 */
+static inline size_t gallop_lower_bound(const int *b, size_t lo, size_t nb, int x) {
+    if (lo >= nb || b[lo] >= x) return lo;
+    size_t step = 1, prev = lo, hi = lo + 1;
+    while (hi < nb && b[hi] < x) {
+        prev = hi;
+        step <<= 1;
+        hi = lo + step;
+    }
+    if (hi > nb) hi = nb;
+    size_t l = prev + 1, r = hi;     /* b[prev] < x，答案在 (prev, hi] */
+    while (l < r) {
+        size_t mid = l + (r - l) / 2;
+        if (b[mid] < x) l = mid + 1;
+        else r = mid;
+    }
+    return l;
+}
+
+/* 要求 na <= nb（短表在前） */
+static inline size_t intersect_gallop(const int *a, size_t na, const int *b, size_t nb, int *out) {
+    size_t j = 0, k = 0;
+    for (size_t i = 0; i < na && j < nb; ++i) {
+        j = gallop_lower_bound(b, j, nb, a[i]);
+        if (j < nb && b[j] == a[i]) out[k++] = b[j++];
+    }
+    return k;
+}
+
+#ifdef INTERSECT_HAVE_SSE2
+/* 写出 mask 中置位的 lane：不做插入，只是顺序存储 */
+#define INTERSECT_EMIT(mask, va_ptr, out, k)           \
+    do {                                               \
+        unsigned m_ = (unsigned)(mask);                \
+        while (m_) {                                   \
+            int lane_ = __builtin_ctz(m_);             \
+            (out)[(k)++] = (va_ptr)[lane_];            \
+            m_ &= m_ - 1;                              \
+        }                                              \
+    } while (0)
+
+static inline size_t intersect_sse2(const int *a, size_t na, const int *b, size_t nb, int *out) {
+    size_t i = 0, j = 0, k = 0;
+    size_t na4 = na & ~(size_t)3, nb4 = nb & ~(size_t)3;
+    while (i < na4 && j < nb4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+        /* A 的 4 个 lane 与 B 的 4 种轮换逐一比较，覆盖全部 16 对 */
+        __m128i c0 = _mm_cmpeq_epi32(va, vb);
+        __m128i c1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+        __m128i c2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m128i c3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+        __m128i any = _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(any));
+        INTERSECT_EMIT(mask, a + i, out, k);
+        int amax = a[i + 3], bmax = b[j + 3];
+        if (amax <= bmax) i += 4;
+        if (bmax <= amax) j += 4;
+    }
+    return k + intersect_scalar(a + i, na - i, b + j, nb - j, out + k);
+}
+
+#ifdef __AVX2__
+static inline size_t intersect_avx2(const int *a, size_t na, const int *b, size_t nb, int *out) {
+    size_t i = 0, j = 0, k = 0;
+    size_t na8 = na & ~(size_t)7, nb8 = nb & ~(size_t)7;
+    const __m256i rot = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while (i < na8 && j < nb8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+        __m256i any = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rot);
+            any = _mm256_or_si256(any, _mm256_cmpeq_epi32(va, vb));
+        }
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(any));
+        INTERSECT_EMIT(mask, a + i, out, k);
+        int amax = a[i + 7], bmax = b[j + 7];
+        if (amax <= bmax) i += 8;
+        if (bmax <= amax) j += 8;
+    }
+    return k + intersect_sse2(a + i, na - i, b + j, nb - j, out + k);
+}
+#endif
+#endif /* INTERSECT_HAVE_SSE2 */
+
+/* 当前平台可用的最宽 SIMD 内核；没有 SIMD 时退化为两指针 */
+static inline size_t intersect_simd(const int *a, size_t na, const int *b, size_t nb, int *out) {
+#if defined(__AVX2__)
+    return intersect_avx2(a, na, b, nb, out);
+#elif defined(INTERSECT_HAVE_SSE2)
+    return intersect_sse2(a, na, b, nb, out);
+#else
+    return intersect_scalar(a, na, b, nb, out);
+#endif
+}
+
+/* 长表/短表超过该比例时改用 galloping（在 1e3~1e7 的随机数据上测得） */
+#ifndef INTERSECT_GALLOP_RATIO
+#define INTERSECT_GALLOP_RATIO 32
+#endif
+
+static inline size_t intersect_auto(const int *a, size_t na, const int *b, size_t nb, int *out) {
+    if (na > nb) {
+        const int *t = a; a = b; b = t;
+        size_t tn = na; na = nb; nb = tn;
+    }
+    if (na == 0) return 0;
+    if (nb / na >= INTERSECT_GALLOP_RATIO) return intersect_gallop(a, na, b, nb, out);
+    return intersect_simd(a, na, b, nb, out);
+}
+
+/* C = A ∩ B；失败（内存不足）返回 false */
+static inline bool IntersectArrays(const IntArray *A, const IntArray *B, IntArray *C) {
+    size_t cap = A->size < B->size ? A->size : B->size;
+    if (!ia_reserve(C, cap)) return false;
+    C->size = intersect_auto(A->data, A->size, B->data, B->size, C->data);
+    return true;
+}
+
+#endif /* INTERSECT_H */
@@ -0,0 +1,97 @@
+// 对递增序列 A，B 求交集 C（intersection.c 的大规模版本），比较各求交内核的速度
+// 编译: gcc -O2 -mavx2 intersection_fast.c -o intersection_fast   （不加 -mavx2 则用 SSE2）
+// 用法: intersection_fast [大表长度，默认 10000000]
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../../include/bench_util.h"
+#include "intersect.h"
+
+/* 原版思路：两指针 + 每个命中逐个追加 */
+void Intersection(const IntArray *A, const IntArray *B, IntArray *C)
+{
+    C->size = 0;
+    size_t i = 0, j = 0;
+    while (i < A->size && j < B->size)
+    {
+        if (A->data[i] < B->data[j])
+            i++;
+        else if (A->data[i] > B->data[j])
+            j++;
+        else
+        {
+            ia_push(C, A->data[i]);
+            i++;
+            j++;
+        }
+    }
+}
+
+/* 生成 n 个严格递增的随机数，平均间隔为 gap */
+static void gen_sorted(IntArray *a, size_t n, unsigned gap, unsigned seed)
+{
+    ia_reserve(a, n);
+    unsigned x = seed;
+    int v = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        x = x * 1664525u + 1013904223u;
+        v += 1 + (int)((x >> 8) % (2 * gap - 1));
+        a->data[i] = v;
+    }
+    a->size = n;
+}
+
+typedef size_t (*Kernel)(const int *, size_t, const int *, size_t, int *);
+
+static double time_kernel(Kernel f, const IntArray *A, const IntArray *B, IntArray *C, size_t *cnt)
+{
+    ia_reserve(C, A->size < B->size ? A->size : B->size);
+    double t0 = now_sec();
+    *cnt = f(A->data, A->size, B->data, B->size, C->data);
+    return now_sec() - t0;
+}
+
+int main(int argc, char **argv)
+{
+    /* 小例子，与 intersection.c 相同 */
+    int a[] = {1, 2, 4, 5, 6};
+    int b[] = {2, 3, 5, 7};
+    IntArray A, B, C;
+    ia_init(&A); ia_init(&B); ia_init(&C);
+    ia_assign(&A, a, 5);
+    ia_assign(&B, b, 4);
+    IntersectArrays(&A, &B, &C);
+    printf("Intersection C: ");
+    for (size_t i = 0; i < C.size; i++) printf("%d ", C.data[i]);
+    printf("\n\n");
+
+    size_t big = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 10000000;
+    gen_sorted(&B, big, 8, 7);
+    printf("%10s %10s %9s | %9s %9s %9s %9s %9s (ms)\n",
+           "|A|", "|B|", "|C|", "orig", "scalar", "simd", "gallop", "auto");
+    for (size_t small = 1000; small <= big; small *= 10)
+    {
+        /* 短表取值范围与长表相同，保证有相当比例的命中 */
+        unsigned gap = (unsigned)(8 * (big / small));
+        gen_sorted(&A, small, gap, 11);
+
+        double t0 = now_sec();
+        Intersection(&A, &B, &C);
+        double t_orig = now_sec() - t0;
+        size_t expect = C.size;
+
+        size_t c1, c2, c3, c4;
+        double t_sc = time_kernel(intersect_scalar, &A, &B, &C, &c1);
+        double t_simd = time_kernel(intersect_simd, &A, &B, &C, &c2);
+        double t_gal = time_kernel(intersect_gallop, &A, &B, &C, &c3);
+        double t_auto = time_kernel(intersect_auto, &A, &B, &C, &c4);
+        bool ok = c1 == expect && c2 == expect && c3 == expect && c4 == expect;
+
+        printf("%10zu %10zu %9zu | %9.3f %9.3f %9.3f %9.3f %9.3f %s\n", A.size, B.size, expect,
+               t_orig * 1e3, t_sc * 1e3, t_simd * 1e3, t_gal * 1e3, t_auto * 1e3, ok ? "" : "MISMATCH");
+    }
+
+    ia_free(&A); ia_free(&B); ia_free(&C);
+    return 0;
+}
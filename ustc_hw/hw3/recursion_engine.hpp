@@ -0,0 +1,149 @@
+/*
+ * 显式栈递归引擎（从 ackermann.c 的 akm_iter 抽象而来）
+ *
+ * akm_iter 的做法：把“还要做的事”压进自己的栈，用循环代替递归，避免系统栈溢出。
+ * 这里把它做成通用的 header-only 组件：
+ * - 帧类型由调用方给出（模板参数），只放必要的字段，越紧凑越好
+ * - SegmentedStack 按块增长：新块单独分配，旧块从不拷贝、帧地址从不失效；
+ *   弹空后的块留作复用，不反复 malloc/free
+ * - 可选帧数上限，超过时返回 Status::FrameLimit 而不是崩溃
+ * - 轨迹钩子通过 Trace::enabled 在编译期开关，关闭时不生成任何代码
+ *
+ * 用法：
+ *   struct F { ...; unsigned char pc; };            // 帧
+ *   auto step = [](F& f, const R& child) -> rec::Action<F, R> {
+ *       ... return rec::call<F, R>(F{...});          // 相当于递归调用
+ *       ... return rec::ret<F, R>(value);            // 相当于 return
+ *   };
+ *   rec::RunResult<R> r = rec::run<F, R>(F{...}, step);
+ * 子调用返回后，引擎会再次对父帧调用 step，child 参数即子调用的返回值，
+ * 父帧用自己的 pc 字段记住执行到了哪一步。
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace rec {
+
+/* ========== 分段栈 ========== */
+template <typename Frame, std::size_t ChunkFrames = 4096>
+class SegmentedStack {
+    static_assert(ChunkFrames >= 2, "ChunkFrames 太小");
+
+public:
+    SegmentedStack() = default;
+    SegmentedStack(const SegmentedStack &) = delete;
+    SegmentedStack &operator=(const SegmentedStack &) = delete;
+    ~SegmentedStack() {
+        for (Frame *c : chunks_) ::operator delete(c);
+    }
+
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return chunks_.size() * ChunkFrames; }
+
+    Frame &top() { return top_[-1]; }
+
+    Frame &push(const Frame &f) {
+        if (top_ == end_) next_chunk();
+        Frame *p = new (top_) Frame(f);
+        ++top_;
+        ++size_;
+        return *p;
+    }
+
+    void pop() {
+        --top_;
+        top_->~Frame();
+        --size_;
+        if (top_ == begin_ && cur_ > 0) {   // 退回上一块，当前块保留备用
+            --cur_;
+            begin_ = chunks_[cur_];
+            end_ = top_ = begin_ + ChunkFrames;
+        }
+    }
+
+    /* 自底向上访问第 i 帧（轨迹打印用） */
+    const Frame &at(std::size_t i) const { return chunks_[i / ChunkFrames][i % ChunkFrames]; }
+
+private:
+    std::vector<Frame *> chunks_;
+    std::size_t cur_ = 0, size_ = 0;
+    Frame *begin_ = nullptr, *top_ = nullptr, *end_ = nullptr;
+
+    void next_chunk() {
+        if (begin_ != nullptr) ++cur_;
+        if (cur_ == chunks_.size())
+            chunks_.push_back(static_cast<Frame *>(::operator new(sizeof(Frame) * ChunkFrames)));
+        begin_ = top_ = chunks_[cur_];
+        end_ = begin_ + ChunkFrames;
+    }
+};
+
+/* ========== 步进结果 ========== */
+template <typename Frame, typename Result>
+struct Action {
+    bool isCall;
+    Frame child;     // isCall 时有效
+    Result value;    // !isCall 时有效
+};
+
+template <typename Frame, typename Result>
+inline Action<Frame, Result> call(const Frame &child) { return Action<Frame, Result>{true, child, Result{}}; }
+
+template <typename Frame, typename Result>
+inline Action<Frame, Result> ret(const Result &v) { return Action<Frame, Result>{false, Frame{}, v}; }
+
+/* ========== 轨迹钩子 ========== */
+/* 默认不追踪：enabled 为 false 时 run 中的钩子调用被 if constexpr 整体剔除 */
+struct NoTrace {
+    static constexpr bool enabled = false;
+    template <typename Frame> void on_call(const Frame &, std::size_t) {}
+    template <typename Frame, typename Result> void on_return(const Frame &, const Result &, std::size_t) {}
+};
+
+enum class Status { Ok, FrameLimit };
+
+template <typename Result>
+struct RunResult {
+    Status status;
+    Result value;
+    std::uint64_t frames;      // 共压入的帧数（含初始帧）
+    std::size_t maxDepth;      // 栈的最大深度
+};
+
+/* ========== 引擎 ========== */
+/* maxFrames 为 0 表示不限制栈深 */
+template <typename Frame, typename Result, std::size_t ChunkFrames = 4096, typename Step, typename Trace = NoTrace>
+RunResult<Result> run(const Frame &init, Step step, std::size_t maxFrames = 0, Trace &&trace = Trace{}) {
+    SegmentedStack<Frame, ChunkFrames> st;
+    Result last{};
+    std::uint64_t frames = 1;
+    std::size_t maxDepth = 1;
+
+    if constexpr (std::decay_t<Trace>::enabled) trace.on_call(init, 0);
+    st.push(init);
+    for (;;) {
+        Action<Frame, Result> a = step(st.top(), static_cast<const Result &>(last));
+        if (a.isCall) {
+            if (maxFrames && st.size() >= maxFrames)
+                return RunResult<Result>{Status::FrameLimit, Result{}, frames, maxDepth};
+            if constexpr (std::decay_t<Trace>::enabled) trace.on_call(a.child, st.size());
+            st.push(a.child);
+            ++frames;
+            if (st.size() > maxDepth) maxDepth = st.size();
+        } else {
+            if constexpr (std::decay_t<Trace>::enabled) trace.on_return(st.top(), a.value, st.size() - 1);
+            st.pop();
+            last = a.value;
+            if (st.empty()) return RunResult<Result>{Status::Ok, last, frames, maxDepth};
+        }
+    }
+}
+
+} // namespace rec
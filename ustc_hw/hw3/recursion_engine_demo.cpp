@@ -0,0 +1,129 @@
+/*
+ * recursion_engine.hpp 的演示与测速
+ * - akm_rec / akm_rec_trace 移植到显式栈引擎
+ * - 深度 10^7 的链表递归求和（原生递归会爆栈）
+ * - 与原生递归比较每秒处理的帧数
+ *
+ * 编译: g++ -std=c++17 -O2 recursion_engine_demo.cpp -o recursion_engine_demo
+ */
+
+#include <cstdio>
+#include <vector>
+#include "../../include/bench_util.h"
+#include "recursion_engine.hpp"
+
+/*==================== 原生递归（同 ackermann.c） ====================*/
+static unsigned long long native_calls = 0;
+unsigned long long akm_rec(unsigned int m, unsigned int n) {
+    ++native_calls;
+    if (m == 0) return n + 1ULL;
+    if (n == 0) return akm_rec(m - 1, 1);
+    return akm_rec(m - 1, akm_rec(m, n - 1));
+}
+
+/*==================== Ackermann 帧 ====================*/
+/* 12 字节：m, n 以及恢复点 pc（0=刚进入，1=内层 akm(m,n-1) 已返回，2=外层已返回） */
+struct AkmFrame {
+    unsigned m, n;
+    unsigned char pc;
+};
+
+static inline rec::Action<AkmFrame, unsigned long long> akm_step_impl(AkmFrame &f, const unsigned long long &child) {
+    using A = rec::Action<AkmFrame, unsigned long long>;
+    switch (f.pc) {
+    case 0:
+        if (f.m == 0) return A{false, {}, f.n + 1ULL};
+        f.pc = 2;
+        if (f.n == 0) return A{true, {f.m - 1, 1, 0}, 0};
+        f.pc = 1;
+        return A{true, {f.m, f.n - 1, 0}, 0};
+    case 1:
+        f.pc = 2;
+        return A{true, {f.m - 1, (unsigned)child, 0}, 0};
+    default:
+        return A{false, {}, child};
+    }
+}
+
+/* 用 lambda 包一层，让 run 的模板实例化能内联步进函数（函数指针通常不会被内联） */
+static const auto akm_step = [](AkmFrame &f, const unsigned long long &c) { return akm_step_impl(f, c); };
+
+/*==================== 轨迹：移植 akm_rec_trace ====================*/
+struct AkmTrace {
+    static constexpr bool enabled = true;
+    unsigned long long step_id = 0;
+    void indent(std::size_t d) { printf("%*s", (int)(2 * d), ""); }
+    void on_call(const AkmFrame &f, std::size_t depth) {
+        indent(depth); printf("step %llu: call  akm(%u,%u)\n", ++step_id, f.m, f.n);
+    }
+    void on_return(const AkmFrame &f, unsigned long long r, std::size_t depth) {
+        indent(depth); printf("ret   akm(%u,%u) = %llu%s\n", f.m, f.n, r, f.m == 0 ? "  (m==0)" : "");
+    }
+};
+
+/*==================== 深递归：链表递归求和 ====================*/
+struct ListNode { long long v; ListNode *next; };
+
+struct SumFrame {
+    const ListNode *p;
+    unsigned char pc;
+};
+
+static inline rec::Action<SumFrame, long long> sum_step_impl(SumFrame &f, const long long &child) {
+    if (f.pc == 0) {
+        if (!f.p) return rec::ret<SumFrame, long long>(0);
+        f.pc = 1;
+        return rec::call<SumFrame, long long>(SumFrame{f.p->next, 0});
+    }
+    return rec::ret<SumFrame, long long>(f.p->v + child);
+}
+
+static const auto sum_step = [](SumFrame &f, const long long &c) { return sum_step_impl(f, c); };
+
+template <typename F>
+static double seconds(F fn) {
+    double t0 = now_sec();
+    fn();
+    return now_sec() - t0;
+}
+
+int main() {
+    /* 正确性 */
+    for (unsigned m = 0; m <= 3; ++m)
+        for (unsigned n = 0; n <= 5; ++n) {
+            auto r = rec::run<AkmFrame, unsigned long long>(AkmFrame{m, n, 0}, akm_step);
+            if (r.value != akm_rec(m, n)) printf("mismatch at (%u,%u)\n", m, n);
+        }
+
+    /* 轨迹（与 ackermann.c 中 akm_rec_trace(2,1) 对应） */
+    printf("Trace for akm(2,1) on rec::run:\n");
+    auto rt = rec::run<AkmFrame, unsigned long long>(AkmFrame{2, 1, 0}, akm_step, 0, AkmTrace{});
+    printf("result = %llu, frames = %llu, max depth = %zu\n\n", rt.value,
+           (unsigned long long)rt.frames, rt.maxDepth);
+
+    /* 帧数上限 */
+    auto lim = rec::run<AkmFrame, unsigned long long>(AkmFrame{3, 8, 0}, akm_step, 100);
+    printf("akm(3,8) with 100-frame limit: %s\n\n",
+           lim.status == rec::Status::FrameLimit ? "FrameLimit" : "Ok");
+
+    /* 速度：原生递归 vs 引擎（均无轨迹） */
+    const unsigned M = 3, N = 10;
+    unsigned long long r1 = 0;
+    native_calls = 0;
+    double tn = seconds([&] { r1 = akm_rec(M, N); });
+    rec::RunResult<unsigned long long> r2{};
+    double te = seconds([&] { r2 = rec::run<AkmFrame, unsigned long long>(AkmFrame{M, N, 0}, akm_step); });
+    printf("akm(%u,%u) = %llu / %llu\n", M, N, r1, r2.value);
+    printf("  native : %.1f M frames/s\n", native_calls / tn / 1e6);
+    printf("  engine : %.1f M frames/s (max depth %zu)\n\n", r2.frames / te / 1e6, r2.maxDepth);
+
+    /* 深度 10^7 的递归：原生递归在默认 8MB 栈上无法完成 */
+    const int LEN = 10000000;
+    std::vector<ListNode> nodes(LEN);
+    for (int i = 0; i < LEN; ++i) nodes[i] = ListNode{i + 1LL, i + 1 < LEN ? &nodes[i + 1] : nullptr};
+    rec::RunResult<long long> rs{};
+    double ts = seconds([&] { rs = rec::run<SumFrame, long long, 1 << 16>(SumFrame{&nodes[0], 0}, sum_step); });
+    printf("recursive list sum, depth %zu: %lld (expect %lld), %.1f M frames/s\n", rs.maxDepth, rs.value,
+           (long long)LEN * (LEN + 1) / 2, rs.frames / ts / 1e6);
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * 自组织线性表（freq_list.c 的推广），header-only，C99
+ *
+ * 与 freq_list.c 相同的带头结点双向循环链表，LOCATE 命中后按所选策略调整位置：
+ * - SO_COUNT：频度 +1，向前移到第一个频度 >= 它的结点之后（同频稳定，即 freq_list.c 的做法）
+ * - SO_MOVE_TO_FRONT：移到表头
+ * - SO_TRANSPOSE：与前驱交换
+ * - SO_MOVE_AHEAD_K：向前移 k 个位置（不越过表头）
+ * - SO_COUNT_DECAY：同 SO_COUNT，另外每 period 次 LOCATE 把所有频度减半（老化），
+ *                   让过去的热点逐渐让位。减半保持非增序，不需要重排
+ *
+ * INSERT 放入新结点的位置：计数类策略按频度 1 放在所有频度 >= 1 的结点之后
+ * （从表尾往前找，通常 O(1)）；SO_MOVE_TO_FRONT 放表头；其余放表尾。
+ *
+ * 每次 so_locate 把比较过的结点数记在 L->last_depth（未命中时为表长），供模拟器统计平均查找深度。
+ *
+ * 用法：
+ *     SoList L;
+ *     so_init(&L, SO_MOVE_AHEAD_K, 4);          // 第三个参数：k 或 period，其余策略忽略
+ *     if (!so_locate(&L, x)) so_insert(&L, x);
+ *     so_destroy(&L);
+ */
+#ifndef SELFORG_LIST_H
+#define SELFORG_LIST_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef enum {
+    SO_COUNT,
+    SO_MOVE_TO_FRONT,
+    SO_TRANSPOSE,
+    SO_MOVE_AHEAD_K,
+    SO_COUNT_DECAY,
+    SO_NPOLICIES
+} SoPolicy;
+
+typedef struct SoNode {
+    int data;
+    int freq;
+    struct SoNode *prev, *next;
+} SoNode;
+
+typedef struct {
+    SoNode head;          /* 头结点，freq = INT_MAX，便于统一处理 */
+    SoPolicy policy;
+    unsigned param;       /* SO_MOVE_AHEAD_K 的 k；SO_COUNT_DECAY 的 period */
+    unsigned ticks;       /* SO_COUNT_DECAY：距上次减半的 LOCATE 次数 */
+    size_t size;
+    size_t last_depth;
+} SoList;
+
+static inline const char *so_policy_name(SoPolicy p) {
+    switch (p) {
+    case SO_COUNT: return "count";
+    case SO_MOVE_TO_FRONT: return "move-to-front";
+    case SO_TRANSPOSE: return "transpose";
+    case SO_MOVE_AHEAD_K: return "move-ahead-k";
+    case SO_COUNT_DECAY: return "count+decay";
+    default: return "?";
+    }
+}
+
+static inline void so_init(SoList *L, SoPolicy policy, unsigned param) {
+    L->head.data = 0;
+    L->head.freq = INT_MAX;
+    L->head.prev = L->head.next = &L->head;
+    L->policy = policy;
+    L->param = param ? param : (policy == SO_COUNT_DECAY ? 1024 : 1);
+    L->ticks = 0;
+    L->size = 0;
+    L->last_depth = 0;
+}
+
+static inline void so__detach(SoNode *p) {
+    p->prev->next = p->next;
+    p->next->prev = p->prev;
+}
+
+/* 在结点 q 之后插入结点 p */
+static inline void so__insert_after(SoNode *q, SoNode *p) {
+    p->next = q->next;
+    p->prev = q;
+    q->next->prev = p;
+    q->next = p;
+}
+
+/* p 的频度已经 +1：向前移到第一个 freq >= p->freq 的结点之后（遇到相等就停，保持稳定） */
+static inline void so__bubble_by_count(SoNode *p) {
+    if (p->prev->freq >= p->freq) return;
+    SoNode *q = p->prev;
+    while (q->freq < p->freq) q = q->prev;   /* 头结点的 INT_MAX 做哨兵 */
+    so__detach(p);
+    so__insert_after(q, p);
+}
+
+static inline void so__decay(SoList *L) {
+    for (SoNode *p = L->head.next; p != &L->head; p = p->next) p->freq >>= 1;
+}
+
+/* LOCATE(L, x)：找到值为 x 的结点并按策略调整，未找到返回 NULL */
+static inline SoNode *so_locate(SoList *L, int x) {
+    SoNode *const H = &L->head;
+    SoNode *p = H->next;
+    size_t depth = 1;
+    while (p != H && p->data != x) {
+        p = p->next;
+        ++depth;
+    }
+    if (L->policy == SO_COUNT_DECAY && ++L->ticks >= L->param) {
+        L->ticks = 0;
+        so__decay(L);
+    }
+    if (p == H) {
+        L->last_depth = L->size;
+        return NULL;
+    }
+    L->last_depth = depth;
+    if (p->freq < INT_MAX - 1) p->freq++;
+
+    switch (L->policy) {
+    case SO_COUNT:
+    case SO_COUNT_DECAY:
+        so__bubble_by_count(p);
+        break;
+    case SO_MOVE_TO_FRONT:
+        if (p->prev != H) {
+            so__detach(p);
+            so__insert_after(H, p);
+        }
+        break;
+    case SO_TRANSPOSE:
+        if (p->prev != H) {
+            SoNode *q = p->prev->prev;
+            so__detach(p);
+            so__insert_after(q, p);
+        }
+        break;
+    case SO_MOVE_AHEAD_K: {
+        SoNode *q = p->prev;
+        for (unsigned i = 0; i < L->param && q != H; ++i) q = q->prev;
+        if (q != p->prev) {
+            so__detach(p);
+            so__insert_after(q, p);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return p;
+}
+
+/* INSERT(L, x)：插入值为 x 的新结点，频度置 1；不检查重复。内存不足返回 NULL */
+static inline SoNode *so_insert(SoList *L, int x) {
+    SoNode *p = (SoNode *)malloc(sizeof(SoNode));
+    if (!p) return NULL;
+    p->data = x;
+    p->freq = 1;
+    SoNode *const H = &L->head;
+    switch (L->policy) {
+    case SO_COUNT:
+    case SO_COUNT_DECAY: {
+        /* 从表尾往前跳过频度 < 1 的结点（只有老化后才会出现），放在它们前面 */
+        SoNode *q = H->prev;
+        while (q->freq < 1) q = q->prev;
+        so__insert_after(q, p);
+        break;
+    }
+    case SO_MOVE_TO_FRONT:
+        so__insert_after(H, p);
+        break;
+    default:
+        so__insert_after(H->prev, p);
+        break;
+    }
+    L->size++;
+    return p;
+}
+
+/* 检查前后指针是否一致、长度是否正确；计数类策略还要求频度非增 */
+static inline bool so_check(const SoList *L) {
+    const SoNode *H = &L->head;
+    size_t n = 0;
+    for (const SoNode *p = H->next; p != H; p = p->next) {
+        if (p->prev->next != p || p->next->prev != p) return false;
+        if ((L->policy == SO_COUNT || L->policy == SO_COUNT_DECAY) && p->prev->freq < p->freq) return false;
+        if (++n > L->size) return false;
+    }
+    return n == L->size;
+}
+
+static inline void so_print(const SoList *L) {
+    for (const SoNode *p = L->head.next; p != &L->head; p = p->next) printf("(%d, %d) ", p->data, p->freq);
+    printf("\n");
+}
+
+static inline void so_destroy(SoList *L) {
+    SoNode *p = L->head.next;
+    while (p != &L->head) {
+        SoNode *q = p->next;
+        free(p);
+        p = q;
+    }
+    L->head.prev = L->head.next = &L->head;
+    L->size = 0;
+}
+
+#endif /* SELFORG_LIST_H */
@@ -0,0 +1,279 @@
+// 自组织线性表（selforg_list.h）各策略的访问日志回放：平均查找深度、ns/访问、缓存缺失
+// 编译: gcc -O2 selforg_sim.c -o selforg_sim -lm
+// 用法: selforg_sim [-n 键数，默认 1000] [-m 访问次数，默认 1000000] [-w 负载] [-s Zipf 指数，默认 1.0]
+//                   [-k move-ahead-k 的步数，默认 4] [-p count+decay 的减半周期，默认 10 * 键数]
+//       负载：uniform、zipf（默认）、shift（热点集合每 m/8 次访问换一次），
+//             或访问日志文件名（空白分隔的整数键，- 为 stdin）
+// 每次访问先 LOCATE，未命中再 INSERT（即把表当作查找缓存用）。
+// "orig" 一行是 freq_list.c 原来的 LOCATE/INSERT，回放后与 count 策略逐结点比对，二者应完全一致。
+// Linux 下用 perf_event_open 读取 L1D 读缺失 / LLC 缺失；没有权限或非 Linux 时只报时间。
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "selforg_list.h"
+#include "../../include/bench_util.h"
+#include "../../include/fastio.h"
+
+/* Linux 下读 L1D 读缺失 / LLC 缺失 */
+static const HwEvent hw_events[] = {HW_L1D_MISS, HW_LLC_MISS};
+
+/*==================== freq_list.c 原版（对照组） ====================*/
+typedef struct DNode {
+    int data;
+    int freq;
+    struct DNode *prev, *next;
+} DNode, *DList;
+
+static DList InitList(void) {
+    DList L = (DList)malloc(sizeof(DNode));
+    L->data = 0;
+    L->freq = INT_MAX;
+    L->prev = L->next = L;
+    return L;
+}
+
+static void detach(DNode *p) {
+    p->prev->next = p->next;
+    p->next->prev = p->prev;
+}
+
+static void insert_after(DNode *q, DNode *p) {
+    p->next = q->next;
+    p->prev = q;
+    q->next->prev = p;
+    q->next = p;
+}
+
+static size_t orig_depth;   /* 与 SoList.last_depth 同义 */
+
+static DNode *LOCATE(DList L, int x) {
+    DNode *p = L->next;
+    size_t depth = 1;
+    while (p != L && p->data != x) { p = p->next; ++depth; }
+    if (p == L) { orig_depth = depth - 1; return NULL; }
+    orig_depth = depth;
+    p->freq++;
+    if (p->prev->freq >= p->freq) return p;
+    DNode *q = p->prev;
+    while (q != L && q->freq < p->freq) q = q->prev;
+    detach(p);
+    insert_after(q, p);
+    return p;
+}
+
+static DNode *INSERT(DList L, int x) {
+    DNode *p = (DNode *)malloc(sizeof(DNode));
+    p->data = x;
+    p->freq = 1;
+    DNode *q = L->next;
+    while (q != L && q->freq >= p->freq) q = q->next;
+    insert_after(q->prev, p);
+    return p;
+}
+
+static void DestroyList(DList L) {
+    DNode *p = L->next, *q;
+    while (p != L) { q = p->next; free(p); p = q; }
+    free(L);
+}
+
+/*==================== 负载生成 ====================*/
+static unsigned long long rng_state = 88172645463325252ULL;
+
+static unsigned long long rng_next(void) {   /* xorshift64 */
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double rng_unit(void) { return (double)(rng_next() >> 11) * (1.0 / 9007199254740992.0); }
+
+/* 键 0..n-1 的随机排列：排名与键值、首次出现次序都不相关 */
+static int *random_perm(int n) {
+    int *perm = (int *)malloc((size_t)n * sizeof(int));
+    for (int i = 0; i < n; ++i) perm[i] = i;
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)(rng_next() % (unsigned long long)(i + 1));
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    return perm;
+}
+
+static void gen_uniform(int *trace, size_t m, int n) {
+    for (size_t i = 0; i < m; ++i) trace[i] = (int)(rng_next() % (unsigned long long)n);
+}
+
+/* 第 r 名（从 0 起）的概率正比于 1/(r+1)^s；按累积分布二分抽样 */
+static void gen_zipf(int *trace, size_t m, int n, double s) {
+    double *cdf = (double *)malloc((size_t)n * sizeof(double));
+    int *perm = random_perm(n);
+    double acc = 0;
+    for (int r = 0; r < n; ++r) cdf[r] = acc += pow(r + 1.0, -s);
+    for (size_t i = 0; i < m; ++i) {
+        double u = rng_unit() * acc;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1; else hi = mid;
+        }
+        trace[i] = perm[lo];
+    }
+    free(cdf);
+    free(perm);
+}
+
+/* 热点漂移：1% 的键承担 90% 的访问，热点集合每 m/8 次访问随机换一次 */
+static void gen_shift(int *trace, size_t m, int n) {
+    int *perm = random_perm(n);
+    int hot = n / 100 > 0 ? n / 100 : 1;
+    size_t phase = m / 8 > 0 ? m / 8 : 1;
+    int base = 0;
+    for (size_t i = 0; i < m; ++i) {
+        if (i % phase == 0) base = (int)(rng_next() % (unsigned long long)n);
+        if (rng_next() % 10 < 9) trace[i] = perm[(base + (int)(rng_next() % (unsigned long long)hot)) % n];
+        else trace[i] = perm[rng_next() % (unsigned long long)n];
+    }
+    free(perm);
+}
+
+/* 读访问日志；返回访问次数，失败返回 0 */
+static size_t load_trace(const char *path, int **out) {
+    FioReader in;
+    if (fio_open(&in, strcmp(path, "-") == 0 ? NULL : path) != 0) { perror(path); return 0; }
+    size_t m = 0, cap = 1 << 16;
+    int *trace = (int *)malloc(cap * sizeof(int));
+    if (!trace) { perror("malloc"); fio_close(&in); return 0; }
+    int x, rc;
+    while ((rc = fio_read_int(&in, &x)) != 0) {
+        if (rc < 0) continue;
+        if (m == cap) {
+            int *t = (int *)realloc(trace, cap * 2 * sizeof(int));
+            if (!t) { perror("realloc"); free(trace); fio_close(&in); return 0; }
+            trace = t;
+            cap *= 2;
+        }
+        trace[m++] = x;
+    }
+    fio_close(&in);
+    *out = trace;
+    return m;
+}
+
+/*==================== 回放 ====================*/
+static HwCounters hw;
+
+static void report(const char *name, size_t m, double t, double depth_sum, size_t inserts, const char *note) {
+    printf("  %-14s %10.2f %9.1f %9zu", name, depth_sum / (double)m, t * 1e9 / (double)m, inserts);
+    for (int i = 0; i < hw.n; ++i) {
+        if (hw.val[i] >= 0) printf(" %9.3f", (double)hw.val[i] / (double)m);
+        else printf(" %9s", "-");
+    }
+    printf("  %s\n", note);
+}
+
+static void replay_policy(SoPolicy policy, unsigned param, const int *trace, size_t m, SoList *L) {
+    so_init(L, policy, param);
+    double depth_sum = 0;
+    size_t inserts = 0;
+    hw_start(&hw);
+    double t0 = now_sec();
+    for (size_t i = 0; i < m; ++i) {
+        if (!so_locate(L, trace[i])) {
+            so_insert(L, trace[i]);
+            ++inserts;
+        }
+        depth_sum += (double)L->last_depth;
+    }
+    double t = now_sec() - t0;
+    hw_stop(&hw);
+    char name[32];
+    if (policy == SO_MOVE_AHEAD_K) snprintf(name, sizeof name, "move-ahead-%u", L->param);
+    else snprintf(name, sizeof name, "%s", so_policy_name(policy));
+    report(name, m, t, depth_sum, inserts, so_check(L) ? "" : "LIST CORRUPTED");
+}
+
+static DList replay_orig(const int *trace, size_t m) {
+    DList L = InitList();
+    double depth_sum = 0;
+    size_t inserts = 0;
+    hw_start(&hw);
+    double t0 = now_sec();
+    for (size_t i = 0; i < m; ++i) {
+        if (!LOCATE(L, trace[i])) {
+            INSERT(L, trace[i]);
+            ++inserts;
+        }
+        depth_sum += (double)orig_depth;
+    }
+    double t = now_sec() - t0;
+    hw_stop(&hw);
+    report("orig", m, t, depth_sum, inserts, "");
+    return L;
+}
+
+/* 原版与 count 策略的最终表应逐结点相同（值与频度） */
+static int same_order(DList A, const SoList *B) {
+    const DNode *p = A->next;
+    const SoNode *q = B->head.next;
+    for (; p != A && q != &B->head; p = p->next, q = q->next)
+        if (p->data != q->data || p->freq != q->freq) return 0;
+    return p == A && q == &B->head;
+}
+
+int main(int argc, char **argv) {
+    int n = 1000;
+    size_t m = 1000000;
+    const char *workload = "zipf";
+    double s = 1.0;
+    unsigned k = 4, period = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0) n = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-m") == 0) m = (size_t)strtoull(argv[i + 1], NULL, 10);
+        else if (strcmp(argv[i], "-w") == 0) workload = argv[i + 1];
+        else if (strcmp(argv[i], "-s") == 0) s = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "-k") == 0) k = (unsigned)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-p") == 0) period = (unsigned)atoi(argv[i + 1]);
+        else { fprintf(stderr, "未知选项 %s\n", argv[i]); return 1; }
+    }
+    if (n < 1 || m < 1) { fprintf(stderr, "键数与访问次数必须为正\n"); return 1; }
+    if (!period) period = 10u * (unsigned)n;
+
+    int *trace = NULL;
+    if (strcmp(workload, "uniform") == 0 || strcmp(workload, "zipf") == 0 || strcmp(workload, "shift") == 0) {
+        trace = (int *)malloc(m * sizeof(int));
+        if (workload[0] == 'u') gen_uniform(trace, m, n);
+        else if (workload[0] == 'z') gen_zipf(trace, m, n, s);
+        else gen_shift(trace, m, n);
+        printf("workload %s, %d keys, %zu accesses", workload, n, m);
+        if (workload[0] == 'z') printf(", s = %.2f", s);
+        printf("\n");
+    } else {
+        m = load_trace(workload, &trace);
+        if (!m) { fprintf(stderr, "%s: 没有读到访问记录\n", workload); return 1; }
+        printf("trace %s, %zu accesses\n", workload, m);
+    }
+
+    hw_open(&hw, hw_events, (int)(sizeof(hw_events) / sizeof(hw_events[0])));
+    printf("  %-14s %10s %9s %9s", "policy", "avg depth", "ns/acc", "inserts");
+    for (int i = 0; i < hw.n; ++i) printf(" %9s", hw_name(hw.ev[i]));
+    printf("  (缺失数为每次访问)\n");
+
+    DList orig = replay_orig(trace, m);
+    int rc = 0;
+    for (int p = 0; p < SO_NPOLICIES; ++p) {
+        SoList L;
+        unsigned param = p == SO_MOVE_AHEAD_K ? k : p == SO_COUNT_DECAY ? period : 0;
+        replay_policy((SoPolicy)p, param, trace, m, &L);
+        if (p == SO_COUNT && !same_order(orig, &L)) {
+            printf("  count 策略与 freq_list.c 原版的结果不一致\n");
+            rc = 1;
+        }
+        so_destroy(&L);
+    }
+    DestroyList(orig);
+    free(trace);
+    hw_close(&hw);
+    return rc;
+}
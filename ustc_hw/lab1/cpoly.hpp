@@ -0,0 +1,189 @@
+/*
+ * 编译期多项式，header-only，C++17
+ *
+ * CPoly<T, N> 是次数 < N 的稠密多项式，系数 a[0..N) 按升幂存放，N 是模板参数。
+ * - add / sub / multiply / derivative / compose 都是 constexpr，结果的长度在类型里算好：
+ *   multiply 得到 CPoly<T, N + M - 1>，derivative 得到 CPoly<T, N - 1>
+ * - horner(x)：展开成 N - 1 次乘加（折叠表达式，没有循环），依赖链长 N - 1
+ * - estrin(x)：按 2 的幂对半拆分，先算 x, x^2, x^4, ...，依赖链长约 2 log N，
+ *   高次时比 Horner 更能利用指令级并行
+ * - evalMany(x, y, n)：对数组逐点求值，内层是展开后的 Horner（低次）或 Estrin（高次），
+ *   编译器可以沿 x 方向向量化
+ * - toPoly / fromPoly：与运行时的 Poly（lab1/poly.hpp）互相转换，要求系数为整数类型
+ *
+ * 稀疏的编译期多项式（如近似核 x + c3 x^3 + c5 x^5 ...）用 fromTerms 按 (系数, 指数) 给出，
+ * 次数 64 以内稠密存储的代价可以忽略。
+ */
+#ifndef CPOLY_HPP
+#define CPOLY_HPP
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "poly.hpp"
+
+template <typename T, std::size_t N>
+struct CPoly {
+    static_assert(N >= 1, "CPoly: need at least one coefficient");
+    std::array<T, N> a{};
+
+    static constexpr std::size_t size() { return N; }
+    static constexpr int degreeBound() { return int(N) - 1; }
+
+    constexpr T operator[](std::size_t i) const { return a[i]; }
+
+    constexpr T horner(T x) const { return hornerImpl(x, std::make_index_sequence<N - 1>{}); }
+
+    constexpr T estrin(T x) const {
+        std::array<T, powCount()> xp{};  // xp[k] = x^(2^k)
+        if constexpr (powCount() > 0) {
+            xp[0] = x;
+            for (std::size_t k = 1; k < powCount(); ++k) xp[k] = xp[k - 1] * xp[k - 1];
+        }
+        return estrinImpl<0, N>(xp);
+    }
+
+    constexpr T operator()(T x) const { return horner(x); }
+
+    // y[i] = P(x[i])；各点之间没有依赖，循环体展开后由编译器沿 i 向量化。
+    // 低次用 Horner（运算最少），次数高了依赖链成为瓶颈，换 Estrin
+    void evalMany(const T* x, T* y, std::size_t n) const {
+        for (std::size_t i = 0; i < n; ++i) {
+            if constexpr (N <= 8) y[i] = horner(x[i]);
+            else y[i] = estrin(x[i]);
+        }
+    }
+
+    template <typename U>
+    constexpr CPoly<U, N> cast() const {
+        CPoly<U, N> r;
+        for (std::size_t i = 0; i < N; ++i) r.a[i] = U(a[i]);
+        return r;
+    }
+
+private:
+    template <std::size_t... I>
+    constexpr T hornerImpl(T x, std::index_sequence<I...>) const {
+        T r = a[N - 1];
+        ((r = r * x + a[N - 2 - I]), ...);
+        return r;
+    }
+
+    static constexpr std::size_t powCount() {
+        std::size_t k = 0;
+        while ((std::size_t(1) << (k + 1)) < N) ++k;
+        return N > 1 ? k + 1 : 0;
+    }
+
+    // a[L .. L+Len) 这一段：拆成低 H 项和高 Len-H 项，H 为小于 Len 的最大 2 的幂
+    template <std::size_t L, std::size_t Len, typename Pows>
+    constexpr T estrinImpl(const Pows& xp) const {
+        if constexpr (Len == 1) {
+            return a[L];
+        } else {
+            constexpr std::size_t H = highPow(Len);
+            constexpr std::size_t K = ilog2(H);
+            return estrinImpl<L, H>(xp) + xp[K] * estrinImpl<L + H, Len - H>(xp);
+        }
+    }
+    static constexpr std::size_t highPow(std::size_t len) {
+        std::size_t h = 1;
+        while (h * 2 < len) h *= 2;
+        return h;
+    }
+    static constexpr std::size_t ilog2(std::size_t h) {
+        std::size_t k = 0;
+        while ((std::size_t(1) << k) < h) ++k;
+        return k;
+    }
+};
+
+// 由 (系数, 指数) 构造，同一指数的系数相加；指数超出 [0, N) 时编译期报错（常量求值中抛异常）
+template <typename T, std::size_t N>
+constexpr CPoly<T, N> fromTerms(std::initializer_list<std::pair<T, int>> terms) {
+    CPoly<T, N> r;
+    for (const auto& t : terms) {
+        if (t.second < 0 || std::size_t(t.second) >= N) throw std::out_of_range("CPoly: exponent out of range");
+        r.a[std::size_t(t.second)] += t.first;
+    }
+    return r;
+}
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr CPoly<T, (N > M ? N : M)> add(const CPoly<T, N>& A, const CPoly<T, M>& B) {
+    CPoly<T, (N > M ? N : M)> r;
+    for (std::size_t i = 0; i < N; ++i) r.a[i] += A.a[i];
+    for (std::size_t i = 0; i < M; ++i) r.a[i] += B.a[i];
+    return r;
+}
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr CPoly<T, (N > M ? N : M)> sub(const CPoly<T, N>& A, const CPoly<T, M>& B) {
+    CPoly<T, (N > M ? N : M)> r;
+    for (std::size_t i = 0; i < N; ++i) r.a[i] += A.a[i];
+    for (std::size_t i = 0; i < M; ++i) r.a[i] -= B.a[i];
+    return r;
+}
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr CPoly<T, N + M - 1> multiply(const CPoly<T, N>& A, const CPoly<T, M>& B) {
+    CPoly<T, N + M - 1> r;
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < M; ++j) r.a[i + j] += A.a[i] * B.a[j];
+    return r;
+}
+
+template <typename T, std::size_t N>
+constexpr CPoly<T, (N > 1 ? N - 1 : 1)> derivative(const CPoly<T, N>& A) {
+    CPoly<T, (N > 1 ? N - 1 : 1)> r;
+    for (std::size_t i = 1; i < N; ++i) r.a[i - 1] = A.a[i] * T(i);
+    return r;
+}
+
+// A(B(x))，用 Horner：结果长度 (N-1)(M-1)+1
+template <typename T, std::size_t N, std::size_t M>
+constexpr CPoly<T, (N - 1) * (M - 1) + 1> compose(const CPoly<T, N>& A, const CPoly<T, M>& B) {
+    constexpr std::size_t R = (N - 1) * (M - 1) + 1;
+    CPoly<T, R> r;
+    r.a[0] = A.a[N - 1];
+    for (std::size_t k = N - 1; k-- > 0;) {
+        CPoly<T, R> t;  // r * B，只保留前 R 项（不会更长）
+        for (std::size_t i = 0; i < R; ++i) {
+            if (r.a[i] == T(0)) continue;
+            for (std::size_t j = 0; j < M && i + j < R; ++j) t.a[i + j] += r.a[i] * B.a[j];
+        }
+        t.a[0] += A.a[k];
+        r = t;
+    }
+    return r;
+}
+
+// ---- 与运行时 Poly 的转换（Poly 的系数是 long long，指数是 int） ----
+
+template <typename T, std::size_t N>
+Poly toPoly(const CPoly<T, N>& A) {
+    static_assert(std::is_integral<T>::value, "toPoly: Poly stores integer coefficients");
+    Term terms[N];
+    int n = 0;
+    for (std::size_t i = N; i-- > 0;)
+        if (A.a[i] != T(0)) terms[n++] = {(long long)A.a[i], int(i)};
+    Poly P;
+    P.buildFromTerms(terms, n);
+    return P;
+}
+
+// 次数 >= N 或指数为负时抛 std::out_of_range
+template <std::size_t N, typename T = long long>
+CPoly<T, N> fromPoly(const Poly& P) {
+    CPoly<T, N> r;
+    for (const Node* p = P.firstTerm(); p; p = p->next) {
+        if (p->e < 0 || std::size_t(p->e) >= N) throw std::out_of_range("fromPoly: degree does not fit");
+        r.a[std::size_t(p->e)] = T(p->c);
+    }
+    return r;
+}
+
+#endif  // CPOLY_HPP
@@ -0,0 +1,388 @@
+/*
+ * 多元稀疏多项式，指数向量打包进一个 64 位字，header-only，C++17
+ *
+ * 单项式编码：nvars 个变量（1..8）各占 b = 64 / nvars 位，变量 0 在最高的字段里，
+ * 每个字段的最高位是保护位，指数上限为 2^(b-1) - 1（8 个变量时 127，4 个变量时 32767）。
+ * 于是
+ * - 字典序比较（变量 0 优先）就是整数比较
+ * - 单项式相乘就是整数相加：两个合法的单项式相加不会跨字段进位，
+ *   某个字段的和超过上限时该字段的保护位被置 1，(a + b) & guard 非零即溢出
+ * 项按单项式降序存放在连续数组里（与 Poly 的链表同一顺序），系数类型 C 可选，
+ * 默认 long long；系数会超过 64 位的场合（Fateman 乘积）用 __int128。
+ *
+ * 乘法两种：
+ * - mulHeap：Johnson 的堆方法，堆里放 A 的每一项当前对应的 B 项，每次弹出最大的单项式，
+ *            单项式相同的项在堆里串成链（Monagan–Pearce），
+ *            最坏 O(nm log min(n,m)) 次比较，结果按顺序直接产生，不需要额外排序
+ * - mulKronecker：Kronecker 代换 x_k -> x^(D_{k+1} ... D_{nvars-1})，D_k 为结果中变量 k 的次数上界 + 1，
+ *            把多元乘法变成一元乘法；一元乘积在稠密数组里累加（不比较单项式），再逆代换回来。
+ *            稠密数组长度为 ∏D_k，超过 kKroneckerLimit 时退回堆方法
+ * multiply 按稠密程度自动选择。
+ * 指数超出编码范围时抛 std::overflow_error。
+ */
+#ifndef MPOLY_HPP
+#define MPOLY_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+template <typename C = long long>
+class MPoly {
+public:
+    using Mono = std::uint64_t;
+    struct MTerm {
+        Mono m;
+        C c;
+    };
+    static constexpr std::size_t kKroneckerLimit = std::size_t(1) << 22;
+
+    explicit MPoly(int nvars = 1) : nv(nvars) {
+        if (nvars < 1 || nvars > 8) throw std::invalid_argument("MPoly: nvars must be in [1, 8]");
+        bits = 64 / nvars;
+        fieldMask = (bits == 64) ? ~Mono(0) : (Mono(1) << bits) - 1;
+        guard = 0;
+        for (int k = 0; k < nvars; ++k) guard |= Mono(1) << (shift(k) + bits - 1);
+    }
+
+    // 常数与单个变量
+    static MPoly constant(int nvars, C c) {
+        MPoly P(nvars);
+        if (c != C(0)) P.t.push_back({0, c});
+        return P;
+    }
+    static MPoly var(int nvars, int k, C c = C(1)) {
+        MPoly P(nvars);
+        int e[8] = {0};
+        e[k] = 1;
+        if (c != C(0)) P.t.push_back({P.pack(e), c});
+        return P;
+    }
+
+    int nvars() const { return nv; }
+    int maxExp() const { return bits > 32 ? INT_MAX : int((Mono(1) << (bits - 1)) - 1); }
+    std::size_t size() const { return t.size(); }
+    bool isZero() const { return t.empty(); }
+    const std::vector<MTerm>& terms() const { return t; }
+
+    // 指数向量 <-> 单项式
+    Mono pack(const int* e) const {
+        Mono m = 0;
+        for (int k = 0; k < nv; ++k) {
+            if (e[k] < 0 || e[k] > maxExp()) throw std::overflow_error("MPoly: exponent out of range");
+            m |= Mono(e[k]) << shift(k);
+        }
+        return m;
+    }
+    int exp(Mono m, int k) const { return int((m >> shift(k)) & fieldMask); }
+    // 单项式相乘是否溢出：某个字段的和超过上限时它的保护位为 1
+    // （1 个变量时指数限制在 int 范围内，直接比较）
+    bool monoOverflow(Mono a, Mono b) const { return nv == 1 ? a + b > Mono(INT_MAX) : ((a + b) & guard) != 0; }
+
+    // 追加一项（任意顺序，允许同类项），之后调用 normalize
+    void push(C c, std::initializer_list<int> e) {
+        if ((int)e.size() != nv) throw std::invalid_argument("MPoly: wrong number of exponents");
+        t.push_back({pack(e.begin()), c});
+    }
+    void push(C c, const int* e) { t.push_back({pack(e), c}); }
+    // 排序、合并同类项、去掉零系数
+    void normalize() {
+        std::sort(t.begin(), t.end(), [](const MTerm& a, const MTerm& b) { return a.m > b.m; });
+        std::size_t w = 0;
+        for (std::size_t i = 0; i < t.size();) {
+            Mono m = t[i].m;
+            C c = C(0);
+            for (; i < t.size() && t[i].m == m; ++i) c += t[i].c;
+            if (c != C(0)) t[w++] = {m, c};
+        }
+        t.resize(w);
+    }
+
+    MPoly add(const MPoly& B) const { return merge(B, false); }
+    MPoly sub(const MPoly& B) const { return merge(B, true); }
+
+    MPoly mulHeap(const MPoly& B) const {
+        checkSame(B);
+        checkDegrees(B);
+        const MPoly& S = size() <= B.size() ? *this : B;  // 堆的大小取较短的一方
+        const MPoly& L = size() <= B.size() ? B : *this;
+        MPoly R(nv);
+        if (S.isZero() || L.isZero()) return R;
+        // 堆元素是一个单项式和一条链：链上是单项式相同的若干行（S 的第 i 行当前对应 L 的第 col[i] 项）。
+        // 插入时沿上浮路径遇到相同的单项式就挂到它的链上（Monagan–Pearce 的 chaining），
+        // 稠密的乘积里一个单项式有上百个来源，堆操作次数因此大幅减少
+        struct Ent {
+            Mono m;
+            std::uint32_t head;  // 链首的行号
+        };
+        const std::uint32_t n = (std::uint32_t)S.size(), mlen = (std::uint32_t)L.size();
+        const std::uint32_t kEnd = UINT32_MAX;
+        std::vector<std::uint32_t> col(n, 0), link(n, kEnd), done;
+        std::vector<Ent> h;
+        h.reserve(n);
+        auto insert = [&](std::uint32_t i) {
+            const Mono m = S.t[i].m + L.t[col[i]].m;
+            std::size_t k = h.size();
+            while (k) {
+                std::size_t p = (k - 1) / 2;
+                if (h[p].m == m) {
+                    link[i] = h[p].head;
+                    h[p].head = i;
+                    return;
+                }
+                if (h[p].m > m) break;
+                k = p;
+            }
+            // 没有可挂的链：把路径上比 m 小的父结点依次下移
+            std::size_t pos = h.size();
+            h.push_back({0, 0});
+            while (pos > k) {
+                h[pos] = h[(pos - 1) / 2];
+                pos = (pos - 1) / 2;
+            }
+            link[i] = kEnd;
+            h[pos] = {m, i};
+        };
+        auto popTop = [&h]() {
+            Ent x = h.back();
+            h.pop_back();
+            if (h.empty()) return;
+            const std::size_t sz = h.size();
+            std::size_t k = 0;
+            for (std::size_t c; (c = 2 * k + 1) < sz; k = c) {
+                if (c + 1 < sz && h[c + 1].m > h[c].m) ++c;
+                if (h[c].m <= x.m) break;
+                h[k] = h[c];
+            }
+            h[k] = x;
+        };
+        insert(0);
+        while (!h.empty()) {
+            const Mono m = h[0].m;
+            C c = C(0);
+            done.clear();
+            // 取出单项式为 m 的所有链（插入时没能挂上的相同单项式会紧接着出现在堆顶）
+            while (!h.empty() && h[0].m == m) {
+                for (std::uint32_t i = h[0].head; i != kEnd; i = link[i]) {
+                    c += S.t[i].c * L.t[col[i]].c;
+                    done.push_back(i);
+                }
+                popTop();
+            }
+            if (c != C(0)) R.t.push_back({m, c});
+            // 第 i 行前进一项；第 i 行刚从第 0 项出发时启动第 i+1 行
+            for (std::uint32_t i : done) {
+                if (col[i] == 0 && i + 1 < n) insert(i + 1);
+                if (++col[i] < mlen) insert(i);
+            }
+        }
+        return R;
+    }
+
+    MPoly mulKronecker(const MPoly& B) const {
+        checkSame(B);
+        checkDegrees(B);
+        MPoly R(nv);
+        if (isZero() || B.isZero()) return R;
+        std::vector<std::size_t> D, w;
+        std::size_t len = kroneckerSize(B, D, w);
+        if (len == 0 || len > kKroneckerLimit) return mulHeap(B);
+        std::vector<std::size_t> ea = substitute(w), eb = B.substitute(w);
+        std::vector<C> acc(len, C(0));
+        for (std::size_t i = 0; i < t.size(); ++i) {
+            const C ci = t[i].c;
+            C* row = acc.data() + ea[i];
+            for (std::size_t j = 0; j < B.t.size(); ++j) row[eb[j]] += ci * B.t[j].c;
+        }
+        // 逆代换：一元指数按 w 逐位拆开。单项式降序即一元指数降序
+        for (std::size_t e = len; e-- > 0;) {
+            if (acc[e] == C(0)) continue;
+            Mono m = 0;
+            std::size_t r = e;
+            for (int k = 0; k < nv; ++k) {
+                m |= Mono(r / w[k]) << shift(k);
+                r %= w[k];
+            }
+            R.t.push_back({m, acc[e]});
+        }
+        return R;
+    }
+
+    // 稠密数组放得下且填充率不太低时用 Kronecker，否则用堆
+    MPoly multiply(const MPoly& B) const {
+        checkSame(B);
+        if (isZero() || B.isZero()) return MPoly(nv);
+        std::vector<std::size_t> D, w;
+        checkDegrees(B);
+        std::size_t len = kroneckerSize(B, D, w);
+        double pairs = double(size()) * double(B.size());
+        if (len != 0 && len <= kKroneckerLimit && double(len) <= 8 * pairs) return mulKronecker(B);
+        return mulHeap(B);
+    }
+
+    MPoly pow(unsigned k) const {
+        MPoly R = constant(nv, C(1)), X = *this;
+        for (; k; k >>= 1) {
+            if (k & 1) R = R.multiply(X);
+            if (k > 1) X = X.multiply(X);
+        }
+        return R;
+    }
+
+    // 对变量 k 求偏导。各项都减去同一个单位单项式，且参与的字段都 >= 1 不会借位，顺序不变
+    MPoly derivative(int k) const {
+        if (k < 0 || k >= nv) throw std::invalid_argument("MPoly: variable index out of range");
+        MPoly R(nv);
+        const Mono unit = Mono(1) << shift(k);
+        for (const MTerm& x : t) {
+            int e = exp(x.m, k);
+            if (e) R.t.push_back({x.m - unit, x.c * C(e)});
+        }
+        return R;
+    }
+
+    // 在点 pt[0..nvars) 求值，T 可以是 double、long long 或自定义的模数类型；
+    // 各变量的幂先按本多项式中的最高次数打表
+    template <typename T>
+    T eval(const T* pt) const {
+        std::vector<std::vector<T>> pw(nv);
+        for (int k = 0; k < nv; ++k) {
+            int d = 0;
+            for (const MTerm& x : t) d = std::max(d, exp(x.m, k));
+            pw[k].assign(d + 1, T(1));
+            for (int i = 1; i <= d; ++i) pw[k][i] = pw[k][i - 1] * pt[k];
+        }
+        T s = T(0);
+        for (const MTerm& x : t) {
+            T v = T(x.c);
+            for (int k = 0; k < nv; ++k) v = v * pw[k][exp(x.m, k)];
+            s = s + v;
+        }
+        return s;
+    }
+
+    // 代数形式，变量名取 names 的前 nvars 个字符（默认 x y z t u v w s）
+    std::string toString(const char* names = "xyztuvws") const {
+        if (t.empty()) return "0";
+        std::string s;
+        for (std::size_t i = 0; i < t.size(); ++i) {
+            C c = t[i].c;
+            bool neg = c < C(0);
+            if (neg) c = C(0) - c;
+            if (i) s += neg ? " - " : " + ";
+            else if (neg) s += "-";
+            bool isConst = t[i].m == 0;
+            if (c != C(1) || isConst) s += itos(c);
+            bool first = c == C(1) && !isConst;
+            for (int k = 0; k < nv; ++k) {
+                int e = exp(t[i].m, k);
+                if (!e) continue;
+                if (!first) s += "*";
+                first = false;
+                s += names[k];
+                if (e > 1) s += "^" + std::to_string(e);
+            }
+        }
+        return s;
+    }
+
+    bool operator==(const MPoly& B) const {
+        if (nv != B.nv || t.size() != B.t.size()) return false;
+        for (std::size_t i = 0; i < t.size(); ++i)
+            if (t[i].m != B.t[i].m || t[i].c != B.t[i].c) return false;
+        return true;
+    }
+    bool operator!=(const MPoly& B) const { return !(*this == B); }
+
+private:
+    int nv, bits;
+    Mono fieldMask, guard;
+    std::vector<MTerm> t;
+
+    int shift(int k) const { return (nv - 1 - k) * bits; }
+
+    void checkSame(const MPoly& B) const {
+        if (nv != B.nv) throw std::invalid_argument("MPoly: different number of variables");
+    }
+
+    // 每个变量的最高次数
+    std::vector<int> degrees() const {
+        std::vector<int> d(nv, 0);
+        for (const MTerm& x : t)
+            for (int k = 0; k < nv; ++k) d[k] = std::max(d[k], exp(x.m, k));
+        return d;
+    }
+
+    // 两边各变量最高次数打包后相加，保护位没被置 1 则任意两项相乘都不会溢出，之后单项式直接整数相加
+    void checkDegrees(const MPoly& B) const {
+        std::vector<int> da = degrees(), db = B.degrees();
+        if (!B.isZero() && !isZero() && monoOverflow(pack(da.data()), pack(db.data())))
+            throw std::overflow_error("MPoly: product exponent out of range");
+    }
+
+    // D[k] = 乘积中变量 k 的次数上界 + 1，w[k] = D[k+1] * ... * D[nv-1]；返回 ∏D，超过上限返回 0
+    std::size_t kroneckerSize(const MPoly& B, std::vector<std::size_t>& D, std::vector<std::size_t>& w) const {
+        std::vector<int> da = degrees(), db = B.degrees();
+        D.assign(nv, 0);
+        w.assign(nv, 1);
+        std::size_t len = 1;
+        for (int k = nv; k-- > 0;) {
+            D[k] = std::size_t(da[k] + db[k] + 1);
+            w[k] = len;
+            if (len > kKroneckerLimit / D[k]) return 0;
+            len *= D[k];
+        }
+        return len;
+    }
+
+    std::vector<std::size_t> substitute(const std::vector<std::size_t>& w) const {
+        std::vector<std::size_t> e(t.size());
+        for (std::size_t i = 0; i < t.size(); ++i) {
+            std::size_t v = 0;
+            for (int k = 0; k < nv; ++k) v += std::size_t(exp(t[i].m, k)) * w[k];
+            e[i] = v;
+        }
+        return e;
+    }
+
+    MPoly merge(const MPoly& B, bool negate) const {
+        checkSame(B);
+        MPoly R(nv);
+        R.t.reserve(t.size() + B.t.size());
+        std::size_t i = 0, j = 0;
+        while (i < t.size() || j < B.t.size()) {
+            if (j == B.t.size() || (i < t.size() && t[i].m > B.t[j].m)) {
+                R.t.push_back(t[i++]);
+            } else if (i == t.size() || B.t[j].m > t[i].m) {
+                R.t.push_back({B.t[j].m, negate ? C(0) - B.t[j].c : B.t[j].c});
+                ++j;
+            } else {
+                C c = negate ? t[i].c - B.t[j].c : t[i].c + B.t[j].c;
+                if (c != C(0)) R.t.push_back({t[i].m, c});
+                ++i;
+                ++j;
+            }
+        }
+        return R;
+    }
+
+    // 非负整数转十进制（支持 __int128）
+    static std::string itos(C v) {
+        if (v == C(0)) return "0";
+        std::string s;
+        while (v != C(0)) {
+            s += char('0' + int(v % C(10)));
+            v = v / C(10);
+        }
+        std::reverse(s.begin(), s.end());
+        return s;
+    }
+};
+
+#endif  // MPOLY_HPP
@@ -0,0 +1,145 @@
+/*
+ * mpoly.hpp 的正确性检查与测速
+ * - 正确性：3..8 元随机稀疏多项式，mulHeap、mulKronecker 与逐对相乘再 normalize 的朴素结果逐项比对；
+ *   (A + B) - B == A；偏导满足乘积法则；模素数求值满足 eval(AB) = eval(A) eval(B)
+ * - Fateman：f = (1 + x + y + z + t)^p，g = f + 1，求 f*g（p = 20 时各 10626 项，乘积 135751 项，
+ *   系数超过 64 位，用 __int128），堆方法与 Kronecker 代换对比
+ * - Monagan–Pearce 稀疏测试：f = (1 + x + y + 2z^2 + 3t^3 + 5u^5)^q，
+ *   g = (1 + u + t + 2z^2 + 3y^3 + 5x^5)^q（q = 12 时各 6188 项，乘积 5821335 项），
+ *   Kronecker 的稠密数组太大，只跑堆方法
+ *
+ * 编译: g++ -std=c++17 -O2 mpoly_bench.cpp -o mpoly_bench
+ * 用法: mpoly_bench [Fateman 的 p，默认 20] [稀疏测试的 q，默认 12]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "../../include/bench_util.h"
+#include "mpoly.hpp"
+
+using i128 = __int128;
+
+// 模素数的值，用来在随机点上检查恒等式
+struct ModP {
+    static constexpr unsigned long long P = 1000000007ULL;
+    unsigned long long v;
+    ModP(i128 x = 0) : v((unsigned long long)((x % (i128)P + (i128)P) % (i128)P)) {}
+    ModP operator+(ModP o) const { ModP r; r.v = (v + o.v) % P; return r; }
+    ModP operator*(ModP o) const { ModP r; r.v = v * o.v % P; return r; }
+    bool operator==(ModP o) const { return v == o.v; }
+};
+
+template <typename C>
+static MPoly<C> randomPoly(int nv, int terms, int maxdeg, std::mt19937_64& rng) {
+    MPoly<C> P(nv);
+    int e[8];
+    for (int i = 0; i < terms; ++i) {
+        for (int k = 0; k < nv; ++k) e[k] = int(rng() % (maxdeg + 1));
+        P.push(C(int(rng() % 19) - 9), e);
+    }
+    P.normalize();
+    return P;
+}
+
+template <typename C>
+static MPoly<C> naiveMul(const MPoly<C>& A, const MPoly<C>& B) {
+    MPoly<C> R(A.nvars());
+    int e[8];
+    for (auto& a : A.terms())
+        for (auto& b : B.terms()) {
+            for (int k = 0; k < A.nvars(); ++k) e[k] = A.exp(a.m, k) + B.exp(b.m, k);
+            R.push(a.c * b.c, e);
+        }
+    R.normalize();
+    return R;
+}
+
+static int correctness() {
+    std::mt19937_64 rng(7);
+    int fails = 0;
+    for (int nv = 3; nv <= 8; ++nv) {
+        for (int round = 0; round < 20; ++round) {
+            int maxdeg = round % 2 ? 3 : 12;
+            auto A = randomPoly<long long>(nv, 1 + int(rng() % 60), maxdeg, rng);
+            auto B = randomPoly<long long>(nv, 1 + int(rng() % 60), maxdeg, rng);
+            auto N = naiveMul(A, B);
+            if (A.mulHeap(B) != N || A.mulKronecker(B) != N || A.multiply(B) != N) {
+                std::printf("FAIL multiply nv=%d round=%d\n", nv, round);
+                ++fails;
+            }
+            if (A.add(B).sub(B) != A || A.sub(A).size() != 0) {
+                std::printf("FAIL add/sub nv=%d round=%d\n", nv, round);
+                ++fails;
+            }
+            for (int k = 0; k < nv; ++k) {
+                auto lhs = N.derivative(k), rhs = A.derivative(k).multiply(B).add(A.multiply(B.derivative(k)));
+                if (lhs != rhs) {
+                    std::printf("FAIL derivative nv=%d var=%d\n", nv, k);
+                    ++fails;
+                }
+            }
+            ModP pt[8];
+            for (int k = 0; k < nv; ++k) pt[k] = ModP((long long)(rng() % ModP::P));
+            if (!(N.eval(pt) == A.eval(pt) * B.eval(pt))) {
+                std::printf("FAIL eval nv=%d round=%d\n", nv, round);
+                ++fails;
+            }
+        }
+    }
+    // 指数溢出：8 元时上限 127
+    try {
+        auto X = MPoly<long long>::var(8, 0).pow(100);
+        X.multiply(X);
+        std::printf("FAIL overflow not detected\n");
+        ++fails;
+    } catch (const std::overflow_error&) {
+    }
+    auto small = MPoly<long long>::constant(3, 1).add(MPoly<long long>::var(3, 0)).sub(MPoly<long long>::var(3, 2, 2));
+    std::printf("example: (%s)^2 = %s\n", small.toString().c_str(), small.multiply(small).toString().c_str());
+    std::printf("correctness: %s\n", fails ? "FAILED" : "ok");
+    return fails;
+}
+
+template <typename Fn>
+static MPoly<i128> timed(const char* name, Fn fn) {
+    double t = now_ms();
+    MPoly<i128> R = fn();
+    std::printf("  %-14s %10.1f ms  %zu terms\n", name, now_ms() - t, R.size());
+    return R;
+}
+
+int main(int argc, char** argv) {
+    unsigned p = argc > 1 ? (unsigned)std::atoi(argv[1]) : 20;
+    unsigned q = argc > 2 ? (unsigned)std::atoi(argv[2]) : 12;
+    if (correctness()) return 1;
+
+    using MP = MPoly<i128>;
+    {
+        MP base = MP::constant(4, 1);
+        for (int k = 0; k < 4; ++k) base = base.add(MP::var(4, k));
+        double t = now_ms();
+        MP f = base.pow(p), g = f.add(MP::constant(4, 1));
+        std::printf("\nFateman p = %u: f, g have %zu terms (built in %.1f ms)\n", p, f.size(), now_ms() - t);
+        MP h1 = timed("heap", [&] { return f.mulHeap(g); });
+        MP h2 = timed("kronecker", [&] { return f.mulKronecker(g); });
+        std::printf("  results %s\n", h1 == h2 ? "match" : "MISMATCH");
+    }
+    {
+        auto mono = [](i128 c, int k, int e) {
+            int ex[5] = {0};
+            ex[k] = e;
+            MP P(5);
+            P.push(c, ex);
+            return P;
+        };
+        // 变量顺序 x y z t u
+        MP f0 = MP::constant(5, 1).add(mono(1, 0, 1)).add(mono(1, 1, 1)).add(mono(2, 2, 2)).add(mono(3, 3, 3)).add(mono(5, 4, 5));
+        MP g0 = MP::constant(5, 1).add(mono(1, 4, 1)).add(mono(1, 3, 1)).add(mono(2, 2, 2)).add(mono(3, 1, 3)).add(mono(5, 0, 5));
+        MP f = f0.pow(q), g = g0.pow(q);
+        std::printf("\nsparse q = %u: f, g have %zu, %zu terms\n", q, f.size(), g.size());
+        MP h = timed("heap", [&] { return f.multiply(g); });
+        ModP pt[5] = {ModP(3LL), ModP(5LL), ModP(7LL), ModP(11LL), ModP(13LL)};
+        std::printf("  eval check %s\n", h.eval(pt) == f.eval(pt) * g.eval(pt) ? "ok" : "MISMATCH");
+    }
+    return 0;
+}
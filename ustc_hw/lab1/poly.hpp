@@ -0,0 +1,540 @@
+/*
+ * 一元稀疏多项式（polycalculator.cpp 的 Poly），header-only
+ *
+ * 项按指数降序存放在带头结点的单链表里。链表（连同头结点）放在引用计数的 Rep 中，
+ * 多个 Poly 可以共享同一个 Rep，写时复制：
+ * - 拷贝构造/拷贝赋值只加引用计数，O(1)，不分配
+ * - 移动构造/移动赋值只交换指针，不分配；被移走的对象 rep 为空，表示零多项式
+ * - insertTerm、buildFromTerms 等修改操作先检查 Rep 是否独占，共享时线性复制一份再改
+ *   （原表已经有序，直接顺次接到表尾，不再逐项 insertTerm）；clear 直接放弃共享的 Rep
+ * 共享后的结点不再被修改。引用计数不是原子的，Poly 不能跨线程共享。
+ *
+ * 乘法类运算（multiply、mulTrunc、pow、compose）先把链表展开成稠密的系数数组，在 polyk 的
+ * 核心上计算再接回链表。系数按 unsigned long long 运算，结果与逐项相乘累加（long long 回绕）一致：
+ * - 足够稠密时用 Karatsuba（32 项以下退回教科书乘法），O(n^1.58)
+ * - 很稀疏时（按代价估计，整段展开不划算）把两边按零的间隔切成稠密段，段与段用上面的核心相乘，
+ *   各块乘积用堆按指数降序合并；只有一项的段两两相乘即逐项相乘的堆合并，O(nm log n)，内存 O(n)
+ * - mulTrunc 是递归的短乘积：只算指数 < N 的系数，从不算出更高的项
+ * - pow：二进制快速幂；项数很少、次数很高且确定不会溢出时用 J.C.P. Miller 递推，O(t * 结果次数)
+ * - compose：分治，P(Q) = P_lo(Q) + Q^h P_hi(Q)，Q 的 2 的幂次预先算好
+ */
+#ifndef POLY_HPP
+#define POLY_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../include/fastio.h"
+
+// 手写项结构体
+struct Term {
+    long long c;
+    int e;
+};
+
+struct Node {
+    long long c;  // 系数
+    int e;        // 指数
+    Node* next;
+    Node(long long c_, int e_, Node* nx=nullptr): c(c_), e(e_), next(nx) {}
+};
+
+// 稠密系数数组上的乘法核心，系数按 2^64 取模（与 long long 回绕相同）
+namespace polyk {
+typedef unsigned long long u64;
+const std::size_t kSchoolMax = 32;
+const long long kRunGap = 16;  // 分段乘法中段内允许的最长连续零
+const double kDenseSpan = 64;  // pow、compose 只在 指数跨度 <= kDenseSpan * 项数^2 时展开成稠密数组
+
+// r[0..n+m-1) += a * b
+inline void mulSchool(const u64* a, std::size_t n, const u64* b, std::size_t m, u64* r) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const u64 ai = a[i];
+        if (!ai) continue;
+        for (std::size_t j = 0; j < m; ++j) r[i + j] += ai * b[j];
+    }
+}
+
+// r[0..2n-1) = a * b，a、b 各 n 项；scratch 至少 8n
+inline void karatsuba(const u64* a, const u64* b, std::size_t n, u64* r, u64* scratch) {
+    if (n <= kSchoolMax) {
+        std::fill(r, r + 2 * n - 1, 0ULL);
+        mulSchool(a, n, b, n, r);
+        return;
+    }
+    const std::size_t h = n / 2, k = n - h;  // 低 h 项，高 k 项（k >= h）
+    karatsuba(a, b, h, r, scratch);                      // z0 -> r[0, 2h-1)
+    r[2 * h - 1] = 0;
+    karatsuba(a + h, b + h, k, r + 2 * h, scratch);      // z2 -> r[2h, 2n-1)
+    u64 *sa = scratch, *sb = scratch + k, *z1 = scratch + 2 * k, *rest = z1 + 2 * k;
+    for (std::size_t i = 0; i < k; ++i) {
+        sa[i] = a[h + i] + (i < h ? a[i] : 0);
+        sb[i] = b[h + i] + (i < h ? b[i] : 0);
+    }
+    karatsuba(sa, sb, k, z1, rest);                      // (a_lo + a_hi)(b_lo + b_hi)
+    for (std::size_t i = 0; i < 2 * h - 1; ++i) z1[i] -= r[i];
+    for (std::size_t i = 0; i < 2 * k - 1; ++i) z1[i] -= r[2 * h + i];
+    for (std::size_t i = 0; i < 2 * k - 1; ++i) r[h + i] += z1[i];
+}
+
+// r[0..n+m-1) = a * b，长短不一时把长的一方按短的长度分块
+inline void mulDense(const u64* a, std::size_t n, const u64* b, std::size_t m, u64* r) {
+    if (n < m) { std::swap(a, b); std::swap(n, m); }
+    std::fill(r, r + n + m - 1, 0ULL);
+    if (m <= kSchoolMax) { mulSchool(a, n, b, m, r); return; }
+    std::vector<u64> scratch(8 * m + 64), tmp(2 * m - 1), pad;
+    for (std::size_t off = 0; off < n; off += m) {
+        std::size_t len = std::min(m, n - off);
+        const u64* blk = a + off;
+        if (len < m) { pad.assign(m, 0ULL); std::copy(blk, blk + len, pad.begin()); blk = pad.data(); }
+        karatsuba(blk, b, m, tmp.data(), scratch.data());
+        std::size_t lim = std::min(2 * m - 1, n + m - 1 - off);
+        for (std::size_t i = 0; i < lim; ++i) r[off + i] += tmp[i];
+    }
+}
+
+// r[0..L) += (a * b) 的低 L 项（短乘积）：a = a_lo + x^h a_hi，b 同理，
+// a_hi * b_hi 的次数 >= 2h >= L 整个不算，a_lo * b_lo 的次数 < L 用完整乘法，交叉项递归
+inline void mulLow(const u64* a, std::size_t n, const u64* b, std::size_t m, std::size_t L, u64* r) {
+    n = std::min(n, L);
+    m = std::min(m, L);
+    if (!n || !m || !L) return;
+    if (std::min(n, m) <= kSchoolMax || L <= 2 * kSchoolMax) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const u64 ai = a[i];
+            if (!ai) continue;
+            for (std::size_t j = 0, lim = std::min(m, L - i); j < lim; ++j) r[i + j] += ai * b[j];
+        }
+        return;
+    }
+    const std::size_t h = (L + 1) / 2;
+    const std::size_t nl = std::min(n, h), ml = std::min(m, h);
+    std::vector<u64> full(nl + ml - 1);
+    mulDense(a, nl, b, ml, full.data());
+    for (std::size_t i = 0; i < full.size() && i < L; ++i) r[i] += full[i];
+    if (n > h) mulLow(a + h, n - h, b, ml, L - h, r + h);
+    if (m > h) mulLow(a, nl, b + h, m - h, L - h, r + h);
+}
+}  // namespace polyk
+
+class Poly {
+public:
+    Poly() : rep(nullptr) {}
+    Poly(const Poly& other) : rep(other.rep) { if (rep) ++rep->refs; }
+    Poly& operator=(const Poly& other){
+        if (rep != other.rep) { release(); rep = other.rep; if (rep) ++rep->refs; }
+        return *this;
+    }
+    Poly(Poly&& other) noexcept : rep(other.rep) { other.rep = nullptr; }
+    Poly& operator=(Poly&& other) noexcept {
+        if (this != &other) { release(); rep = other.rep; other.rep = nullptr; }
+        return *this;
+    }
+    ~Poly(){ release(); }
+
+    void insertTerm(long long c, int e) {
+        if (c == 0) return;
+        Node* prev = writableHead(); Node* cur = prev->next;
+        while (cur && cur->e > e) { prev = cur; cur = cur->next; }
+        if (cur && cur->e == e) {
+            cur->c += c;
+            if (cur->c == 0) { prev->next = cur->next; delete cur; }
+        } else {
+            prev->next = new Node(c, e, cur);
+        }
+    }
+    // 用手写数组构建。空多项式时先按指数降序排序再顺次接到表尾，O(n log n)；
+    // 否则逐项 insertTerm
+    void buildFromTerms(const Term* terms, int n){
+        if (front()) { for (int i = 0; i < n; ++i) insertTerm(terms[i].c, terms[i].e); return; }
+        Term* t = new Term[n];
+        std::copy(terms, terms + n, t);
+        std::stable_sort(t, t + n, [](const Term& a, const Term& b){ return a.e > b.e; });
+        Node* r = writableHead();
+        for (int i = 0; i < n; ) {
+            long long c = 0; int e = t[i].e;
+            while (i < n && t[i].e == e) c += t[i++].c;
+            if (c) { r->next = new Node(c, e); r = r->next; }
+        }
+        delete[] t;
+    }
+
+    Poly add(const Poly& B) const {
+        Poly R; Node *p=front(), *q=B.front(), *r=R.writableHead();
+        while (p||q){
+            if (q==nullptr || (p&&p->e>q->e)) { r->next=new Node(p->c,p->e); r=r->next; p=p->next; }
+            else if (p==nullptr || (q&&q->e>p->e)) { r->next=new Node(q->c,q->e); r=r->next; q=q->next; }
+            else { long long c=p->c+q->c; if(c) { r->next=new Node(c,p->e); r=r->next; } p=p->next; q=q->next; }
+        }
+        return R;
+    }
+    Poly sub(const Poly& B) const {
+        Poly R; Node *p=front(), *q=B.front(), *r=R.writableHead();
+        while (p||q){
+            if (q==nullptr || (p&&p->e>q->e)) { r->next=new Node(p->c,p->e); r=r->next; p=p->next; }
+            else if (p==nullptr || (q&&q->e>p->e)) { r->next=new Node(-q->c,q->e); r=r->next; q=q->next; }
+            else { long long c=p->c-q->c; if(c){ r->next=new Node(c,p->e); r=r->next; } p=p->next; q=q->next; }
+        }
+        return R;
+    }
+    Poly multiply(const Poly& B) const { return mulTrunc(B, INT_MAX, false); }
+
+    // 乘积中指数 < N 的部分（mod x^N），高于截断次数的项一概不算
+    Poly mulTrunc(const Poly& B, int N) const { return mulTrunc(B, N, true); }
+
+    // P^k；k = 0 时为 1
+    Poly pow(unsigned k) const {
+        Poly R; R.insertTerm(1, 0);
+        if (k == 0) return R;
+        if (!front()) return Poly();
+        long long hi = front()->e, lo = lowest();
+        checkExp(lo * (long long)k, hi * (long long)k);
+        std::size_t t = 0; unsigned long long l1 = 0;  // 非零项数与系数绝对值之和
+        bool small = true;
+        long long c0 = 0;                              // 最低次项的系数
+        for (Node* p = front(); p; p = p->next) {
+            if (!p->c) continue;
+            ++t; c0 = p->c;
+            unsigned long long a = p->c < 0 ? 0ULL - (unsigned long long)p->c : (unsigned long long)p->c;
+            if (a > (1ULL << 62) - l1) small = false; else l1 += a;
+        }
+        // 结果次数（相对 x^lo）D = k * deg；Miller 为 O(t D)，Karatsuba 幂的最后一步约 D^1.58。
+        // 只在 (sum|p_i|)^k < 2^62 时用 Miller：中间量用 __int128 累加，整除不会因回绕出错。
+        // Miller 要展开成稠密数组，跨度相对项数太大时（如 x^400000000 + 1）改走下面的快速幂，
+        // multiply 会按分段处理稀疏的输入
+        double span = double(hi - lo + 1), D = (span - 1) * k;
+        if (small && c0 != 0 && t >= 2 && double(t) * double(t) <= D && k * std::log2(double(l1)) < 62 &&
+            span <= polyk::kDenseSpan * double(t) * double(t)) {
+            Dense P = toDense();
+            return fromDense(P.off * (long long)k, millerPow(P.c, k));
+        }
+        Poly X = *this;
+        bool first = true;
+        for (;;) {
+            if (k & 1) { R = first ? X : R.multiply(X); first = false; }
+            k >>= 1;
+            if (!k) break;
+            X = X.multiply(X);
+        }
+        return R;
+    }
+
+    // P(Q(x))。P 不能有负指数（Q^-1 不是多项式）
+    Poly compose(const Poly& Q) const {
+        if (!front()) return Poly();
+        if (lowest() < 0) throw std::invalid_argument("Poly::compose: negative exponent in P");
+        // 稀疏的 P（次数远大于项数的平方）不展开：按指数降序 Horner，R = R * Q^(e_prev - e) + c
+        std::size_t t = 0;
+        for (Node* p = front(); p; p = p->next) ++t;
+        if (double(front()->e) + 1 > polyk::kDenseSpan * double(t) * double(t)) {
+            Poly R;
+            long long prev = -1;
+            for (Node* p = front(); p; p = p->next) {
+                if (prev >= 0) R = R.multiply(Q.pow(unsigned(prev - p->e)));
+                R.insertTerm(p->c, 0);
+                prev = p->e;
+            }
+            return prev > 0 ? R.multiply(Q.pow(unsigned(prev))) : R;
+        }
+        Dense P = toDense();
+        // 把 x^off 并进系数数组：p[i] 是 x^i 的系数
+        std::vector<polyk::u64> p(P.off + P.c.size(), 0ULL);
+        std::copy(P.c.begin(), P.c.end(), p.begin() + P.off);
+        if (!Q.front()) { Poly R; R.insertTerm((long long)p[0], 0); return R; }
+        std::size_t n = 1; int levels = 0;
+        while (n < p.size()) { n *= 2; ++levels; }
+        p.resize(n, 0ULL);
+        std::vector<Poly> qp(levels > 0 ? levels : 1);  // qp[j] = Q^(2^j)
+        qp[0] = Q;
+        for (int j = 1; j < levels; ++j) qp[j] = qp[j - 1].multiply(qp[j - 1]);
+        return composeRange(p, 0, n, levels, qp);
+    }
+    // 求导不改变项的相对次序，直接接到表尾
+    Poly derivative() const {
+        Poly R; Node* r = R.writableHead();
+        for (Node* p = front(); p; p = p->next) {
+            if (p->e != 0) { r->next = new Node(p->c * p->e, p->e - 1); r = r->next; }
+        }
+        return R;
+    }
+
+    double eval(double x) const {
+        double s = 0.0;
+        for (Node* p=front(); p; p=p->next) {
+            s += static_cast<double>(p->c) * std::pow(x, p->e);
+        }
+        return s;
+    }
+
+    std::string toAlgebra() const {
+        Node* p = front();
+        if (!p) return "0";
+        std::ostringstream ss;
+        bool first = true;
+        while (p){
+            long long c = p->c;
+            int e = p->e;
+            if (c == 0) { p=p->next; continue; }
+            if (first) {
+                if (c < 0) ss << "-";
+            } else {
+                ss << (c >= 0 ? "+" : "-");
+            }
+            long long absc = llabs(c);
+            if (e == 0) {
+                ss << absc;
+            } else if (e == 1) {
+                if (absc != 1) ss << absc;
+                ss << "x";
+            } else {
+                if (absc != 1) ss << absc;
+                ss << "x^" << e;
+            }
+            first = false;
+            p = p->next;
+        }
+        return ss.str();
+    }
+
+    void printPairs(std::ostream& os=std::cout) const {
+        Node* p=front(); if(!p){ os<<"0 0\n"; return; }
+        bool first=true;
+        while(p){ if(!first) os<<' '; os<<p->c<<' '<<p->e; first=false; p=p->next; }
+        os<<'\n';
+    }
+    void printAlgebra(std::ostream& os=std::cout) const { os << toAlgebra() << '\n'; }
+    // 与 printPairs 格式相同，写到 FioWriter
+    void writePairs(FioWriter* w) const {
+        Node* p=front(); if(!p){ fio_put_str(w, "0 0\n"); return; }
+        bool first=true;
+        while(p){ if(!first) fio_put_char(w, ' '); fio_put_i64(w, p->c); fio_put_char(w, ' '); fio_put_i64(w, p->e); first=false; p=p->next; }
+        fio_put_char(w, '\n');
+    }
+    void writeAlgebra(FioWriter* w) const { fio_put_str(w, toAlgebra().c_str()); fio_put_char(w, '\n'); }
+
+    // 共享时只放弃自己的引用，不动别人的结点
+    void clear(){ release(); }
+
+    // 第一项（指数最高），零多项式为 nullptr
+    const Node* firstTerm() const { return front(); }
+    bool shares(const Poly& other) const { return rep && rep == other.rep; }
+
+private:
+    // 头结点与引用计数放在一起，一次分配
+    struct Rep {
+        Node head{0, INT_MAX};
+        std::size_t refs = 1;
+    };
+    Rep* rep;
+
+    Node* front() const { return rep ? rep->head.next : nullptr; }
+
+    // 取可写的头结点：没有 Rep 时新建，共享时线性复制一份
+    Node* writableHead() {
+        if (!rep) { rep = new Rep; return &rep->head; }
+        if (rep->refs > 1) {
+            Rep* own = new Rep;
+            Node* r = &own->head;
+            for (Node* p = rep->head.next; p; p = p->next) { r->next = new Node(p->c, p->e); r = r->next; }
+            --rep->refs;
+            rep = own;
+        }
+        return &rep->head;
+    }
+
+    // 稠密形式：系数 c[i] 对应指数 off + i
+    struct Dense {
+        long long off = 0;
+        std::vector<polyk::u64> c;
+    };
+    // 只取指数 <= maxE 的项（截断乘法用，高出的部分不展开）
+    Dense toDense(long long maxE = LLONG_MAX) const {
+        Dense d;
+        Node* first = frontUpTo(maxE);
+        if (!first) return d;
+        int hi = first->e, lo = hi;
+        for (Node* p = first; p; p = p->next) lo = p->e;
+        d.off = lo;
+        d.c.assign(std::size_t((long long)hi - lo + 1), 0ULL);
+        for (Node* p = first; p; p = p->next) d.c[std::size_t(p->e - lo)] = (polyk::u64)p->c;
+        return d;
+    }
+    // 第一个指数 <= maxE 的结点
+    Node* frontUpTo(long long maxE) const {
+        Node* p = front();
+        while (p && p->e > maxE) p = p->next;
+        return p;
+    }
+    static Poly fromDense(long long off, const std::vector<polyk::u64>& c) {
+        Poly R; Node* r = R.writableHead();
+        for (std::size_t i = c.size(); i-- > 0;)
+            if (c[i]) { r->next = new Node((long long)c[i], int(off + (long long)i)); r = r->next; }
+        return R;
+    }
+    static void checkExp(long long lo, long long hi) {
+        if (lo < INT_MIN || hi > INT_MAX) throw std::overflow_error("Poly: exponent out of int range");
+    }
+    long long lowest() const { long long lo = 0; for (Node* p = front(); p; p = p->next) lo = p->e; return lo; }
+
+    // 按降序切成稠密段：相邻两项之间的零超过 kRunGap 个就断开；每段 c[i] 对应指数 off + i
+    std::vector<Dense> toRuns(long long maxE = LLONG_MAX) const {
+        std::vector<Dense> runs;
+        for (Node* p = frontUpTo(maxE); p;) {
+            Node* last = p;
+            while (last->next && (long long)last->e - last->next->e <= polyk::kRunGap + 1) last = last->next;
+            Dense d;
+            d.off = last->e;
+            d.c.assign(std::size_t((long long)p->e - last->e + 1), 0ULL);
+            for (Node* t = p;; t = t->next) { d.c[std::size_t(t->e - last->e)] = (polyk::u64)t->c; if (t == last) break; }
+            runs.push_back(std::move(d));
+            p = last->next;
+        }
+        return runs;
+    }
+    // toRuns 各段长度之和，不分配
+    std::size_t runLength(long long maxE = LLONG_MAX) const {
+        Node* p = frontUpTo(maxE);
+        if (!p) return 0;
+        std::size_t s = 1;
+        for (; p->next; p = p->next) { long long d = (long long)p->e - p->next->e; s += d <= polyk::kRunGap + 1 ? std::size_t(d) : 1; }
+        return s;
+    }
+
+    // 乘积中指数 < N 的部分；truncate 为 false 时 N 不起作用
+    Poly mulTrunc(const Poly& B, int N, bool truncate) const {
+        Node* pa = front(); Node* pb = B.front();
+        if (!pa || !pb) return Poly();
+        long long topA = pa->e, topB = pb->e, lowA = lowest(), lowB = B.lowest();
+        long long off = lowA + lowB;
+        long long top = truncate ? std::min<long long>(topA + topB, (long long)N - 1) : topA + topB;
+        if (top < off) return Poly();
+        checkExp(off, top);
+        std::size_t L = std::size_t(top - off + 1);  // 结果的稠密长度
+        // 乘积指数 <= top，所以 A 只用到指数 <= top - lowB 的项，B 同理；更高的项不展开、不切段
+        long long maxA = top - lowB, maxB = top - lowA;
+        // 代价估计：整段稠密是 Karatsuba，约 长 * 短^0.585；分段是各段两两相乘，约 两边段长之和的乘积
+        double spanA = double(std::min(topA, maxA) - lowA + 1), spanB = double(std::min(topB, maxB) - lowB + 1);
+        double denseCost = std::max(spanA, spanB) * std::pow(std::min(spanA, spanB), 0.585);
+        if (denseCost <= 4.0 * double(runLength(maxA)) * double(B.runLength(maxB))) {
+            Dense a = toDense(maxA), b = B.toDense(maxB);
+            std::vector<polyk::u64> r(L, 0ULL);
+            if (truncate && L < a.c.size() + b.c.size() - 1) polyk::mulLow(a.c.data(), a.c.size(), b.c.data(), b.c.size(), L, r.data());
+            else polyk::mulDense(a.c.data(), a.c.size(), b.c.data(), b.c.size(), r.data());
+            return fromDense(off, r);
+        }
+        return mulRuns(toRuns(maxA), B.toRuns(maxB), top);
+    }
+
+    // 分段乘法：段 A_i * B_j 用稠密核心算出一块，各块按指数降序用堆合并。
+    // 每个 A_i 在堆里只挂一个待算的块（B 的段降序，下一块的最高次不会更高），
+    // 块在堆顶轮到它的最高次时才算出来、用完即回收，内存只与同时重叠的块有关
+    static Poly mulRuns(const std::vector<Dense>& A, const std::vector<Dense>& B, long long top) {
+        using polyk::u64;
+        struct Item {
+            long long e;          // 待算块：最高次；已算块：下一个要输出的指数
+            std::size_t i, j;     // 块 A_i * B_j
+            std::size_t slot;     // 已算块在 pool 中的位置，待算块为 npos
+        };
+        const std::size_t npos = std::size_t(-1);
+        auto hi = [](const Dense& d) { return d.off + (long long)d.c.size() - 1; };
+        auto cmp = [](const Item& x, const Item& y) { return x.e < y.e; };
+        std::priority_queue<Item, std::vector<Item>, decltype(cmp)> heap(cmp);
+        auto pending = [&](std::size_t i, std::size_t j) {
+            if (j < B.size()) heap.push({std::min(hi(A[i]) + hi(B[j]), top), i, j, npos});
+        };
+        for (std::size_t i = 0; i < A.size(); ++i) {
+            // 跳过整块都高于 top 的段（最低次 A_i.off + B_j.off 随 j 递减）
+            std::size_t j = std::size_t(std::partition_point(B.begin(), B.end(), [&](const Dense& d) { return A[i].off + d.off > top; }) - B.begin());
+            pending(i, j);
+        }
+        std::vector<std::vector<u64> > pool;
+        std::vector<long long> poolLo;
+        std::vector<std::size_t> freeSlots;
+
+        Poly R; Node* r = R.writableHead();
+        long long curE = LLONG_MAX; u64 curC = 0;  // 正在累加的一项
+        auto flush = [&] { if (curC) { r->next = new Node((long long)curC, int(curE)); r = r->next; } };
+        auto emit = [&](long long e, u64 c) {
+            if (e != curE) { flush(); curE = e; curC = 0; }
+            curC += c;
+        };
+        while (!heap.empty()) {
+            Item it = heap.top(); heap.pop();
+            if (it.slot == npos) {
+                // 刚弹出的块最高次不低于堆里所有的指数，算出来直接往下输出，不再入堆
+                pending(it.i, it.j + 1);
+                const Dense &a = A[it.i], &b = B[it.j];
+                long long lo = a.off + b.off;
+                std::size_t len = a.c.size() + b.c.size() - 1, Lb = std::min<std::size_t>(len, std::size_t(top - lo + 1));
+                if (len == 1) { emit(lo, a.c[0] * b.c[0]); continue; }
+                if (freeSlots.empty()) { freeSlots.push_back(pool.size()); pool.emplace_back(); poolLo.push_back(0); }
+                it.slot = freeSlots.back(); freeSlots.pop_back();
+                std::vector<u64>& c = pool[it.slot];
+                c.assign(Lb, 0ULL);
+                if (Lb < len) polyk::mulLow(a.c.data(), a.c.size(), b.c.data(), b.c.size(), Lb, c.data());
+                else polyk::mulDense(a.c.data(), a.c.size(), b.c.data(), b.c.size(), c.data());
+                poolLo[it.slot] = lo;
+                it.e = lo + (long long)Lb - 1;
+            }
+            // 一直输出到下一个块的指数（含），相同指数的系数在 curC 里累加
+            const std::vector<u64>& c = pool[it.slot];
+            long long lo = poolLo[it.slot], stop = heap.empty() ? LLONG_MIN : heap.top().e, e = it.e;
+            for (; e >= lo && e >= stop; --e) emit(e, c[std::size_t(e - lo)]);
+            if (e >= lo) { it.e = e; heap.push(it); }
+            else freeSlots.push_back(it.slot);
+        }
+        flush();
+        return R;
+    }
+
+    // J.C.P. Miller：Q = P^k，p0 != 0 时 q_0 = p0^k，
+    // n p0 q_n = sum_{i=1..min(n,d)} (k i - n + i) p_i q_{n-i}，只对非零的 p_i 求和
+    static std::vector<polyk::u64> millerPow(const std::vector<polyk::u64>& pc, unsigned k) {
+        const std::size_t d = pc.size() - 1, D = d * k;
+        std::vector<long long> p(pc.size());
+        std::vector<std::size_t> nz;
+        for (std::size_t i = 0; i < pc.size(); ++i) { p[i] = (long long)pc[i]; if (i && p[i]) nz.push_back(i); }
+        std::vector<long long> q(D + 1, 0);
+        q[0] = 1;
+        for (unsigned i = 0; i < k; ++i) q[0] *= p[0];
+        for (std::size_t n = 1; n <= D; ++n) {
+            __int128 s = 0;
+            for (std::size_t i : nz) {
+                if (i > n) break;
+                s += (__int128)((long long)k * (long long)i - (long long)n + (long long)i) * p[i] * q[n - i];
+            }
+            q[n] = (long long)(s / ((__int128)n * p[0]));
+        }
+        std::vector<polyk::u64> r(D + 1);
+        for (std::size_t i = 0; i <= D; ++i) r[i] = (polyk::u64)q[i];
+        return r;
+    }
+
+    // sum_{i=l}^{r-1} p_i Q^(i-l)，r - l = 2^lv
+    static Poly composeRange(const std::vector<polyk::u64>& p, std::size_t l, std::size_t r, int lv, const std::vector<Poly>& qp) {
+        if (lv == 0) { Poly R; R.insertTerm((long long)p[l], 0); return R; }
+        std::size_t m = (l + r) / 2;
+        Poly lo = composeRange(p, l, m, lv - 1, qp), hi = composeRange(p, m, r, lv - 1, qp);
+        if (!hi.front()) return lo;
+        return lo.add(hi.multiply(qp[lv - 1]));
+    }
+
+    void release(){
+        if (!rep) return;
+        if (--rep->refs == 0) {
+            Node* p = rep->head.next; while(p){ auto t=p->next; delete p; p=t; }
+            delete rep;
+        }
+        rep = nullptr;
+    }
+};
+
+#endif  // POLY_HPP
@@ -0,0 +1,96 @@
+/*
+ * poly.hpp 写时复制的测速
+ * - 拷贝：现在只加引用计数；对照组是原来的 copyFrom（逐项 insertTerm，源表降序导致每次走到表尾，O(n^2)）
+ * - 移动：不分配
+ * - 拷贝后修改：第一次 insertTerm 线性复制一份，之后独占
+ * - 按值返回的链式调用（inputPoly / add 的用法）
+ * 分配次数由 include/alloc_count.hpp 统计。
+ *
+ * 编译: g++ -std=c++17 -O2 poly_cow_bench.cpp -o poly_cow_bench
+ * 用法: poly_cow_bench [最大项数，默认 1000000]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "../../include/bench_util.h"
+#include "../../include/alloc_count.hpp"
+#include "poly.hpp"
+
+static Poly make(int n) {
+    std::vector<Term> t(n);
+    for (int i = 0; i < n; ++i) t[i] = {i % 7 + 1, 2 * i};
+    Poly P;
+    P.buildFromTerms(t.data(), n);
+    return P;
+}
+
+// 原来的拷贝方式：逐项 insertTerm 到新多项式
+static Poly legacyCopy(const Poly &src) {
+    Poly R;
+    for (const Node *p = src.firstTerm(); p; p = p->next) R.insertTerm(p->c, p->e);
+    return R;
+}
+
+static bool sameTerms(const Poly &a, const Poly &b) {
+    const Node *p = a.firstTerm(), *q = b.firstTerm();
+    for (; p && q; p = p->next, q = q->next)
+        if (p->c != q->c || p->e != q->e) return false;
+    return !p && !q;
+}
+
+int main(int argc, char **argv) {
+    int maxn = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::printf("%-10s %14s %8s %14s %8s %14s %8s %12s\n", "terms", "legacy copy", "allocs", "copy", "allocs",
+                "copy+insert", "allocs", "move allocs");
+    for (int n = 1000; n <= maxn; n *= 10) {
+        Poly P = make(n);
+        double t, t_legacy = -1, t_copy, t_mut;
+        std::size_t a, a_legacy = 0, a_copy, a_mut, a_move;
+
+        if (n <= 10000) {  // 10^5 项要十几秒
+            a = alloc_count::allocs;
+            t = now_ms();
+            Poly L = legacyCopy(P);
+            t_legacy = now_ms() - t;
+            a_legacy = alloc_count::allocs - a;
+            if (!sameTerms(L, P)) std::printf("legacy copy mismatch\n");
+        }
+
+        a = alloc_count::allocs;
+        t = now_ms();
+        Poly C(P);
+        t_copy = now_ms() - t;
+        a_copy = alloc_count::allocs - a;
+
+        a = alloc_count::allocs;
+        t = now_ms();
+        C.insertTerm(1, 1);  // 奇数指数，插在表尾附近，触发一次线性复制
+        t_mut = now_ms() - t;
+        a_mut = alloc_count::allocs - a;
+        if (C.shares(P) || sameTerms(C, P)) std::printf("copy-on-write broken\n");
+        C.insertTerm(-1, 1);
+        if (!sameTerms(C, P)) std::printf("clone mismatch\n");
+
+        a = alloc_count::allocs;
+        Poly M(std::move(C));
+        Poly M2;
+        M2 = std::move(M);
+        a_move = alloc_count::allocs - a;
+
+        char legacy[32];
+        if (t_legacy < 0) std::snprintf(legacy, sizeof legacy, "%14s", "(skipped)");
+        else std::snprintf(legacy, sizeof legacy, "%11.3f ms", t_legacy);
+        std::printf("%-10d %14s %8zu %11.6f ms %8zu %11.3f ms %8zu %12zu\n", n, legacy, a_legacy, t_copy, a_copy,
+                    t_mut, a_mut, a_move);
+    }
+
+    // 按值返回的链式调用：A = A.add(B) 重复多次，旧 A 的结点在赋值时释放
+    Poly A = make(100000), B = make(1000);
+    std::size_t a = alloc_count::allocs;
+    double t = now_ms();
+    for (int i = 0; i < 100; ++i) A = A.add(B);
+    std::printf("\n100 x (A = A.add(B)), |A| = 1e5: %.1f ms, %.0f allocs per add (one per result term + Rep)\n",
+                now_ms() - t, (double)(alloc_count::allocs - a) / 100);
+    return 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * Poly 的 multiply / mulTrunc / pow / compose 的正确性检查与测速
+ * - 对照组是原来的做法：逐项 insertTerm 的 multiply，P^k 连乘 k-1 次，P(Q) 用 Horner 连乘，
+ *   截断乘积先整个乘出来再删掉高次项
+ * - 正确性：随机的稠密/稀疏多项式（含负指数、稠密块乘稀疏），各运算与对照组逐项比对；
+ *   pow 分别覆盖二进制快速幂和 Miller 递推两条路径
+ *
+ * 编译: g++ -std=c++17 -O2 poly_ops_bench.cpp -o poly_ops_bench
+ */
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../../include/bench_util.h"
+#include "poly.hpp"
+
+// ---- 原来的做法 ----
+static Poly naiveMul(const Poly& A, const Poly& B) {
+    Poly R;
+    for (const Node* p = A.firstTerm(); p; p = p->next)
+        for (const Node* q = B.firstTerm(); q; q = q->next) R.insertTerm(p->c * q->c, p->e + q->e);
+    return R;
+}
+static Poly naivePow(const Poly& P, unsigned k) {
+    Poly R;
+    R.insertTerm(1, 0);
+    for (unsigned i = 0; i < k; ++i) R = naiveMul(R, P);
+    return R;
+}
+static Poly naiveCompose(const Poly& P, const Poly& Q) {
+    // 按指数从高到低 Horner：R = R * Q^(e_prev - e) + c
+    Poly R;
+    int prev = -1;
+    for (const Node* p = P.firstTerm(); p; p = p->next) {
+        if (prev >= 0)
+            for (int i = p->e; i < prev; ++i) R = naiveMul(R, Q);
+        R.insertTerm(p->c, 0);
+        prev = p->e;
+    }
+    for (int i = 0; i < prev; ++i) R = naiveMul(R, Q);
+    return R;
+}
+static Poly dropFrom(const Poly& P, int N) {
+    Poly R;
+    std::vector<Term> t;
+    for (const Node* p = P.firstTerm(); p; p = p->next)
+        if (p->e < N) t.push_back({p->c, p->e});
+    R.buildFromTerms(t.data(), (int)t.size());
+    return R;
+}
+
+static bool same(const Poly& a, const Poly& b) {
+    const Node *p = a.firstTerm(), *q = b.firstTerm();
+    for (; p && q; p = p->next, q = q->next)
+        if (p->c != q->c || p->e != q->e) return false;
+    return !p && !q;
+}
+
+static Poly randomPoly(std::mt19937_64& rng, int terms, int lo, int hi, int cmax) {
+    std::vector<Term> t(terms);
+    for (auto& x : t) x = {(long long)(rng() % (2 * cmax + 1)) - cmax, lo + (int)(rng() % (hi - lo + 1))};
+    Poly P;
+    P.buildFromTerms(t.data(), terms);
+    return P;
+}
+
+static Poly dense(int deg, long long seed) {
+    std::vector<Term> t(deg + 1);
+    for (int i = 0; i <= deg; ++i) t[i] = {(long long)((i * 7 + seed) % 9) - 4, i};
+    Poly P;
+    P.buildFromTerms(t.data(), deg + 1);
+    return P;
+}
+
+static int correctness() {
+    std::mt19937_64 rng(11);
+    int fails = 0;
+    for (int round = 0; round < 300; ++round) {
+        int kind = round % 4;  // 0 稠密，1 稀疏，2 含负指数，3 稠密块乘稀疏（分段乘法）
+        int na = 1 + (int)(rng() % 120), nb = 1 + (int)(rng() % 120);
+        int span = kind == 1 || kind == 3 ? 100000 : 400;
+        int lo = kind == 2 ? -200 : 0;
+        Poly A = randomPoly(rng, na, lo, lo + (kind == 3 ? 150 : span), 1000), B = randomPoly(rng, nb, lo, lo + span, 1000);
+        if (kind == 3 && round % 8 == 3) A = A.add(randomPoly(rng, na, 60000, 60300, 1000));  // 两个稠密块
+        Poly ref = naiveMul(A, B);
+        if (!same(A.multiply(B), ref)) { std::printf("FAIL multiply round %d\n", round); ++fails; }
+        int N = lo + (int)(rng() % (2 * span + 2));
+        if (!same(A.mulTrunc(B, N), dropFrom(ref, N))) { std::printf("FAIL mulTrunc round %d N=%d\n", round, N); ++fails; }
+    }
+    for (int round = 0; round < 40; ++round) {
+        // 小系数：Miller 路径（项少、次数高）与快速幂路径（项多）都会走到
+        int terms = round % 2 ? 3 : 12, deg = round % 2 ? 6 : 12;
+        Poly P = randomPoly(rng, terms, 0, deg, 1);
+        P.insertTerm(1, 0);
+        unsigned k = 1 + (unsigned)(rng() % 12);
+        if (!same(P.pow(k), naivePow(P, k))) { std::printf("FAIL pow round %d k=%u\n", round, k); ++fails; }
+        Poly Q = randomPoly(rng, 4, 0, 5, 2);
+        Poly S = randomPoly(rng, 6, 0, 9, 3);
+        if (!same(S.compose(Q), naiveCompose(S, Q))) { std::printf("FAIL compose round %d\n", round); ++fails; }
+    }
+    Poly X;
+    X.insertTerm(1, 1);
+    X.insertTerm(2, 0);  // x + 2
+    if (!same(X.pow(0), naivePow(X, 0)) || !same(Poly().pow(3), Poly())) { std::printf("FAIL pow edge\n"); ++fails; }
+    // 次数远大于项数：pow / compose 不展开成稠密数组，mulTrunc 不展开截断次数以上的项
+    Poly S;
+    S.insertTerm(1, 400000000);
+    S.insertTerm(1, 0);
+    Poly S2;
+    S2.insertTerm(1, 800000000);
+    S2.insertTerm(2, 400000000);
+    S2.insertTerm(1, 0);
+    if (!same(S.pow(2), S2)) { std::printf("FAIL sparse pow\n"); ++fails; }
+    Poly T = randomPoly(rng, 3, 0, 3, 5);
+    T.insertTerm(1, 1000);
+    if (!same(T.pow(3), naivePow(T, 3))) { std::printf("FAIL sparse pow (Miller skipped)\n"); ++fails; }
+    Poly P300, Q2 = randomPoly(rng, 2, 0, 2, 3);
+    P300.insertTerm(3, 300);
+    P300.insertTerm(-2, 0);
+    if (!same(P300.compose(Q2), naiveCompose(P300, Q2))) { std::printf("FAIL sparse compose\n"); ++fails; }
+    Poly H = dense(20, 1), Xp1;
+    Xp1.insertTerm(1, 1);
+    Xp1.insertTerm(1, 0);
+    Poly Hs = H;
+    Hs.insertTerm(1, 400000000);
+    if (!same(Hs.mulTrunc(Xp1, 10), dropFrom(naiveMul(H, Xp1), 10))) { std::printf("FAIL clipped mulTrunc\n"); ++fails; }
+    std::printf("correctness: %s\n", fails ? "FAILED" : "ok");
+    return fails;
+}
+
+// 取 reps 次中最好的一次；对照组很慢，只跑一次
+template <typename Fn>
+static double timed(Fn fn, Poly& out, int reps = 1) {
+    double best = 1e300;
+    for (int i = 0; i < reps; ++i) {
+        double t = now_ms();
+        out = fn();
+        best = std::min(best, now_ms() - t);
+    }
+    return best;
+}
+
+static void row(const char* name, double tNaive, double tFast, bool ok) {
+    if (tNaive < 0) std::printf("  %-40s %12s %12.2f ms\n", name, "(skipped)", tFast);
+    else std::printf("  %-40s %9.2f ms %9.2f ms %8.1fx%s\n", name, tNaive, tFast, tNaive / tFast, ok ? "" : "  MISMATCH");
+}
+
+int main() {
+    if (correctness()) return 1;
+    std::printf("\n  %-40s %12s %12s %9s\n", "", "naive", "fast", "speedup");
+    Poly r1, r2;
+    std::mt19937_64 rng0(5);
+
+    for (int deg : {100, 300, 1000}) {
+        Poly A = dense(deg, 1), B = dense(deg, 5);
+        double tn = timed([&] { return naiveMul(A, B); }, r1);
+        double tf = timed([&] { return A.multiply(B); }, r2, 3);
+        char name[64];
+        std::snprintf(name, sizeof name, "multiply dense, degree %d", deg);
+        row(name, tn, tf, same(r1, r2));
+    }
+    {
+        Poly A = dense(100000, 1), B = dense(100000, 5);
+        double tf = timed([&] { return A.multiply(B); }, r2, 3);
+        row("multiply dense, degree 100000", -1, tf, true);
+        Poly full;
+        double tFull = timed([&] { return A.multiply(B); }, full, 3);
+        double tTrunc = timed([&] { return A.mulTrunc(B, 50000); }, r2, 3);
+        std::printf("  %-40s %9.2f ms %9.2f ms %8.1fx%s\n", "mulTrunc N=50000 (full multiply + drop)", tFull, tTrunc,
+                    tFull / tTrunc, same(dropFrom(full, 50000), r2) ? "" : "  MISMATCH");
+    }
+    {
+        Poly A = dense(1000, 1), B;  // 稠密乘两项、跨度很大：分段，不展开成 10^8 长的数组
+        B.insertTerm(1, 100000000);
+        B.insertTerm(1, 0);
+        double tn = timed([&] { return naiveMul(A, B); }, r1);
+        double tf = timed([&] { return A.multiply(B); }, r2, 3);
+        row("multiply dense 1000 * (x^1e8 + 1)", tn, tf, same(r1, r2));
+        B = Poly();
+        B.insertTerm(1, 1000000000);
+        B.insertTerm(1, 0);
+        tn = timed([&] { return naiveMul(A, B); }, r1);
+        tf = timed([&] { return A.multiply(B); }, r2, 3);
+        row("multiply dense 1000 * (x^1e9 + 1)", tn, tf, same(r1, r2));
+    }
+    {
+        Poly A = randomPoly(rng0, 200, 0, 100000000, 1000), B = randomPoly(rng0, 200, 0, 100000000, 1000);
+        double tn = timed([&] { return naiveMul(A, B); }, r1);
+        double tf = timed([&] { return A.multiply(B); }, r2, 3);
+        row("multiply sparse 200 * 200 terms", tn, tf, same(r1, r2));
+    }
+    {
+        Poly A = dense(1000, 1), B = dense(1000, 5);
+        double tn = timed([&] { return dropFrom(naiveMul(A, B), 500); }, r1);
+        double tf = timed([&] { return A.mulTrunc(B, 500); }, r2, 3);
+        row("mulTrunc degree 1000, N=500", tn, tf, same(r1, r2));
+    }
+    {
+        Poly P = dense(10, 3);  // 11 项，快速幂
+        double tn = timed([&] { return naivePow(P, 60); }, r1);
+        double tf = timed([&] { return P.pow(60); }, r2, 3);
+        row("pow: 11 terms, k = 60 (binary powering)", tn, tf, same(r1, r2));
+    }
+    {
+        Poly P;  // 1 + 2x + x^7：项少、次数高，系数和 4^k < 2^62，走 Miller
+        P.insertTerm(1, 0);
+        P.insertTerm(2, 1);
+        P.insertTerm(1, 7);
+        double tn = timed([&] { return naivePow(P, 30); }, r1);
+        double tf = timed([&] { return P.pow(30); }, r2, 3);
+        row("pow: 1 + 2x + x^7, k = 30 (Miller)", tn, tf, same(r1, r2));
+    }
+    {
+        Poly P = dense(40, 2), Q = dense(40, 6);
+        double tn = timed([&] { return naiveCompose(P, Q); }, r1);
+        double tf = timed([&] { return P.compose(Q); }, r2, 3);
+        row("compose: degree 40 o degree 40", tn, tf, same(r1, r2));
+    }
+    {
+        Poly P = dense(255, 2), Q = dense(255, 6);
+        double tf = timed([&] { return P.compose(Q); }, r2, 3);
+        row("compose: degree 255 o degree 255", -1, tf, true);
+    }
+    return 0;
+}
@@ -1,142 +1,9 @@
 #include <iostream>
-#include <cmath>
-#include <sstream>
 #include <iomanip>
-#include <climits>
+#include <cstring>
+#include "poly.hpp"
 using namespace std;
 
-// 手写项结构体
-struct Term {
-    long long c;
-    int e;
-};
-
-struct Node {
-    long long c;  // 系数
-    int e;        // 指数
-    Node* next;
-    Node(long long c_, int e_, Node* nx=nullptr): c(c_), e(e_), next(nx) {}
-};
-
-class Poly {
-public:
-    Poly() { head = new Node(0, INT_MAX); }
-    Poly(const Poly& other) { head = new Node(0, INT_MAX); copyFrom(other); }
-    Poly& operator=(const Poly& other){ if(this!=&other){clear(); copyFrom(other);} return *this; }
-    Poly(Poly&& other) noexcept { head = other.head; other.head = new Node(0, INT_MAX); }
-    Poly& operator=(Poly&& other) noexcept {
-        if (this != &other) { destroy(); head = other.head; other.head = new Node(0, INT_MAX); }
-        return *this;
-    }
-    ~Poly(){ destroy(); }
-
-    void insertTerm(long long c, int e) {
-        if (c == 0) return;
-        Node* prev = head; Node* cur = head->next;
-        while (cur && cur->e > e) { prev = cur; cur = cur->next; }
-        if (cur && cur->e == e) {
-            cur->c += c;
-            if (cur->c == 0) { prev->next = cur->next; delete cur; }
-        } else {
-            prev->next = new Node(c, e, cur);
-        }
-    }
-    // 用手写数组构建
-    void buildFromTerms(const Term* terms, int n){
-        for (int i = 0; i < n; ++i) insertTerm(terms[i].c, terms[i].e);
-    }
-
-    Poly add(const Poly& B) const {
-        Poly R; Node *p=head->next, *q=B.head->next, *r=R.head;
-        while (p||q){
-            if (q==nullptr || (p&&p->e>q->e)) { r->next=new Node(p->c,p->e); r=r->next; p=p->next; }
-            else if (p==nullptr || (q&&q->e>p->e)) { r->next=new Node(q->c,q->e); r=r->next; q=q->next; }
-            else { long long c=p->c+q->c; if(c) { r->next=new Node(c,p->e); r=r->next; } p=p->next; q=q->next; }
-        }
-        return R;
-    }
-    Poly sub(const Poly& B) const {
-        Poly R; Node *p=head->next, *q=B.head->next, *r=R.head;
-        while (p||q){
-            if (q==nullptr || (p&&p->e>q->e)) { r->next=new Node(p->c,p->e); r=r->next; p=p->next; }
-            else if (p==nullptr || (q&&q->e>p->e)) { r->next=new Node(-q->c,q->e); r=r->next; q=q->next; }
-            else { long long c=p->c-q->c; if(c){ r->next=new Node(c,p->e); r=r->next; } p=p->next; q=q->next; }
-        }
-        return R;
-    }
-    Poly multiply(const Poly& B) const {
-        Poly R;
-        for (Node* p = head->next; p; p = p->next) {
-            for (Node* q = B.head->next; q; q = q->next) {
-                R.insertTerm(p->c * q->c, p->e + q->e);
-            }
-        }
-        return R;
-    }
-    Poly derivative() const {
-        Poly R;
-        for (Node* p = head->next; p; p = p->next) {
-            if (p->e != 0) {
-                R.insertTerm(p->c * p->e, p->e - 1);
-            }
-        }
-        return R;
-    }
-
-    double eval(double x) const {
-        double s = 0.0;
-        for (Node* p=head->next; p; p=p->next) {
-            s += static_cast<double>(p->c) * std::pow(x, p->e);
-        }
-        return s;
-    }
-
-    string toAlgebra() const {
-        Node* p = head->next;
-        if (!p) return "0";
-        ostringstream ss;
-        bool first = true;
-        while (p){
-            long long c = p->c;
-            int e = p->e;
-            if (c == 0) { p=p->next; continue; }
-            if (first) {
-                if (c < 0) ss << "-";
-            } else {
-                ss << (c >= 0 ? "+" : "-");
-            }
-            long long absc = llabs(c);
-            if (e == 0) {
-                ss << absc;
-            } else if (e == 1) {
-                if (absc != 1) ss << absc;
-                ss << "x";
-            } else {
-                if (absc != 1) ss << absc;
-                ss << "x^" << e;
-            }
-            first = false;
-            p = p->next;
-        }
-        return ss.str();
-    }
-
-    void printPairs(ostream& os=cout) const {
-        Node* p=head->next; if(!p){ os<<"0 0\n"; return; }
-        bool first=true;
-        while(p){ if(!first) os<<' '; os<<p->c<<' '<<p->e; first=false; p=p->next; }
-        os<<'\n';
-    }
-    void printAlgebra(ostream& os=cout) const { os << toAlgebra() << '\n'; }
-
-    void clear(){ Node* p=head->next; while(p){auto t=p->next; delete p; p=t;} head->next=nullptr; }
-
-private:
-    Node* head;
-    void copyFrom(const Poly& other){ head->next=nullptr; Node* p=other.head->next; while(p){ insertTerm(p->c,p->e); p=p->next; } }
-    void destroy(){ clear(); delete head; head=nullptr; }
-};
-
 // ------- 演示 -------
 void printMenu() {
     cout << "请选择操作:\n";
@@ -162,9 +29,76 @@ Poly inputPoly() {
     return P;
 }
 
-int main() {
-    // ios::sync_with_stdio(false);
-    // cin.tie(nullptr);
+// 从文件读多项式：项数 n，随后 n 对系数、指数。读失败返回 false
+bool readPoly(FioReader* in, Poly& P) {
+    int n;
+    if (fio_read_int(in, &n) != 1 || n < 0) return false;
+    Term* terms = new Term[n];
+    bool ok = true;
+    for (int i = 0; i < n && ok; ++i)
+        ok = fio_read_i64(in, &terms[i].c) == 1 && fio_read_int(in, &terms[i].e) == 1;
+    if (ok) P.buildFromTerms(terms, n);
+    delete[] terms;
+    return ok;
+}
+
+// 非交互模式：输入依次是多项式 A、x，然后是若干操作编号（同菜单），
+// 5/6/7 后面紧跟另一个多项式；0 或文件结束时停止。输出与交互模式相同，但不打印提示
+int runFile(const char* path) {
+    FioReader in;
+    if (fio_open(&in, path) != 0) { perror(path); return 1; }
+    FioWriter out;
+    if (fio_writer_init(&out, stdout, 0) != 0) {
+        perror("malloc");
+        fio_close(&in);
+        return 1;
+    }
+    Poly A;
+    double x = 0.0;
+    int choice, rc = 0;
+    if (!readPoly(&in, A) || fio_read_double(&in, &x) != 1) {
+        fprintf(stderr, "%s: 多项式 A 或 x 格式错误\n", path);
+        rc = 1;
+    }
+    while (rc == 0 && fio_read_int(&in, &choice) == 1 && choice != 0) {
+        if (choice == 1) {
+            A.writePairs(&out);
+        } else if (choice == 2) {
+            A.writeAlgebra(&out);
+        } else if (choice == 3) {
+            fio_put_f64(&out, A.eval(x), 6);
+            fio_put_char(&out, '\n');
+        } else if (choice == 4) {
+            Poly dA = A.derivative();
+            dA.writePairs(&out);
+            dA.writeAlgebra(&out);
+        } else if (choice >= 5 && choice <= 7) {
+            Poly B;
+            if (!readPoly(&in, B)) {
+                fprintf(stderr, "%s: 操作 %d 的多项式格式错误\n", path, choice);
+                rc = 1;
+                break;
+            }
+            Poly C = choice == 5 ? A.add(B) : choice == 6 ? A.sub(B) : A.multiply(B);
+            C.writePairs(&out);
+            C.writeAlgebra(&out);
+        } else {
+            fprintf(stderr, "%s: 无效的操作编号 %d\n", path, choice);
+            rc = 1;
+        }
+    }
+    fio_close(&in);
+    if (fio_writer_close(&out) != 0) rc = 1;
+    return rc;
+}
+
+// 用法: polycalculator            交互菜单
+//       polycalculator -f FILE    从文件读（FILE 为 - 时读 stdin）
+int main(int argc, char** argv) {
+    if (argc == 3 && strcmp(argv[1], "-f") == 0) return runFile(argv[2]);
+
+    // 交互模式保留 cin 与 cout 的绑定，提示语在读入前刷出
+    ios::sync_with_stdio(false);
 
     cout << "请输入第一个多项式:\n";
     Poly A = inputPoly();